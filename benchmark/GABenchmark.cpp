@@ -0,0 +1,86 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GABenchmark.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> allocationBytes{0};
+
+    void* countedAlloc(std::size_t size)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+        if(void* ptr = std::malloc(size ? size : 1))
+        {
+            return ptr;
+        }
+
+        throw std::bad_alloc();
+    }
+}
+
+// count every heap allocation made through operator new in the benchmark process
+void* operator new(std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace gameanalytics
+{
+    namespace benchmark
+    {
+        AllocationStats getAllocationStats()
+        {
+            AllocationStats stats;
+            stats.count = allocationCount.load(std::memory_order_relaxed);
+            stats.bytes = allocationBytes.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        void printHeader(const char* title)
+        {
+            std::printf("\n%s\n", title);
+            std::printf("%-40s %14s %14s %12s %12s\n", "benchmark", "ns/op", "ops/s", "allocs/op", "bytes/op");
+        }
+
+        void printResult(Result const& result)
+        {
+            std::printf("%-40s %14.1f %14.0f %12.2f %12.1f\n",
+                result.name.c_str(), result.nsPerOp, result.opsPerSecond, result.allocationsPerOp, result.bytesPerOp);
+        }
+    }
+}
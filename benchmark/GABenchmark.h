@@ -0,0 +1,86 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+namespace gameanalytics
+{
+    namespace benchmark
+    {
+        // totals of every operator new call made by the process (see GABenchmark.cpp)
+        struct AllocationStats
+        {
+            uint64_t count = 0;
+            uint64_t bytes = 0;
+        };
+
+        AllocationStats getAllocationStats();
+
+        struct Result
+        {
+            std::string name;
+            uint64_t    iterations       = 0;
+            double      nsPerOp          = 0.0;
+            double      opsPerSecond     = 0.0;
+            double      allocationsPerOp = 0.0;
+            double      bytesPerOp       = 0.0;
+        };
+
+        void printHeader(const char* title);
+        void printResult(Result const& result);
+
+        // runs task a few times to warm up caches, then measures `iterations` runs
+        template<typename Task>
+        Result run(std::string name, uint64_t iterations, Task&& task)
+        {
+            const uint64_t warmup = iterations / 10 + 1;
+            for(uint64_t i = 0; i < warmup; ++i)
+            {
+                task();
+            }
+
+            const AllocationStats before = getAllocationStats();
+            const auto start = std::chrono::steady_clock::now();
+
+            for(uint64_t i = 0; i < iterations; ++i)
+            {
+                task();
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+            const AllocationStats after = getAllocationStats();
+
+            const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+            Result result;
+            result.name             = std::move(name);
+            result.iterations       = iterations;
+            result.nsPerOp          = ns / iterations;
+            result.opsPerSecond     = ns > 0.0 ? iterations * 1e9 / ns : 0.0;
+            result.allocationsPerOp = static_cast<double>(after.count - before.count) / iterations;
+            result.bytesPerOp       = static_cast<double>(after.bytes - before.bytes) / iterations;
+
+            return result;
+        }
+
+        // keeps the optimizer from dropping a computed value
+        template<typename T>
+        void doNotOptimize(T const& value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(value) : "memory");
+#else
+            static volatile const void* sink;
+            sink = &value;
+#endif
+        }
+    }
+}
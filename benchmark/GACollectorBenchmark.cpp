@@ -0,0 +1,120 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// End to end throughput of event batches through GAHTTPApi (encode, sign, curl) to the
+// local collector stand-in (verify, inflate, parse), over http and https, with and without
+// added server latency. Every accepted event is counted by the collector, so a run also
+// checks that nothing was lost on the way. Allocations include those of the collector.
+//
+
+#include "GABenchmark.h"
+
+#include "GALocalCollector.h"
+
+#if defined(GA_LOCAL_COLLECTOR) && defined(GA_HTTP_CURL)
+
+#include "GAHTTPApi.h"
+#include "GAState.h"
+#include "Http/GAHttpCurl.h"
+
+#include <cstdlib>
+
+using namespace gameanalytics;
+
+namespace
+{
+    constexpr const char* GAME_KEY    = "bd624ee6f8e6efb32a054f8d7ba11618";
+    constexpr const char* GAME_SECRET = "7f5c3f682cbd217841efba92e92ffb1b3b6612bc";
+
+    json makeBatch(int events)
+    {
+        json batch = json::array();
+        for(int i = 0; i < events; ++i)
+        {
+            json ev;
+            ev["v"]               = 2;
+            ev["category"]        = "design";
+            ev["event_id"]        = "Combat:Hit:Weapon" + std::to_string(i % 37);
+            ev["value"]           = i * 0.25;
+            ev["user_id"]         = "b2c8c5e0-0e7d-4c52-8d85-5a1d2d7f1b11";
+            ev["session_id"]      = "0c2b1d6e-3f1a-4c9e-9d2a-6b1f0e8a7c55";
+            ev["client_ts"]       = 1700000000 + i;
+            ev["sdk_version"]     = "cpp 5.4.0";
+            ev["os_version"]      = "linux 6.1.0";
+            ev["platform"]        = "linux";
+            ev["session_num"]     = 12;
+            batch.push_back(std::move(ev));
+        }
+        return batch;
+    }
+
+    bool runCase(const char* name, bool tls, std::chrono::milliseconds latency, json const& batch, uint64_t iterations)
+    {
+        GALocalCollector::Options options;
+        options.gameKey   = GAME_KEY;
+        options.secretKey = GAME_SECRET;
+        options.tls       = tls;
+        options.latency   = latency;
+
+        GALocalCollector collector(options);
+
+        http::GAHTTPApi& api = http::GAHTTPApi::getInstance();
+        api.setCollectorHost(collector.protocol(), collector.host());
+
+        const std::size_t sizeHint = batch.dump().size();
+        uint64_t failed = 0;
+
+        benchmark::Result result = benchmark::run(name, iterations, [&]()
+        {
+            json out;
+            if(api.sendEventsInArray(out, batch, sizeHint) != http::Ok)
+            {
+                ++failed;
+            }
+        });
+        benchmark::printResult(result);
+
+        // run() adds a warm up of iterations / 10 + 1
+        const uint64_t sent     = (iterations + iterations / 10 + 1) * batch.size();
+        const std::size_t received = collector.eventCount();
+
+        std::printf("    %.0f events/s, %zu of %llu events received, %llu failed requests\n",
+            batch.size() * result.opsPerSecond, received, static_cast<unsigned long long>(sent), static_cast<unsigned long long>(failed));
+
+        return failed == 0 && received == sent;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50;
+
+    state::GAState::setKeys(GAME_KEY, GAME_SECRET);
+
+    http::GAHTTPApi::setCustomHttpImpl(std::make_unique<GAHttpClientCurl>());
+    http::GAHTTPApi::getInstance().initializeClient();
+
+    const json batch = makeBatch(500);
+
+    benchmark::printHeader("Batches of 500 events to the local collector");
+
+    bool ok = true;
+    ok &= runCase("http",                   false, std::chrono::milliseconds(0),  batch, iterations);
+    ok &= runCase("https",                  true,  std::chrono::milliseconds(0),  batch, iterations);
+    ok &= runCase("https, 20 ms latency",   true,  std::chrono::milliseconds(20), batch, iterations);
+
+    return ok ? 0 : 1;
+}
+
+#else
+
+#include <cstdio>
+
+int main()
+{
+    std::printf("GACollectorBenchmark needs the curl http client (GA_HTTP_USE_CURL) on a POSIX platform\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,216 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// Gzip levels 0 - 9 on a mixed events batch as the SDK sends it (all categories, custom
+// fields, annotations), with the time the upload would take on a few link speeds and the
+// level GACompressionPolicy picks in adaptive mode for each of them.
+//
+
+#include "GABenchmark.h"
+
+#include "GACommon.h"
+#include "GACompressionPolicy.h"
+#include "GAJsonWriter.h"
+#include "GAPayloadEncoder.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace gameanalytics;
+
+namespace
+{
+    constexpr const char* SECRET_KEY = "16813a12f718bc5c620f56944e1abc3ea13ccbac";
+
+    // event uuids are random and barely compress, generated like GAUtilities::generateUUID
+    std::string makeUuid(std::mt19937& random)
+    {
+        static const char hex[] = "0123456789abcdef";
+        std::string uuid = "xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx";
+        for(char& c : uuid)
+        {
+            if(c == 'x' || c == 'y')
+            {
+                const unsigned value = random() % 16;
+                c = hex[c == 'x' ? value : (value & 0x3) | 0x8];
+            }
+        }
+        return uuid;
+    }
+
+    json makeEvent(int i, std::mt19937& random)
+    {
+        json ev;
+        ev["v"]               = 2;
+        ev["event_uuid"]      = makeUuid(random);
+        ev["user_id"]         = "b2c8c5e0-0e7d-4c52-8d85-5a1d2d7f1b11";
+        ev["session_id"]      = "0c2b1d6e-3f1a-4c9e-9d2a-6b1f0e8a7c55";
+        ev["client_ts"]       = 1700000000 + i / 3;
+        ev["sdk_version"]     = "cpp 5.4.0";
+        ev["os_version"]      = "linux 6.1.0";
+        ev["manufacturer"]    = "unknown";
+        ev["device"]          = "unknown";
+        ev["platform"]        = "linux";
+        ev["build"]           = "1.8.2";
+        ev["engine_version"]  = "unreal 5.3.2";
+        ev["connection_type"] = "lan";
+        ev["session_num"]     = 12;
+        ev["custom_01"]       = "ninja";
+
+        switch(i % 10)
+        {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+                ev["category"] = "design";
+                ev["event_id"] = "Combat:Hit:Weapon" + std::to_string(i % 37);
+                ev["value"]    = (i % 113) * 0.25;
+                break;
+
+            case 4:
+            case 5:
+                ev["category"] = "progression";
+                ev["event_id"] = "Complete:World0" + std::to_string(i % 4) + ":Level" + std::to_string(i % 50);
+                ev["score"]    = i * 13 % 10000;
+                ev["attempt_num"] = i % 5 + 1;
+                break;
+
+            case 6:
+            case 7:
+                ev["category"] = "resource";
+                ev["event_id"] = std::string(i % 2 ? "Sink" : "Source") + ":Gems:Weapons:Sword" + std::to_string(i % 7);
+                ev["amount"]   = (i % 2 ? -1 : 1) * (i % 250);
+                break;
+
+            case 8:
+                ev["category"]        = "business";
+                ev["event_id"]        = "Weapon:SwordOfFire" + std::to_string(i % 3);
+                ev["amount"]          = 99;
+                ev["currency"]        = "USD";
+                ev["transaction_num"] = i / 10;
+                ev["cart_type"]       = "Menu";
+                ev["custom_fields"]   = {{"offer", "summer_sale"}, {"bundle_size", i % 4}};
+                break;
+
+            default:
+                ev["category"] = "error";
+                ev["severity"] = "warning";
+                ev["message"]  = "Texture streaming pool over budget by " + std::to_string(i % 97) + " MB\n  at Renderer::Stream (renderer.cpp:" + std::to_string(200 + i % 300) + ")";
+                break;
+        }
+
+        return ev;
+    }
+
+    json makeCorpus(std::size_t targetBytes)
+    {
+        json batch = json::array();
+        std::size_t size = 0;
+        std::mt19937 random(42);
+
+        for(int i = 0; size < targetBytes; ++i)
+        {
+            json ev = makeEvent(i, random);
+            size += ev.dump().size() + 1;
+            batch.push_back(std::move(ev));
+        }
+
+        return batch;
+    }
+
+    std::size_t encode(json const& batch, int level)
+    {
+        utilities::GAPayloadEncoder encoder(level > 0, SECRET_KEY, level);
+        utilities::GAJsonWriter writer;
+
+        writer.beginArray();
+        for(json const& ev : batch)
+        {
+            writer.value(ev);
+            if(writer.size() >= 16 * 1024)
+            {
+                encoder.write(writer);
+            }
+        }
+        writer.endArray();
+        encoder.write(writer);
+        encoder.finish();
+
+        benchmark::doNotOptimize(encoder.authorization());
+        return encoder.payload().size();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20;
+
+    // a full batch of the events queue is a few hundred KB
+    const json corpus = makeCorpus(256 * 1024);
+    const std::size_t jsonSize = corpus.dump().size();
+
+    struct LevelResult
+    {
+        int         level;
+        double      nsPerOp;
+        std::size_t size;
+    };
+
+    std::vector<LevelResult> results;
+
+    benchmark::printHeader("Gzip level on a 256 KB mixed events batch (encode + HMAC)");
+
+    for(int level = 0; level <= 9; ++level)
+    {
+        std::size_t size = 0;
+        benchmark::Result result = benchmark::run("level " + std::to_string(level), iterations, [&]()
+        {
+            size = encode(corpus, level);
+        });
+        benchmark::printResult(result);
+
+        results.push_back({level, result.nsPerOp, size});
+    }
+
+    std::printf("\n%zu events, %zu bytes of json\n\n", corpus.size(), jsonSize);
+    std::printf("%-6s %10s %8s %10s %12s %12s %12s\n", "level", "bytes", "ratio", "MB/s", "64 KB/s", "1 MB/s", "12.5 MB/s");
+
+    const double links[] = { 64.0 * 1024, 1024.0 * 1024, 12.5 * 1024 * 1024 };
+    for(LevelResult const& r : results)
+    {
+        const double seconds = r.nsPerOp / 1e9;
+        std::printf("%-6d %10zu %8.3f %10.1f", r.level, r.size, static_cast<double>(r.size) / jsonSize, jsonSize / seconds / (1024 * 1024));
+
+        // encode + upload time in ms
+        for(double bytesPerSecond : links)
+        {
+            std::printf(" %12.1f", (seconds + r.size / bytesPerSecond) * 1000.0);
+        }
+        std::printf("\n");
+    }
+
+    // feed the measured numbers to an adaptive policy the way GAHTTPApi does
+    std::printf("\nadaptive pick:");
+    for(double bytesPerSecond : links)
+    {
+        http::GACompressionPolicy policy;
+        policy.setLevel(http::GACompressionPolicy::ADAPTIVE);
+
+        for(LevelResult const& r : results)
+        {
+            if(r.level > 0)
+            {
+                policy.recordCompression(r.level, jsonSize, r.size, std::chrono::nanoseconds(static_cast<int64_t>(r.nsPerOp)));
+            }
+        }
+        policy.recordUpload(jsonSize, std::chrono::duration<double>(jsonSize / bytesPerSecond));
+
+        std::printf(" %12d", policy.chooseLevel(jsonSize));
+    }
+    std::printf("\n");
+
+    return 0;
+}
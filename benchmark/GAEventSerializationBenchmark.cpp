@@ -0,0 +1,124 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// Compares building a design event with the json DOM (annotations + event + merge_patch + dump)
+// against the typed records serialized with GAJsonWriter, with and without the event arena.
+//
+
+#include "GABenchmark.h"
+
+#include "GAEventRecords.h"
+#include "GAJsonWriter.h"
+#include "GAArena.h"
+
+#include <cstdlib>
+
+using namespace gameanalytics;
+
+namespace
+{
+    events::EventAnnotations makeAnnotations()
+    {
+        events::EventAnnotations annotations;
+        annotations.eventUuid             = "8f14e45f-ceea-467f-a0e6-7bb1a4e6c8d2";
+        annotations.userId                = "b2c8c5e0-0e7d-4c52-8d85-5a1d2d7f1b11";
+        annotations.sdkVersion            = "cpp 5.4.0";
+        annotations.osVersion             = "linux 6.1.0";
+        annotations.manufacturer          = "unknown";
+        annotations.device                = "unknown";
+        annotations.platform              = "linux";
+        annotations.sessionId             = "0c2b1d6e-3f1a-4c9e-9d2a-6b1f0e8a7c55";
+        annotations.connectionType        = "lan";
+        annotations.build                 = "1.0.0";
+        annotations.engineVersion         = "unreal 5.3.2";
+        annotations.clientTs              = 1700000000;
+        annotations.sessionNum            = 12;
+        annotations.currentSessionLength  = 345;
+        annotations.lifetimeSessionLength = 98765;
+        return annotations;
+    }
+
+    const json customFields = {{"weapon", "sword"}, {"level", 12}};
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    const events::EventAnnotations state = makeAnnotations();
+
+    benchmark::printHeader("Design event serialization");
+
+    // what GAEvents::addDesignEvent + addEventToStore did before typed records
+    benchmark::Result legacy = benchmark::run("json DOM + merge_patch + dump", iterations, [&]()
+    {
+        json eventData;
+        eventData["category"] = "design";
+        eventData["event_id"] = "Combat:Hit:Sword";
+        eventData["value"]    = 42.5;
+        eventData["custom_fields"] = customFields;
+        eventData["custom_01"] = "ninja";
+
+        json ev;
+        state.toJson(ev);
+        ev.merge_patch(eventData);
+
+        const std::string out = ev.dump();
+        benchmark::doNotOptimize(out);
+    });
+    benchmark::printResult(legacy);
+
+    utilities::GAJsonWriter writer;
+    benchmark::Result typed = benchmark::run("typed record + GAJsonWriter", iterations, [&]()
+    {
+        events::DesignEventRecord record;
+        record.id            = "Combat:Hit:Sword";
+        record.hasValue      = true;
+        record.value         = 42.5;
+        record.customFields  = customFields;
+        record.dimensions[0] = "ninja";
+
+        events::EventAnnotations annotations = state;
+
+        writer.reset();
+        writer.beginObject();
+        annotations.write(writer);
+        record.write(writer);
+        writer.endObject();
+
+        benchmark::doNotOptimize(writer.str());
+    });
+    benchmark::printResult(typed);
+
+    // what GAEvents does on the GA thread: the record lives in an arena scope
+    benchmark::Result arena = benchmark::run("typed record + GAJsonWriter + arena", iterations, [&]()
+    {
+        utilities::GAArena::Scope arenaScope;
+
+        events::DesignEventRecord record;
+        record.id            = "Combat:Hit:Sword";
+        record.hasValue      = true;
+        record.value         = 42.5;
+        record.customFields  = customFields;
+        record.dimensions[0] = "ninja";
+
+        events::EventAnnotations annotations = state;
+
+        writer.reset();
+        writer.beginObject();
+        annotations.write(writer);
+        record.write(writer);
+        writer.endObject();
+
+        benchmark::doNotOptimize(writer.str());
+    });
+    benchmark::printResult(arena);
+
+    std::printf("\nspeedup: %.2fx, allocations: %.1f -> %.1f per event\n",
+        legacy.nsPerOp / typed.nsPerOp, legacy.allocationsPerOp, typed.allocationsPerOp);
+    std::printf("arena: %.2fx vs typed, allocations: %.1f -> %.1f per event\n",
+        typed.nsPerOp / arena.nsPerOp, typed.allocationsPerOp, arena.allocationsPerOp);
+
+    return 0;
+}
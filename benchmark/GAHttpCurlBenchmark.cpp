@@ -0,0 +1,198 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// Request latency of GAHttpClientCurl against the local collector stand-in over https,
+// comparing a fresh easy handle per request (the old behaviour, new TCP + TLS handshake
+// every time) with the pooled handles sharing connections and TLS sessions, send() with
+// a reused response buffer, the throughput of batches sent concurrently through sendRequestAsync,
+// and the latency of the first request of a new client with and without a connection warm-up.
+//
+
+#include "GABenchmark.h"
+
+#include "GALocalCollector.h"
+
+#if defined(GA_LOCAL_COLLECTOR) && defined(GA_HTTP_CURL)
+
+#include "Http/GAHttpCurl.h"
+#include "GAPayloadEncoder.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace gameanalytics;
+
+namespace
+{
+    constexpr const char* GAME_KEY    = "bd624ee6f8e6efb32a054f8d7ba11618";
+    constexpr const char* GAME_SECRET = "7f5c3f682cbd217841efba92e92ffb1b3b6612bc";
+
+    // what GAHttpClientCurl::sendRequest did before the pool: new handle, new connection
+    long sendWithoutReuse(std::string const& url, std::string const& auth, std::vector<uint8_t> const& payload)
+    {
+        CURL* curl = curl_easy_init();
+
+        curl_slist* header = nullptr;
+        header = curl_slist_append(header, auth.c_str());
+        header = curl_slist_append(header, "Content-Type: application/json");
+
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload.data());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, payload.size());
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char*, size_t size, size_t nmemb, void*) { return size * nmemb; });
+
+        long code = -1;
+        if(curl_easy_perform(curl) == CURLE_OK)
+        {
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+        }
+
+        curl_slist_free_all(header);
+        curl_easy_cleanup(curl);
+        return code;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+
+    // the collector writes to connections curl may already have closed
+    std::signal(SIGPIPE, SIG_IGN);
+
+    GALocalCollector::Options collectorOptions;
+    collectorOptions.gameKey   = GAME_KEY;
+    collectorOptions.secretKey = GAME_SECRET;
+    collectorOptions.tls       = true;
+    GALocalCollector collector(collectorOptions);
+
+    const std::string url = collector.eventsUrl();
+
+    const std::string body = R"([{"category":"design","event_id":"Combat:Hit:Sword","value":42.5}])";
+
+    // signed like the sdk does, so the collector accepts every request
+    utilities::GAPayloadEncoder encoder(false, GAME_SECRET);
+    encoder.write(body);
+    encoder.finish();
+
+    const std::string signature(encoder.signature());
+    const std::string auth = "Authorization: " + signature;
+    const std::vector<uint8_t> payload(body.begin(), body.end());
+
+    GAHttpClientCurl pooled;
+    GAHttpClient& client = pooled;
+    client.initialize();
+
+    benchmark::printHeader("HTTPS POST to the local collector");
+
+    benchmark::Result fresh = benchmark::run("new handle per request", iterations, [&]()
+    {
+        const long code = sendWithoutReuse(url, auth, payload);
+        benchmark::doNotOptimize(code);
+    });
+    benchmark::printResult(fresh);
+
+    benchmark::Result reused = benchmark::run("GAHttpClientCurl (pooled, shared)", iterations, [&]()
+    {
+        GAHttpClient::Response response = client.sendRequest(url, auth, payload, false, nullptr);
+        benchmark::doNotOptimize(response.code);
+    });
+    benchmark::printResult(reused);
+
+    const GAHttpClient::Header headers[] = { {"Authorization", signature}, {"Content-Type", "application/json"} };
+    GAHttpClient::Request request;
+    request.url     = url;
+    request.headers = {headers, 2};
+    request.payload = payload;
+
+    GAHttpClient::Response reusedResponse;
+    benchmark::Result structured = benchmark::run("send, reused response buffer", iterations, [&]()
+    {
+        client.send(request, reusedResponse);
+        benchmark::doNotOptimize(reusedResponse.code);
+    });
+    benchmark::printResult(structured);
+
+    // one op = a batch of requests in flight at the same time on the curl multi thread
+    constexpr int BATCH = 8;
+    benchmark::Result async = benchmark::run("sendRequestAsync, 8 concurrent", iterations / BATCH + 1, [&]()
+    {
+        std::vector<std::future<GAHttpClient::Response>> futures;
+        for(int i = 0; i < BATCH; ++i)
+        {
+            futures.push_back(client.sendRequestFuture(url, auth, payload, false, nullptr));
+        }
+
+        for(auto& future : futures)
+        {
+            benchmark::doNotOptimize(future.get().code);
+        }
+    });
+    benchmark::printResult(async);
+
+    std::printf("\nlatency: %.1f us -> %.1f us per request (%.2fx)\n",
+        fresh.nsPerOp / 1000.0, reused.nsPerOp / 1000.0, fresh.nsPerOp / reused.nsPerOp);
+    std::printf("async: %.1f us per request in batches of %d\n", async.nsPerOp / 1000.0 / BATCH, BATCH);
+
+    client.cleanup();
+
+    // first request of a fresh client, only the request itself is timed
+    collector.clear();
+    const std::string rootUrl = collector.protocol() + "://" + collector.host() + "/";
+
+    auto firstRequest = [&](bool warm)
+    {
+        const uint64_t runs = iterations / 10 + 1;
+        double totalNs = 0.0;
+
+        for(uint64_t i = 0; i < runs; ++i)
+        {
+            GAHttpClientCurl fresh;
+            fresh.initialize();
+
+            if(warm)
+            {
+                const std::size_t before = collector.requests().size();
+                fresh.warmUp(rootUrl, std::chrono::seconds(60));
+                while(collector.requests().size() == before)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            GAHttpClient::Response response = fresh.sendRequest(url, auth, payload, false, nullptr);
+            totalNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            benchmark::doNotOptimize(response.code);
+
+            fresh.cleanup();
+        }
+
+        return totalNs / runs;
+    };
+
+    const double coldNs   = firstRequest(false);
+    const double warmedNs = firstRequest(true);
+
+    std::printf("first request: %.1f us cold, %.1f us after warm-up\n", coldNs / 1000.0, warmedNs / 1000.0);
+
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::printf("GAHttpCurlBenchmark needs the curl http client (GA_HTTP_USE_CURL) on a POSIX platform\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,150 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// Cost of a log call on the calling thread: the old inline path (tag concatenation, printString,
+// file write) against GALogger queuing into its ring buffer, with the drain thread writing the
+// same file through a custom handler. Calls are timed in bursts that fit the queue, the drain
+// runs untimed between bursts. Allocations are counted only while a burst runs.
+//
+
+#include "GABenchmark.h"
+
+#include "GACommon.h"
+#include "GALogger.h"
+#include "GAUtilities.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+
+using namespace gameanalytics;
+
+namespace
+{
+    constexpr std::size_t BURST = logging::GALogger::QUEUE_CAPACITY / 2;
+
+    const std::string LOG_PATH = (std::filesystem::temp_directory_path() / "ga_logger_benchmark.txt").string();
+
+    // the sendMessage path before the ring buffer, kept here for comparison
+    template<typename ...args_t>
+    void legacyLog(std::fstream& file, EGALoggerMessageType logType, std::string const& fmt, args_t&&... args)
+    {
+        std::string tag = "GameAnalytics";
+        tag += " :";
+
+        switch (logType)
+        {
+            case LogError:
+                tag = "Error/" + tag;
+                break;
+
+            case LogWarning:
+                tag = "Warning/" + tag;
+                break;
+
+            default:
+                tag = "Verbose/" + tag;
+        }
+
+        const std::string msg = tag + ' ' + utilities::printString(fmt, std::forward<args_t>(args)...);
+        file << msg << '\n';
+    }
+
+    // times `bursts` runs of `burst`, calling between() untimed after each
+    template<typename Burst, typename Between>
+    benchmark::Result measureBursts(std::string name, uint64_t bursts, Burst&& burst, Between&& between)
+    {
+        burst();
+        between();
+
+        uint64_t ns = 0;
+        benchmark::AllocationStats allocations;
+
+        for(uint64_t i = 0; i < bursts; ++i)
+        {
+            const benchmark::AllocationStats before = benchmark::getAllocationStats();
+            const auto start = std::chrono::steady_clock::now();
+
+            burst();
+
+            const auto end = std::chrono::steady_clock::now();
+            const benchmark::AllocationStats after = benchmark::getAllocationStats();
+
+            ns                += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            allocations.count += after.count - before.count;
+            allocations.bytes += after.bytes - before.bytes;
+
+            between();
+        }
+
+        const double calls = static_cast<double>(bursts * BURST);
+
+        benchmark::Result result;
+        result.name             = std::move(name);
+        result.iterations       = bursts * BURST;
+        result.nsPerOp          = ns / calls;
+        result.opsPerSecond     = ns > 0 ? calls * 1e9 / ns : 0.0;
+        result.allocationsPerOp = allocations.count / calls;
+        result.bytesPerOp       = allocations.bytes / calls;
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t bursts = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+
+    benchmark::printHeader("Log call cost on the calling thread");
+
+    std::fstream legacyFile(LOG_PATH, std::ios::out | std::ios::trunc);
+    benchmark::Result legacy = measureBursts("inline format + file write", bursts, [&]()
+    {
+        for(std::size_t i = 0; i < BURST; ++i)
+        {
+            legacyLog(legacyFile, LogWarning, "Event queue: %d events, batch %s sent in %.2f ms", static_cast<int>(i), "design", 1.25);
+        }
+    }, [&]()
+    {
+        legacyFile.flush();
+    });
+    benchmark::printResult(legacy);
+    legacyFile.close();
+
+    std::fstream asyncFile(LOG_PATH, std::ios::out | std::ios::trunc);
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};
+
+    logging::GALogger::setCustomLogHandler([&](std::string const& message, EGALoggerMessageType)
+    {
+        if(message.find("log messages were dropped") != std::string::npos)
+        {
+            ++dropped;
+        }
+        asyncFile << message << '\n';
+        ++written;
+    });
+
+    benchmark::Result async = measureBursts("GALogger ring buffer", bursts, [&]()
+    {
+        for(std::size_t i = 0; i < BURST; ++i)
+        {
+            logging::GALogger::w("Event queue: %d events, batch %s sent in %.2f ms", static_cast<int>(i), "design", 1.25);
+        }
+    }, [&]()
+    {
+        logging::GALogger::flush();
+        asyncFile.flush();
+    });
+    benchmark::printResult(async);
+
+    logging::GALogger::setCustomLogHandler({});
+    asyncFile.close();
+    std::remove(LOG_PATH.c_str());
+
+    std::printf("\n%llu messages written by the drain thread, %llu overflow reports\n",
+        static_cast<unsigned long long>(written.load()), static_cast<unsigned long long>(dropped.load()));
+    std::printf("caller side speedup: %.2fx\n", legacy.nsPerOp / async.nsPerOp);
+
+    return dropped == 0 ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// Encoding a ~1 MB events batch for the collector: the old multi pass path (dump, gzip through
+// a static buffer, byte copies, separate HMAC pass) against GAPayloadEncoder fed by GAJsonWriter.
+//
+
+#include "GABenchmark.h"
+
+#include "GACommon.h"
+#include "GAJsonWriter.h"
+#include "GAPayloadEncoder.h"
+#include "GAUtilities.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#define MINIZ_HEADER_FILE_ONLY
+#include "GA_Zip.cpp"
+
+using namespace gameanalytics;
+
+namespace
+{
+    using namespace utilities::zip;
+
+    constexpr const char* SECRET_KEY = "16813a12f718bc5c620f56944e1abc3ea13ccbac";
+
+    json makeBatch(std::size_t targetBytes)
+    {
+        json batch = json::array();
+        std::size_t size = 0;
+
+        for(int i = 0; size < targetBytes; ++i)
+        {
+            json ev;
+            ev["v"]               = 2;
+            ev["category"]        = "design";
+            ev["event_id"]        = "Combat:Hit:Weapon" + std::to_string(i % 37);
+            ev["value"]           = i * 0.25;
+            ev["event_uuid"]      = "8f14e45f-ceea-467f-a0e6-" + std::to_string(100000000000 + i);
+            ev["user_id"]         = "b2c8c5e0-0e7d-4c52-8d85-5a1d2d7f1b11";
+            ev["session_id"]      = "0c2b1d6e-3f1a-4c9e-9d2a-6b1f0e8a7c55";
+            ev["client_ts"]       = 1700000000 + i;
+            ev["sdk_version"]     = "cpp 5.4.0";
+            ev["os_version"]      = "linux 6.1.0";
+            ev["platform"]        = "linux";
+            ev["connection_type"] = "lan";
+            ev["session_num"]     = 12;
+
+            size += ev.dump().size() + 1;
+            batch.push_back(std::move(ev));
+        }
+
+        return batch;
+    }
+
+    // the gzip path before GAPayloadEncoder, kept here for comparison
+    std::vector<uint8_t> legacyGzip(const char* str)
+    {
+        z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        deflateInit2(&zs, Z_BEST_COMPRESSION, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS, 9, MZ_DEFAULT_STRATEGY);
+
+        zs.next_in  = (const unsigned char*)str;
+        zs.avail_in = static_cast<unsigned int>(strlen(str));
+
+        static char outbuffer[32768];
+        std::vector<char> deflated;
+        int ret;
+        do
+        {
+            zs.next_out  = reinterpret_cast<unsigned char*>(outbuffer);
+            zs.avail_out = sizeof(outbuffer);
+            ret = deflate(&zs, Z_FINISH);
+
+            const size_t produced = zs.total_out - deflated.size();
+            for(size_t i = 0; i < produced; ++i)
+            {
+                deflated.push_back(outbuffer[i]);
+            }
+        } while(ret == Z_OK);
+        deflateEnd(&zs);
+
+        const char header[10] = { '\037', '\213', Z_DEFLATED, 0, 0, 0, 0, 0, 0, 0x03 };
+        uint32_t crc  = static_cast<uint32_t>(mz_crc32(0, (const unsigned char*)str, strlen(str)));
+        uint32_t size = static_cast<uint32_t>(strlen(str));
+
+        const size_t totalSize = sizeof(header) + deflated.size() + 8;
+        std::unique_ptr<char[]> result = std::make_unique<char[]>(totalSize);
+        std::memcpy(result.get(), header, sizeof(header));
+        for(size_t i = 0; i < deflated.size(); ++i)
+        {
+            result[sizeof(header) + i] = deflated[i];
+        }
+        std::memcpy(result.get() + sizeof(header) + deflated.size(), &crc, 4);
+        std::memcpy(result.get() + sizeof(header) + deflated.size() + 4, &size, 4);
+
+        std::vector<uint8_t> out;
+        for(size_t i = 0; i < totalSize; ++i)
+        {
+            out.push_back(result[i]);
+        }
+
+        return out;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20;
+
+    const json batch = makeBatch(1024 * 1024);
+
+    benchmark::printHeader("Encoding a 1 MB events batch (gzip + HMAC)");
+
+    std::size_t legacySize = 0;
+    benchmark::Result legacy = benchmark::run("dump + gzip + copies + hmac", iterations, [&]()
+    {
+        const std::string jsonString = batch.dump();
+        std::vector<uint8_t> payload = legacyGzip(jsonString.c_str());
+
+        std::vector<uint8_t> mac;
+        utilities::GAUtilities::hmacWithKey(SECRET_KEY, payload, mac);
+        const std::string auth = "Authorization: " + std::string(reinterpret_cast<char*>(mac.data()));
+
+        legacySize = payload.size();
+        benchmark::doNotOptimize(auth);
+    });
+    benchmark::printResult(legacy);
+
+    std::size_t streamedSize = 0;
+    benchmark::Result streamed = benchmark::run("GAJsonWriter -> GAPayloadEncoder", iterations, [&]()
+    {
+        utilities::GAPayloadEncoder encoder(true, SECRET_KEY);
+        utilities::GAJsonWriter writer;
+
+        writer.beginArray();
+        for(json const& ev : batch)
+        {
+            writer.value(ev);
+            if(writer.size() >= 16 * 1024)
+            {
+                encoder.write(writer);
+            }
+        }
+        writer.endArray();
+        encoder.write(writer);
+        encoder.finish();
+
+        streamedSize = encoder.payload().size();
+        benchmark::doNotOptimize(encoder.authorization());
+    });
+    benchmark::printResult(streamed);
+
+    std::printf("\n%zu events, %zu -> %zu bytes\n", batch.size(), batch.dump().size(), streamedSize);
+    std::printf("speedup: %.2fx, allocations: %.1f -> %.1f, allocated bytes: %.0f -> %.0f per batch\n",
+        legacy.nsPerOp / streamed.nsPerOp, legacy.allocationsPerOp, streamed.allocationsPerOp, legacy.bytesPerOp, streamed.bytesPerOp);
+
+    return legacySize == streamedSize ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// Remote config reads from several threads while the configs are republished every 10 ms, like
+// game threads polling feature flags while the GA thread applies a new init response. The old
+// lookup (recursive mutex, linear scan copying every key) is compared with the published
+// GARemoteConfigsIndex and with typed RemoteConfig handles, which hold the value already parsed.
+// Results are per lookup; ops/s is the total over all reader threads.
+//
+
+#include "GABenchmark.h"
+
+#include "GACommon.h"
+#include "GARemoteConfigsIndex.h"
+#include "GARemoteConfigsRegistry.h"
+#include "GAUtilities.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace gameanalytics;
+
+namespace
+{
+    constexpr int CONFIG_COUNT = 50;
+
+    const char* const KEYS[] = {"flag_0", "flag_24", "flag_49", "missing_flag"};
+
+    json makeConfigs(int revision)
+    {
+        json configs = json::array();
+        for(int i = 0; i < CONFIG_COUNT; ++i)
+        {
+            configs.push_back({{"key", "flag_" + std::to_string(i)}, {"value", std::to_string(revision + i)}});
+        }
+        return configs;
+    }
+
+    // GAState::getRemoteConfigsValue before the index, kept here for comparison
+    struct LegacyRemoteConfigs
+    {
+        std::recursive_mutex mutex;
+        json                 configs = makeConfigs(0);
+
+        std::string get(std::string const& key, std::string const& defaultValue)
+        {
+            std::lock_guard<std::recursive_mutex> lg(mutex);
+
+            for(auto& config : configs)
+            {
+                std::string configKey = utilities::getOptionalValue<std::string>(config, "key", "");
+                if(configKey == key)
+                {
+                    return utilities::getOptionalValue<std::string>(config, "value", defaultValue);
+                }
+            }
+            return defaultValue;
+        }
+
+        void publish(json newConfigs)
+        {
+            std::lock_guard<std::recursive_mutex> lg(mutex);
+            configs = std::move(newConfigs);
+        }
+    };
+
+    std::string lookup(state::GARemoteConfigsPublisher const& publisher, std::string_view key, std::string const& defaultValue)
+    {
+        json const* value = publisher.current().find(key);
+        if(!value || !value->is_string())
+        {
+            return defaultValue;
+        }
+        return value->get<std::string>();
+    }
+
+    void publishIndex(state::GARemoteConfigsPublisher& publisher, state::GARemoteConfigsRegistry& registry, json configs)
+    {
+        auto index = std::make_shared<const state::GARemoteConfigsIndex>(std::move(configs));
+        const StringVector changedKeys = state::GARemoteConfigsIndex::changedKeys(*publisher.load(), *index);
+
+        publisher.publish(index);
+        registry.update(*index, changedKeys);
+    }
+
+    // runs `threads` readers doing `lookups` each while `publish` is called every 10 ms
+    template<typename Read, typename Publish>
+    benchmark::Result measure(std::string name, int threads, uint64_t lookups, Read&& read, Publish&& publish)
+    {
+        std::atomic<bool> done{false};
+        std::thread writer([&]()
+        {
+            int revision = 1;
+            while(!done)
+            {
+                publish(makeConfigs(revision++));
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        });
+
+        const benchmark::AllocationStats before = benchmark::getAllocationStats();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> readers;
+        for(int t = 0; t < threads; ++t)
+        {
+            readers.emplace_back([&]()
+            {
+                for(uint64_t i = 0; i < lookups; ++i)
+                {
+                    benchmark::doNotOptimize(read(i % 4));
+                }
+            });
+        }
+        for(std::thread& reader : readers)
+        {
+            reader.join();
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const benchmark::AllocationStats after = benchmark::getAllocationStats();
+
+        done = true;
+        writer.join();
+
+        const double total = static_cast<double>(lookups) * threads;
+        const double ns    = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+        benchmark::Result result;
+        result.name             = std::move(name) + ", " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        result.iterations       = static_cast<uint64_t>(total);
+        result.nsPerOp          = ns / total;
+        result.opsPerSecond     = ns > 0.0 ? total * 1e9 / ns : 0.0;
+
+        // includes the writer's allocations, a few per publish
+        result.allocationsPerOp = static_cast<double>(after.count - before.count) / total;
+        result.bytesPerOp       = static_cast<double>(after.bytes - before.bytes) / total;
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t lookups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    benchmark::printHeader("Remote config lookups while configs are republished");
+
+    LegacyRemoteConfigs legacy;
+    state::GARemoteConfigsPublisher publisher;
+    state::GARemoteConfigsRegistry registry;
+    publishIndex(publisher, registry, makeConfigs(0));
+
+    std::vector<RemoteConfig<int64_t>> handles;
+    for(const char* key : KEYS)
+    {
+        handles.push_back(registry.bind<int64_t>(key, 0, publisher));
+    }
+
+    for(int threads : {1, 2, 4, 8})
+    {
+        const benchmark::Result locked = measure("mutex + linear scan", threads, lookups, [&](uint64_t key)
+        {
+            return legacy.get(KEYS[key], "");
+        }, [&](json configs)
+        {
+            legacy.publish(std::move(configs));
+        });
+        benchmark::printResult(locked);
+
+        const benchmark::Result indexed = measure("published index", threads, lookups, [&](uint64_t key)
+        {
+            return lookup(publisher, KEYS[key], "");
+        }, [&](json configs)
+        {
+            publishIndex(publisher, registry, std::move(configs));
+        });
+        benchmark::printResult(indexed);
+
+        const benchmark::Result typed = measure("RemoteConfig<int64_t>", threads, lookups, [&](uint64_t key)
+        {
+            return handles[key].get();
+        }, [&](json configs)
+        {
+            publishIndex(publisher, registry, std::move(configs));
+        });
+        benchmark::printResult(typed);
+
+        std::printf("  speedup: index %.1fx, handle %.1fx\n", locked.nsPerOp / indexed.nsPerOp, locked.nsPerOp / typed.nsPerOp);
+    }
+
+    return 0;
+}
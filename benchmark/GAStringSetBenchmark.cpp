@@ -0,0 +1,117 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// Membership checks against configured catalogs, like the available resource item types that
+// every resource event is checked against: the linear scan GAState used before and the hashed
+// GAStringSet it uses now. Half the lookups are misses. The validators accept at most 20 values
+// per list, the larger catalogs show how both scale past that.
+//
+
+#include "GABenchmark.h"
+
+#include "GACommon.h"
+#include "GAStringSet.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace gameanalytics;
+
+namespace
+{
+    // GAUtilities::stringVectorContainsString, which GAState used before, kept here for comparison
+    bool legacyContains(StringVector const& vector, std::string const& search)
+    {
+        for(std::string const& s : vector)
+        {
+            if(s == search)
+                return true;
+        }
+        return false;
+    }
+
+    std::string itemType(std::size_t i)
+    {
+        return "item_type_" + std::to_string(i);
+    }
+
+    StringVector makeCatalog(std::size_t size)
+    {
+        StringVector catalog;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            catalog.push_back(itemType(i));
+        }
+        return catalog;
+    }
+
+    // spread over the catalog, every other one is not in it
+    StringVector makeLookups(std::size_t size)
+    {
+        StringVector lookups;
+        for(std::size_t i = 0; i < 64; ++i)
+        {
+            lookups.push_back(i % 2 == 0 ? itemType(i * 7919 % size) : itemType(size + i));
+        }
+        return lookups;
+    }
+
+    benchmark::Result perLookup(benchmark::Result result, std::size_t lookups)
+    {
+        const double n = static_cast<double>(lookups);
+
+        result.iterations       *= lookups;
+        result.nsPerOp          /= n;
+        result.opsPerSecond     *= n;
+        result.allocationsPerOp /= n;
+        result.bytesPerOp       /= n;
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t passes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+
+    benchmark::printHeader("Membership checks against configured catalogs");
+
+    for(std::size_t size : {5, 20, 100, 1000, 10000})
+    {
+        const StringVector catalog = makeCatalog(size);
+        const StringVector lookups = makeLookups(size);
+        const utilities::GAStringSet set(catalog);
+
+        const std::string suffix = ", " + std::to_string(size) + " values";
+
+        // fewer passes over the larger catalogs for the scan
+        const uint64_t scanPasses = std::max<uint64_t>(passes * 20 / size, 10);
+
+        const benchmark::Result scan = perLookup(benchmark::run("linear scan" + suffix, scanPasses, [&]()
+        {
+            int found = 0;
+            for(std::string const& lookup : lookups)
+            {
+                found += legacyContains(catalog, lookup);
+            }
+            benchmark::doNotOptimize(found);
+        }), lookups.size());
+        benchmark::printResult(scan);
+
+        const benchmark::Result hashed = perLookup(benchmark::run("GAStringSet" + suffix, passes, [&]()
+        {
+            int found = 0;
+            for(std::string const& lookup : lookups)
+            {
+                found += set.contains(lookup);
+            }
+            benchmark::doNotOptimize(found);
+        }), lookups.size());
+        benchmark::printResult(hashed);
+
+        std::printf("  speedup: %.1fx\n", scan.nsPerOp / hashed.nsPerOp);
+    }
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+// Validator cost over the inputs of GAValidatorTests: the std::regex based checks the validators
+// used to run, which compiled their pattern on every call, against the GAPattern matchers the
+// validators use now. Every pass runs all inputs through every check. The second part validates
+// a small set of repeated design, progression and business ids with and without the cache of
+// validated ids.
+//
+
+#include "GABenchmark.h"
+
+#include "GACommon.h"
+#include "GAValidator.h"
+
+#include <cstdlib>
+#include <regex>
+#include <vector>
+
+using namespace gameanalytics;
+
+namespace
+{
+    // GAUtilities::stringMatch before the matchers, kept here for comparison
+    bool legacyStringMatch(std::string const& string, std::string const& pattern)
+    {
+        std::regex expression(pattern);
+        return std::regex_match(string, expression);
+    }
+
+    const char* const EVENT_PART_PATTERN = "^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}$";
+    const char* const EVENT_ID_LENGTH_PATTERN = "^[^:]{1,64}(?::[^:]{1,64}){0,4}$";
+    const char* const EVENT_ID_PATTERN = "^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}(:[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}){0,4}$";
+    const char* const WRAPPER_VERSION_PATTERN = "^(unity|unreal|corona|cocos2d|lumberyard|air|gamemaker|defold|godot) [0-9]{0,5}(\\.[0-9]{0,5}){0,2}(-alpha|-beta|a|b){0,1}$";
+    const char* const ENGINE_VERSION_PATTERN = "^(unity|unreal|corona|cocos2d|lumberyard|gamemaker|defold|godot) [0-9]{0,5}(\\.[0-9]{0,5}){0,2}$";
+
+    // from GAValidatorTests
+    const std::vector<std::string> CURRENCIES      = {"USD", "XXX", "usd", "US", "KR", "USDOLLARS", "$", ""};
+    const std::vector<std::string> EVENT_PARTS     = {"øææ", "*", "))&%", "sdfdffdgdfg", "name", "gems", "gold"};
+    const std::vector<std::string> EVENT_IDS       = {"GHj:df(g?h d_fk7-58.9)3!47", "GHj:df(g?h d_fk,7-58.9)3!47", "sdfdf", "name:name", "name:name:name:name:name", "name:name:name:name:name:name"};
+    const std::vector<std::string> VERSIONS        = {"123", "test 1.2.x", "unkfalsewn 1.5.6", "unreal 1.2.3.4", "Unreal 1.2", "corona1.2.3", "unreal x.2.3",
+                                                      "unreal 1.x.3", "marmalade 1.2.3", "unreal 1.2.3", "corona 1.2", "lumberyard 1", "cocos2d 1.2.3",
+                                                      "unreal 1233.101.0", "unity 123456.2.3", "uni 1.2.3"};
+    const std::vector<std::string> STORES          = {"apple", "google_play", "amazon"};
+    const std::vector<std::string> CONNECTIONS     = {"wifi", "lan", "offline", "wwan", "5g"};
+    const std::string GAME_KEY                     = "c6cfc80ff69d1e7316bf1e0c8194eda6";
+    const std::string GAME_SECRET                  = "e0ae4809f70e2fa96916c7060f417ae53895f18d";
+
+    std::size_t checksPerPass()
+    {
+        return CURRENCIES.size() + EVENT_PARTS.size() + 2 * EVENT_IDS.size() + 2 * VERSIONS.size() + STORES.size() + CONNECTIONS.size() + 1;
+    }
+
+    int legacyPass()
+    {
+        int valid = 0;
+        for(auto const& s : CURRENCIES)  valid += !s.empty() && legacyStringMatch(s, "^[A-Z]{3}$");
+        for(auto const& s : EVENT_PARTS) valid += legacyStringMatch(s, EVENT_PART_PATTERN);
+        for(auto const& s : EVENT_IDS)   valid += !s.empty() && legacyStringMatch(s, EVENT_ID_LENGTH_PATTERN);
+        for(auto const& s : EVENT_IDS)   valid += !s.empty() && legacyStringMatch(s, EVENT_ID_PATTERN);
+        for(auto const& s : VERSIONS)    valid += legacyStringMatch(s, WRAPPER_VERSION_PATTERN);
+        for(auto const& s : VERSIONS)    valid += legacyStringMatch(s, ENGINE_VERSION_PATTERN);
+        for(auto const& s : STORES)      valid += legacyStringMatch(s, "^(apple|google_play)$");
+        for(auto const& s : CONNECTIONS) valid += legacyStringMatch(s, "^(wwan|wifi|lan|offline)$");
+        valid += legacyStringMatch(GAME_KEY, "^[A-z0-9]{32}$") && legacyStringMatch(GAME_SECRET, "^[A-z0-9]{40}$");
+        return valid;
+    }
+
+    int matcherPass()
+    {
+        using validators::GAValidator;
+
+        int valid = 0;
+        for(auto const& s : CURRENCIES)  valid += GAValidator::validateCurrency(s);
+        for(auto const& s : EVENT_PARTS) valid += GAValidator::validateEventPartCharacters(s);
+        for(auto const& s : EVENT_IDS)   valid += GAValidator::validateEventIdLength(s);
+        for(auto const& s : EVENT_IDS)   valid += GAValidator::validateEventIdCharacters(s);
+        for(auto const& s : VERSIONS)    valid += GAValidator::validateSdkWrapperVersion(s);
+        for(auto const& s : VERSIONS)    valid += GAValidator::validateEngineVersion(s);
+        for(auto const& s : STORES)      valid += GAValidator::validateStore(s);
+        for(auto const& s : CONNECTIONS) valid += GAValidator::validateConnectionType(s);
+        valid += GAValidator::validateKeys(GAME_KEY, GAME_SECRET);
+        return valid;
+    }
+
+    // a handful of ids sent over and over, like a game does
+    int eventPass()
+    {
+        using validators::GAValidator;
+        using validators::ValidationResult;
+
+        static const std::vector<std::string> DESIGN_IDS = {"Combat:Hit:Sword", "Combat:Hit:Bow", "Shop:Open", "Ui:Click:Settings(Audio)"};
+
+        int valid = 0;
+        for(auto const& id : DESIGN_IDS)
+        {
+            ValidationResult result;
+            GAValidator::validateDesignEvent(id, result);
+            valid += result.result;
+        }
+
+        ValidationResult progression;
+        GAValidator::validateProgressionEvent(EGAProgressionStatus::Complete, "World_01", "Stage 3", "Boss!", progression);
+        valid += progression.result;
+
+        ValidationResult business;
+        GAValidator::validateBusinessEvent("USD", 99, "shop", "Gems", "PackOf100", business);
+        valid += business.result;
+
+        return valid;
+    }
+
+    constexpr std::size_t EVENTS_PER_PASS = 6;
+
+    benchmark::Result perEvent(benchmark::Result result)
+    {
+        result.iterations       *= EVENTS_PER_PASS;
+        result.nsPerOp          /= EVENTS_PER_PASS;
+        result.opsPerSecond     *= EVENTS_PER_PASS;
+        result.allocationsPerOp /= EVENTS_PER_PASS;
+        result.bytesPerOp       /= EVENTS_PER_PASS;
+        return result;
+    }
+
+    benchmark::Result perCheck(benchmark::Result result)
+    {
+        const double checks = static_cast<double>(checksPerPass());
+
+        result.iterations       *= checksPerPass();
+        result.nsPerOp          /= checks;
+        result.opsPerSecond     *= checks;
+        result.allocationsPerOp /= checks;
+        result.bytesPerOp       /= checks;
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t passes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+
+    if(legacyPass() != matcherPass())
+    {
+        std::printf("the matchers and the regexes disagree\n");
+        return 1;
+    }
+
+    benchmark::printHeader("Validator check cost over the GAValidatorTests inputs");
+
+    const benchmark::Result legacy = perCheck(benchmark::run("std::regex per call", passes, []()
+    {
+        benchmark::doNotOptimize(legacyPass());
+    }));
+    benchmark::printResult(legacy);
+
+    const benchmark::Result matchers = perCheck(benchmark::run("GAPattern matchers", passes * 100, []()
+    {
+        benchmark::doNotOptimize(matcherPass());
+    }));
+    benchmark::printResult(matchers);
+
+    std::printf("\nspeedup: %.1fx\n", legacy.nsPerOp / matchers.nsPerOp);
+
+    benchmark::printHeader("Repeated event validation with the validated id cache");
+
+    validators::GAValidator::setValidatedIdCacheCapacity(0);
+    const benchmark::Result uncached = perEvent(benchmark::run("no cache", passes * 100, []()
+    {
+        benchmark::doNotOptimize(eventPass());
+    }));
+    benchmark::printResult(uncached);
+
+    validators::GAValidator::setValidatedIdCacheCapacity(validators::GAValidatedIdCache::DEFAULT_CAPACITY);
+    const benchmark::Result cached = perEvent(benchmark::run("validated id cache", passes * 100, []()
+    {
+        benchmark::doNotOptimize(eventPass());
+    }));
+    benchmark::printResult(cached);
+
+    const validators::GAValidatedIdCache::Stats stats = validators::GAValidator::getValidatedIdCacheStats();
+    std::printf("\nhit rate: %.2f%%, speedup: %.1fx\n", stats.hitRate() * 100.0, uncached.nsPerOp / cached.nsPerOp);
+
+    return 0;
+}
@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/externals/googletest
+# Build directory: /root/repo/gtest_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("googlemock")
@@ -0,0 +1,79 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics/GATypes.h"
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        struct PlayerState;
+    }
+
+    /*!
+     One player reported by a game server, from GameAnalytics::createContext. A context has its own
+     user ids, session, custom dimensions, transaction number and progression tries, while all
+     contexts share the SDK's configuration, event store, batches and http client. The SDK must be
+     initialized and the context's session started before events are added.
+
+     The state of a context is kept in memory only: counters start from the values given to
+     createContext, and a session still running when the process dies is not recovered.
+     A session still running when the context is destroyed is ended.
+     */
+    class GAContext
+    {
+     public:
+
+        ~GAContext();
+
+        GAContext(GAContext const&) = delete;
+        GAContext& operator=(GAContext const&) = delete;
+
+        std::string const& getUserId() const;
+
+        void setExternalUserId(std::string const& externalUserId);
+
+        // validated against the available custom dimensions like GameAnalytics::setCustomDimension01
+        void setCustomDimension01(std::string const& dimension01);
+        void setCustomDimension02(std::string const& dimension02);
+        void setCustomDimension03(std::string const& dimension03);
+
+        // starting a session while one is running ends the running one first
+        void startSession();
+        void endSession();
+
+        void addBusinessEvent(std::string const& currency, int amount, std::string const& itemType, std::string const& itemId, std::string const& cartType, std::string const& customFields = "", bool mergeFields = false);
+
+        void addResourceEvent(EGAResourceFlowType flowType, std::string const& currency, float amount, std::string const& itemType, std::string const& itemId, std::string const& customFields = "", bool mergeFields = false);
+
+        void addProgressionEvent(EGAProgressionStatus progressionStatus, std::string const& progression01, std::string const& progression02 = "", std::string const& progression03 = "", std::string const& customFields = "", bool mergeFields = false);
+        void addProgressionEvent(EGAProgressionStatus progressionStatus, int score, std::string const& progression01, std::string const& progression02 = "", std::string const& progression03 = "", std::string const& customFields = "", bool mergeFields = false);
+
+        // design events of a context are never aggregated
+        void addDesignEvent(std::string const& eventId, std::string const& customFields = "", bool mergeFields = false);
+        void addDesignEvent(std::string const& eventId, double value, std::string const& customFields = "", bool mergeFields = false);
+
+        void addErrorEvent(EGAErrorSeverity severity, std::string const& message, std::string const& customFields = "", bool mergeFields = false);
+
+     private:
+
+        friend class GameAnalytics;
+
+        GAContext(std::string const& userId, int64_t sessionNum, int64_t transactionNum);
+
+        void addProgressionEvent(EGAProgressionStatus progressionStatus, int score, bool sendScore, std::string const& progression01, std::string const& progression02, std::string const& progression03, std::string const& customFields, bool mergeFields);
+        void addDesignEvent(std::string const& eventId, double value, bool sendValue, std::string const& customFields, bool mergeFields);
+        void setCustomDimension(int index, std::string const& dimension);
+
+        const std::string                   _userId;
+
+        // shared with the tasks queued on the GA thread, which may outlive the context
+        std::shared_ptr<state::PlayerState> _player;
+    };
+
+    using PlayerHandle = std::shared_ptr<GAContext>;
+}
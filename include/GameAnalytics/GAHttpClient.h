@@ -3,7 +3,15 @@
 #include <string>
 #include <string_view>
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <limits>
+#include <future>
+#include <memory>
+#include <utility>
 
 namespace gameanalytics
 { 
@@ -23,6 +31,114 @@ namespace gameanalytics
                 }
             };
 
+            // non-owning view of contiguous elements, the data must outlive the call it is passed to
+            template<typename T>
+            struct Span
+            {
+                T*          data = nullptr;
+                std::size_t size = 0;
+
+                Span() = default;
+                Span(T* d, std::size_t n): data(d), size(n) {}
+
+                template<typename Container, typename = decltype(std::declval<Container&>().data())>
+                Span(Container& c): data(c.data()), size(c.size()) {}
+
+                T* begin() const { return data; }
+                T* end()   const { return data + size; }
+                bool empty() const { return size == 0; }
+            };
+
+            // Limits of a single request. A request fails once it takes longer than total, or once it
+            // moves less than lowSpeedLimit bytes per second for lowSpeedTime. Zero disables a limit.
+            struct Timeouts
+            {
+                std::chrono::milliseconds connect{10000};
+                std::chrono::milliseconds total{60000};
+                long                      lowSpeedLimit = 100;
+                std::chrono::seconds      lowSpeedTime{30};
+            };
+
+            // Shared between the caller and the client to abort requests: either right away or once
+            // a deadline passes. A cancelled request fails like one that got no response.
+            class CancellationToken
+            {
+                public:
+
+                    using Clock = std::chrono::steady_clock;
+
+                    void cancel()
+                    {
+                        _cancelled = true;
+                    }
+
+                    // requests still running at deadline are aborted
+                    void cancelAt(Clock::time_point deadline)
+                    {
+                        _deadline = deadline.time_since_epoch().count();
+                    }
+
+                    void reset()
+                    {
+                        _cancelled = false;
+                        _deadline  = NO_DEADLINE;
+                    }
+
+                    bool isCancelled() const
+                    {
+                        if(_cancelled)
+                        {
+                            return true;
+                        }
+
+                        const Clock::rep deadline = _deadline;
+                        return deadline != NO_DEADLINE && Clock::now().time_since_epoch().count() >= deadline;
+                    }
+
+                private:
+
+                    static constexpr Clock::rep NO_DEADLINE = std::numeric_limits<Clock::rep>::max();
+
+                    std::atomic<bool>       _cancelled{false};
+                    std::atomic<Clock::rep> _deadline{NO_DEADLINE};
+            };
+
+            struct Header
+            {
+                std::string_view name;
+                std::string_view value;
+            };
+
+            // Everything a request needs, borrowed from the caller for the duration of send().
+            // headers holds Authorization, Content-Type and, for gzip payloads, Content-Encoding.
+            struct Request
+            {
+                std::string_view        url;
+                Span<const Header>      headers;
+                Span<const uint8_t>     payload;
+                void*                   userData = nullptr;
+                Timeouts                timeouts;
+                const CancellationToken* cancellation = nullptr;   // optional
+
+                // value of the header, empty if it isn't set
+                std::string_view header(std::string_view name) const
+                {
+                    for(Header const& h : headers)
+                    {
+                        if(h.name == name)
+                        {
+                            return h.value;
+                        }
+                    }
+                    return {};
+                }
+
+                bool isGzip() const
+                {
+                    return header("Content-Encoding") == "gzip";
+                }
+            };
+
             virtual ~GAHttpClient() {};
 
             virtual void initialize() = 0;
@@ -35,6 +151,83 @@ namespace gameanalytics
                 std::vector<uint8_t> const& payloadData, 
                 bool useGzip,
                 void* userData) = 0;
+
+            // Sends request and writes the result into response, whose packet is cleared but keeps its
+            // capacity, so a response object reused across requests stops allocating once it is big enough.
+            // The default implementation adapts sendRequest, which copies the inputs and can't apply the
+            // timeouts or abort a running request; override it to avoid that.
+            virtual void send(Request const& request, Response& response)
+            {
+                if(request.cancellation && request.cancellation->isCancelled())
+                {
+                    response.code = -1;
+                    response.packet.clear();
+                    return;
+                }
+
+                std::string auth;
+                const std::string_view authorization = request.header("Authorization");
+                if(!authorization.empty())
+                {
+                    auth.reserve(15 + authorization.size());
+                    auth.append("Authorization: ").append(authorization);
+                }
+
+                const std::vector<uint8_t> payload(request.payload.begin(), request.payload.end());
+
+                Response result = sendRequest(std::string(request.url), auth, payload, request.isGzip(), request.userData);
+
+                response.code = result.code;
+                response.packet.clear();
+                response.packet.insert(response.packet.end(), result.packet.begin(), result.packet.end());
+            }
+
+            // Resolves the host of url and opens a connection to it in the background, so the next
+            // request skips DNS, TCP and TLS setup. Resolved addresses may be cached for dnsTtl.
+            // Called again about every dnsTtl while a session runs. The default does nothing.
+            virtual void warmUp(std::string const& /*url*/, std::chrono::seconds /*dnsTtl*/)
+            {
+            }
+
+            using Callback = std::function<void(Response)>;
+
+            // Starts a request and calls callback with the result, possibly on another thread.
+            // The default implementation adapts sendRequest and completes before returning,
+            // so existing clients keep working; override it for non-blocking I/O.
+            virtual void sendRequestAsync(
+                std::string const& url,
+                std::string const& auth,
+                std::vector<uint8_t> payloadData,
+                bool useGzip,
+                void* userData,
+                Callback callback)
+            {
+                Response response = sendRequest(url, auth, payloadData, useGzip, userData);
+                if(callback)
+                {
+                    callback(std::move(response));
+                }
+            }
+
+            // sendRequestAsync with the result delivered through a future
+            std::future<Response> sendRequestFuture(
+                std::string const& url,
+                std::string const& auth,
+                std::vector<uint8_t> payloadData,
+                bool useGzip,
+                void* userData)
+            {
+                auto promise = std::make_shared<std::promise<Response>>();
+                std::future<Response> future = promise->get_future();
+
+                sendRequestAsync(url, auth, std::move(payloadData), useGzip, userData,
+                    [promise](Response response)
+                    {
+                        promise->set_value(std::move(response));
+                    });
+
+                return future;
+            }
     };
     
 } // namespace gameanalytics
@@ -0,0 +1,110 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GameAnalytics/GATypes.h"
+
+#include <atomic>
+#include <type_traits>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        class GARemoteConfigsRegistry;
+    }
+
+    // The value behind a RemoteConfig handle, shared with the SDK which stores the parsed value
+    // whenever an update changes it
+    template<typename T>
+    struct RemoteConfigState
+    {
+        explicit RemoteConfigState(T defaultValue):
+            value(defaultValue)
+        {
+        }
+
+        std::atomic<T>        value;
+        std::atomic<uint64_t> version{0};
+    };
+
+    template<>
+    struct RemoteConfigState<std::string>
+    {
+        explicit RemoteConfigState(std::string defaultValue):
+            value(std::make_shared<const std::string>(std::move(defaultValue)))
+        {
+        }
+
+        // swapped with std::atomic_store, never modified in place
+        std::shared_ptr<const std::string> value;
+        std::atomic<uint64_t>              version{0};
+    };
+
+    /*!
+     A remote config bound to one key, from GameAnalytics::getRemoteConfig. The value is parsed
+     once when the configs are updated, so get() is an atomic load that can be called from any
+     thread, e.g. every frame. Holds the default while the key is missing or its value can't be
+     read as T. version() goes up every time the value changes.
+     */
+    template<typename T>
+    class RemoteConfig
+    {
+        static_assert(std::is_same<T, bool>::value || std::is_same<T, int>::value || std::is_same<T, int64_t>::value ||
+                      std::is_same<T, float>::value || std::is_same<T, double>::value || std::is_same<T, std::string>::value,
+                      "RemoteConfig supports bool, int, int64_t, float, double and std::string");
+
+     public:
+
+        // an unbound handle, reads return T()
+        RemoteConfig() = default;
+
+        T get() const
+        {
+            if(!_state)
+            {
+                return T();
+            }
+
+            if constexpr (std::is_same<T, std::string>::value)
+            {
+                return *std::atomic_load(&_state->value);
+            }
+            else
+            {
+                return _state->value.load(std::memory_order_acquire);
+            }
+        }
+
+        uint64_t version() const
+        {
+            return _state ? _state->version.load(std::memory_order_acquire) : 0;
+        }
+
+        std::string const& key() const
+        {
+            return _key;
+        }
+
+        explicit operator bool() const
+        {
+            return static_cast<bool>(_state);
+        }
+
+     private:
+
+        friend class state::GARemoteConfigsRegistry;
+
+        RemoteConfig(std::string key, std::shared_ptr<RemoteConfigState<T>> state):
+            _key(std::move(key)),
+            _state(std::move(state))
+        {
+        }
+
+        std::string                           _key;
+        std::shared_ptr<RemoteConfigState<T>> _state;
+    };
+}
@@ -82,4 +82,10 @@ namespace gameanalytics
     {
         virtual void onRemoteConfigsUpdated(std::string const& remoteConfigs) = 0;
     };
+
+    // subscribed to some keys, only told which of them were added, changed or removed by an update
+    struct IRemoteConfigsKeyListener
+    {
+        virtual void onRemoteConfigsChanged(StringVector const& changedKeys) = 0;
+    };
 }
@@ -7,6 +7,10 @@
 
 #include "GameAnalytics/GATypes.h"
 #include "GameAnalytics/GAHttpClient.h"
+#include "GameAnalytics/GARemoteConfig.h"
+#include "GameAnalytics/GAContext.h"
+
+#include <chrono>
 
 namespace gameanalytics
 {
@@ -48,6 +52,11 @@ namespace gameanalytics
          static void configureWritablePath(std::string const& writablePath);
          static void configureBuildPlatform(std::string const& platform);
          static void configureCustomLogHandler(const LogHandler &logHandler);
+
+         // Limits of ga_log.txt in the writable path. Past maxFileSize (bytes) it is rotated to
+         // ga_log.1.txt and so on, keeping at most maxFiles files that together stay within
+         // diskBudget (bytes), rotated files can be gzip compressed. Defaults: 1 MB, 5 files, 5 MB.
+         static void configureLogFile(int64_t maxFileSize, int maxFiles, int64_t diskBudget, bool compressRotatedFiles = false);
          static void disableDeviceInfo();
          static void configureDeviceModel(std::string const& deviceModel);
          static void configureDeviceManufacturer(std::string const& deviceManufacturer);
@@ -63,6 +72,26 @@ namespace gameanalytics
         
          static void configureExternalUserId(std::string const& extId);
 
+         // How often (in seconds) the running session is recorded for session_end recovery after a crash.
+         // This bounds how stale a recovered session length can be. Default is 10 seconds.
+         static void configureSessionHeartbeatInterval(int seconds);
+
+         // Gzip level (0 - 9) for request payloads, 0 sends them uncompressed. Default is 9.
+         // GZIP_LEVEL_ADAPTIVE picks the level from the measured compression speed of the device and
+         // the measured upload bandwidth, and skips compression for tiny payloads.
+         static constexpr int GZIP_LEVEL_ADAPTIVE = -1;
+         static void configureGzipCompressionLevel(int level);
+
+         // Request timeouts in seconds, 0 disables one. A request fails after totalTimeout, or when it moves
+         // less than lowSpeedLimit bytes per second for lowSpeedTime. Defaults are 10, 60, 100 and 30.
+         static void configureHttpTimeouts(int connectTimeout, int totalTimeout, int lowSpeedLimit = 100, int lowSpeedTime = 30);
+
+         // Resolve the collector host and open a connection to it in the background during initialize(),
+         // so the first requests skip DNS, TCP and TLS setup. While a session runs this is repeated every
+         // refreshInterval seconds, which also bounds how long a resolved address is used. Off by default.
+         // Must be called before initialize().
+         static void configureConnectionWarmUp(bool enabled, int refreshInterval = 60);
+
          // Set a custom HTTP implementation. Must be called before initialize().
          // If not called, the default cURL implementation is used.
          template<typename T, typename ...args_t>
@@ -107,21 +136,66 @@ namespace gameanalytics
 
          ///////////
 
+         /**
+          * @brief: collapses design events that carry a value (and no custom fields) into one summary event
+          *         per event id and custom dimensions every window. The summary is sent as a design event with
+          *         value = sum and the custom fields agg_count, agg_sum, agg_min, agg_max
+          *
+          * @param value: enable or disable aggregation, disabling flushes the pending summaries
+          * @param windowInSeconds: length of an aggregation window
+          * @param histogramBounds: optional upper bucket bounds, adds agg_hist_bounds and agg_hist_counts to the summary
+          */
+         static void enableDesignEventAggregation(bool value = true, int windowInSeconds = 60, std::vector<double> const& histogramBounds = {});
+
          static void setGlobalCustomEventFields(std::string const& customFields);
 
+         /**
+          * @brief: local sampling and rate limiting rules, the remote config "ga_event_sampling" overrides them
+          *
+          * @param rules: json such as {"categories": {"error": {"sample_rate": 0.1, "rate_per_second": 5, "burst": 20}},
+          *               "prefixes": {"Combat:": {"sample_rate": 0.5}}}, an empty string removes the local rules
+          */
+         static void configureEventSampling(std::string const& rules);
+
          static void startSession();
          static void endSession();
 
          static std::string getRemoteConfigsValueAsString(std::string const& key, std::string const& defaultValue = "");
          static std::string getRemoteConfigsValueAsJson(std::string const& key);
 
+         /**
+          * @brief: a handle bound to a remote config, its value is parsed when the configs arrive so reading it is
+          *         one atomic load. Can be called before initialization, the handle holds defaultValue until then
+          *
+          * @param key: remote config key
+          * @param defaultValue: used while the key is missing or its value can't be read as T
+          *
+          * T can be bool, int, int64_t, float, double or std::string
+          */
+         template<typename T>
+         static RemoteConfig<T> getRemoteConfig(std::string const& key, T const& defaultValue = T());
 
          static bool        isRemoteConfigsReady();
          static void        addRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener> &listener);
          static void        removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener> &listener);
+
+         // told only about the given keys when they are added, changed or removed, an empty list means every key
+         static void        addRemoteConfigsListener(StringVector const& keys, const std::shared_ptr<IRemoteConfigsKeyListener> &listener);
+         static void        removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsKeyListener> &listener);
          
          static std::string getRemoteConfigsContentAsString();
 
+         /**
+          * @brief: a context for one player reported by a game server, with its own user id, session,
+          *         custom dimensions and progression state. Events of every context go into the same
+          *         store and batches as the game's own events. Returns nullptr for an empty userId
+          *
+          * @param userId: user id of the player
+          * @param sessionNum: sessions the player had before, the first session of the context is sessionNum + 1
+          * @param transactionNum: business events the player sent before
+          */
+         static PlayerHandle createContext(std::string const& userId, int64_t sessionNum = 0, int64_t transactionNum = 0);
+
          static std::string getUserId();
          static std::string getExternalUserId();
 
@@ -134,9 +208,14 @@ namespace gameanalytics
 
          // game state changes
          // will affect how session is started / ended
+         // onSuspend and onQuit end the session and send what is queued. Requests still running after
+         // timeout are aborted and their events stay stored for the next session. onQuit blocks until
+         // the SDK has shut down, at most about timeout + 1 second; onSuspend returns right away.
+         static constexpr std::chrono::milliseconds DEFAULT_SHUTDOWN_TIMEOUT{5000};
+
          static void onResume();
-         static void onSuspend();
-         static void onQuit();
+         static void onSuspend(std::chrono::milliseconds timeout = DEFAULT_SHUTDOWN_TIMEOUT);
+         static void onQuit(std::chrono::milliseconds timeout = DEFAULT_SHUTDOWN_TIMEOUT);
 
          static bool isThreadEnding();
 
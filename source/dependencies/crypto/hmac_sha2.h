@@ -99,8 +99,8 @@ void hmac_sha224(const unsigned char *key, unsigned int key_size,
                  const unsigned char *message, unsigned int message_len,
                  unsigned char *mac, unsigned mac_size);
 
-void hmac_sha256_init(hmac_sha256_ctx *ctx, const unsigned char *key,
-                      unsigned int key_size);
+void hmac_sha256_init2(hmac_sha256_ctx *ctx, const unsigned char *key,
+                       unsigned int key_size);
 void hmac_sha256_reinit(hmac_sha256_ctx *ctx);
 void hmac_sha256_update(hmac_sha256_ctx *ctx, const unsigned char *message,
                         unsigned int message_len);
@@ -0,0 +1,180 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAArena.h"
+#include <algorithm>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        namespace
+        {
+            // trivially destructible, so still readable after the arena itself is gone
+            thread_local bool threadArenaDestroyed = false;
+
+            struct ThreadArenaHolder
+            {
+                GAArena arena;
+
+                ~ThreadArenaHolder()
+                {
+                    threadArenaDestroyed = true;
+                }
+            };
+        }
+
+        GAArena::Scope::Scope()
+        {
+            if(GAArena* arena = threadArena())
+            {
+                arena->_depth++;
+            }
+        }
+
+        GAArena::Scope::~Scope()
+        {
+            GAArena* arena = threadArena();
+            if(arena && arena->_depth > 0 && --arena->_depth == 0)
+            {
+                arena->reset();
+            }
+        }
+
+        GAArena::GAArena(std::size_t blockSize):
+            _blockSize(std::max<std::size_t>(blockSize, 256))
+        {
+        }
+
+        GAArena::~GAArena()
+        {
+            for(Block& block : _blocks)
+            {
+                ::operator delete(block.data);
+            }
+        }
+
+        GAArena* GAArena::threadArena()
+        {
+            if(threadArenaDestroyed)
+            {
+                return nullptr;
+            }
+
+            static thread_local ThreadArenaHolder holder;
+            return &holder.arena;
+        }
+
+        void GAArena::addBlock(std::size_t minSize)
+        {
+            Block block;
+            block.size = std::max(_blockSize, minSize);
+            block.data = static_cast<char*>(::operator new(block.size));
+
+            _blocks.push_back(block);
+        }
+
+        void* GAArena::allocate(std::size_t size, std::size_t alignment)
+        {
+            if(size == 0)
+            {
+                size = 1;
+            }
+
+            while(true)
+            {
+                if(_current < _blocks.size())
+                {
+                    Block& block = _blocks[_current];
+
+                    const std::uintptr_t base    = reinterpret_cast<std::uintptr_t>(block.data);
+                    const std::uintptr_t aligned = (base + _offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+                    const std::size_t    start   = static_cast<std::size_t>(aligned - base);
+
+                    if(start + size <= block.size)
+                    {
+                        _offset = start + size;
+                        _used  += size;
+                        return block.data + start;
+                    }
+
+                    // block is full, move on to the next retained one
+                    if(_current + 1 < _blocks.size())
+                    {
+                        _current++;
+                        _offset = 0;
+                        continue;
+                    }
+                }
+
+                addBlock(size + alignment);
+                _current = _blocks.size() - 1;
+                _offset  = 0;
+            }
+        }
+
+        bool GAArena::owns(const void* ptr) const
+        {
+            const char* p = static_cast<const char*>(ptr);
+            for(Block const& block : _blocks)
+            {
+                if(p >= block.data && p < block.data + block.size)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void GAArena::reset()
+        {
+            // keep what a typical event needs, give back what a spike allocated
+            std::size_t retained = 0;
+            std::size_t keep = 0;
+            for(; keep < _blocks.size(); ++keep)
+            {
+                if(retained + _blocks[keep].size > MAX_RETAINED_BYTES)
+                {
+                    break;
+                }
+
+                retained += _blocks[keep].size;
+            }
+
+            for(std::size_t i = keep; i < _blocks.size(); ++i)
+            {
+                ::operator delete(_blocks[i].data);
+            }
+
+            _blocks.resize(keep);
+
+            _current = 0;
+            _offset  = 0;
+            _used    = 0;
+        }
+
+        bool GAArena::isActive() const
+        {
+            return _depth > 0;
+        }
+
+        std::size_t GAArena::bytesUsed() const
+        {
+            return _used;
+        }
+
+        std::size_t GAArena::capacity() const
+        {
+            std::size_t total = 0;
+            for(Block const& block : _blocks)
+            {
+                total += block.size;
+            }
+
+            return total;
+        }
+    }
+}
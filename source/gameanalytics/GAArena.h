@@ -0,0 +1,118 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        // Monotonic bump allocator owned by a thread. While a Scope is open, ArenaAllocator
+        // hands out memory from the current thread's arena. Frees are no-ops and everything
+        // is released at once when the outermost Scope closes.
+        //
+        // Objects allocated inside a Scope must be destroyed before it closes, on the same thread.
+        class GAArena
+        {
+            public:
+
+                static constexpr std::size_t DEFAULT_BLOCK_SIZE   = 16 * 1024;
+                static constexpr std::size_t MAX_RETAINED_BYTES   = 256 * 1024;
+
+                class Scope
+                {
+                    public:
+                        Scope();
+                        ~Scope();
+
+                        Scope(Scope const&) = delete;
+                        Scope& operator=(Scope const&) = delete;
+                };
+
+                explicit GAArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+                ~GAArena();
+
+                GAArena(GAArena const&) = delete;
+                GAArena& operator=(GAArena const&) = delete;
+
+                // arena of the calling thread, nullptr once the thread's arena has been destroyed
+                // (static destructors ending the session run after thread_local destructors)
+                static GAArena* threadArena();
+
+                void* allocate(std::size_t size, std::size_t alignment);
+                bool  owns(const void* ptr) const;
+
+                // rewinds to the first block, extra blocks are kept up to MAX_RETAINED_BYTES
+                void reset();
+
+                bool        isActive() const;
+                std::size_t bytesUsed() const;
+                std::size_t capacity() const;
+
+            private:
+
+                struct Block
+                {
+                    char*       data = nullptr;
+                    std::size_t size = 0;
+                };
+
+                void addBlock(std::size_t minSize);
+
+                std::vector<Block> _blocks;
+                std::size_t        _blockSize;
+                std::size_t        _current = 0;   // index of the block being filled
+                std::size_t        _offset  = 0;   // offset inside the current block
+                std::size_t        _used    = 0;
+                int                _depth   = 0;
+        };
+
+        // Stateless allocator: uses the thread's arena while a GAArena::Scope is open and the
+        // regular heap otherwise, so the same container type works in and out of a scope.
+        template<typename T>
+        struct ArenaAllocator
+        {
+            using value_type = T;
+
+            ArenaAllocator() noexcept = default;
+
+            template<typename U>
+            ArenaAllocator(ArenaAllocator<U> const&) noexcept {}
+
+            T* allocate(std::size_t n)
+            {
+                GAArena* arena = GAArena::threadArena();
+                if(arena && arena->isActive())
+                {
+                    return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+                }
+
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+
+            void deallocate(T* ptr, std::size_t) noexcept
+            {
+                GAArena* arena = GAArena::threadArena();
+                if(!arena || !arena->owns(ptr))
+                {
+                    ::operator delete(ptr);
+                }
+            }
+
+            template<typename U>
+            bool operator==(ArenaAllocator<U> const&) const noexcept { return true; }
+
+            template<typename U>
+            bool operator!=(ArenaAllocator<U> const&) const noexcept { return false; }
+        };
+
+        using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+        // nlohmann::json whose containers are allocated from the arena
+        using ArenaJson = nlohmann::basic_json<std::map, std::vector, std::string, bool, std::int64_t, std::uint64_t, double, ArenaAllocator>;
+    }
+}
@@ -0,0 +1,164 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GACompressionPolicy.h"
+
+#include <limits>
+
+namespace gameanalytics
+{
+    namespace http
+    {
+        namespace
+        {
+            // weight of a new sample in the moving averages
+            constexpr double SMOOTHING = 0.3;
+
+            // until a request was timed, a slow mobile connection
+            constexpr double DEFAULT_UPLOAD_BANDWIDTH = 256.0 * 1024;
+
+            struct LevelPrior
+            {
+                double bytesPerSecond;
+                double ratio;
+            };
+
+            // GAHTTPApi times the whole encode (serialize, deflate, sign), these are that throughput
+            // with miniz on a mixed events batch on a desktop core, see benchmark/GACompressionBenchmark.cpp
+            constexpr LevelPrior PRIORS[GACompressionPolicy::MAX_LEVEL + 1] =
+            {
+                { 0.0,    1.0   },
+                { 60.0e6, 0.103 },
+                { 48.0e6, 0.087 },
+                { 43.0e6, 0.077 },
+                { 42.0e6, 0.077 },
+                { 40.0e6, 0.076 },
+                { 33.0e6, 0.075 },
+                { 32.0e6, 0.074 },
+                { 29.0e6, 0.074 },
+                { 25.0e6, 0.073 }
+            };
+
+            double smooth(double average, double sample)
+            {
+                return average + SMOOTHING * (sample - average);
+            }
+        }
+
+        GACompressionPolicy::GACompressionPolicy():
+            _uploadBytesPerSecond(DEFAULT_UPLOAD_BANDWIDTH)
+        {
+        }
+
+        bool GACompressionPolicy::setLevel(int level)
+        {
+            if(level != ADAPTIVE && (level < 0 || level > MAX_LEVEL))
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _level = level;
+            return true;
+        }
+
+        int GACompressionPolicy::getLevel() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _level;
+        }
+
+        double GACompressionPolicy::expectedSeconds(int level, double payloadSize) const
+        {
+            LevelStats const& stats = _stats[level];
+
+            const double bytesPerSecond = stats.measured ? stats.bytesPerSecond : PRIORS[level].bytesPerSecond * _speedFactor;
+            const double ratio          = stats.measured ? stats.ratio : PRIORS[level].ratio * _ratioFactor;
+
+            return payloadSize / bytesPerSecond + payloadSize * ratio / _uploadBytesPerSecond;
+        }
+
+        int GACompressionPolicy::chooseLevel(std::size_t payloadSize) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if(_level != ADAPTIVE)
+            {
+                return _level;
+            }
+
+            if(payloadSize < MIN_ADAPTIVE_SIZE)
+            {
+                return 0;
+            }
+
+            int    best        = DEFAULT_LEVEL;
+            double bestSeconds = std::numeric_limits<double>::max();
+
+            for(int level = 1; level <= MAX_LEVEL; ++level)
+            {
+                const double seconds = expectedSeconds(level, static_cast<double>(payloadSize));
+                if(seconds < bestSeconds)
+                {
+                    best        = level;
+                    bestSeconds = seconds;
+                }
+            }
+
+            return best;
+        }
+
+        void GACompressionPolicy::recordCompression(int level, std::size_t inputBytes, std::size_t outputBytes, std::chrono::duration<double> elapsed)
+        {
+            // too small to time reliably
+            if(level <= 0 || level > MAX_LEVEL || inputBytes < MIN_ADAPTIVE_SIZE || elapsed.count() <= 0.0)
+            {
+                return;
+            }
+
+            const double bytesPerSecond = static_cast<double>(inputBytes) / elapsed.count();
+            const double ratio          = static_cast<double>(outputBytes) / static_cast<double>(inputBytes);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            LevelStats& stats = _stats[level];
+            if(stats.measured)
+            {
+                stats.bytesPerSecond = smooth(stats.bytesPerSecond, bytesPerSecond);
+                stats.ratio          = smooth(stats.ratio, ratio);
+            }
+            else
+            {
+                stats.bytesPerSecond = bytesPerSecond;
+                stats.ratio          = ratio;
+                stats.measured       = true;
+            }
+
+            _speedFactor = smooth(_speedFactor, stats.bytesPerSecond / PRIORS[level].bytesPerSecond);
+            _ratioFactor = smooth(_ratioFactor, stats.ratio / PRIORS[level].ratio);
+        }
+
+        void GACompressionPolicy::recordUpload(std::size_t bytes, std::chrono::duration<double> elapsed)
+        {
+            if(bytes < MIN_BANDWIDTH_SAMPLE || elapsed.count() <= 0.0)
+            {
+                return;
+            }
+
+            // includes the round trip, so this errs on the slow side
+            const double bytesPerSecond = static_cast<double>(bytes) / elapsed.count();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _uploadBytesPerSecond = _uploadMeasured ? smooth(_uploadBytesPerSecond, bytesPerSecond) : bytesPerSecond;
+            _uploadMeasured = true;
+        }
+
+        double GACompressionPolicy::getUploadBandwidth() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _uploadBytesPerSecond;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <array>
+#include <chrono>
+#include <mutex>
+
+namespace gameanalytics
+{
+    namespace http
+    {
+        // Picks the gzip level for request payloads. Either a fixed level (0 sends uncompressed)
+        // or adaptive: the level with the lowest expected compress + upload time is chosen from
+        // the measured deflate throughput of this device and the measured upload bandwidth,
+        // payloads too small to benefit are sent uncompressed.
+        class GACompressionPolicy
+        {
+            public:
+
+                static constexpr int ADAPTIVE      = -1;
+                static constexpr int DEFAULT_LEVEL = 9;
+                static constexpr int MAX_LEVEL     = 9;
+
+                // below this the gzip framing eats most of what deflate saves
+                static constexpr std::size_t MIN_ADAPTIVE_SIZE = 512;
+
+                // smaller uploads are dominated by latency and say little about bandwidth
+                static constexpr std::size_t MIN_BANDWIDTH_SAMPLE = 16 * 1024;
+
+                GACompressionPolicy();
+
+                // 0 - 9 or ADAPTIVE, returns false for anything else
+                bool setLevel(int level);
+                int  getLevel() const;
+
+                // level to encode a payload of about payloadSize bytes with, 0 for no compression
+                int chooseLevel(std::size_t payloadSize) const;
+
+                void recordCompression(int level, std::size_t inputBytes, std::size_t outputBytes, std::chrono::duration<double> elapsed);
+                void recordUpload(std::size_t bytes, std::chrono::duration<double> elapsed);
+
+                double getUploadBandwidth() const;
+
+            private:
+
+                struct LevelStats
+                {
+                    double bytesPerSecond = 0.0;   // uncompressed bytes deflated per second
+                    double ratio          = 0.0;   // compressed / uncompressed
+                    bool   measured       = false;
+                };
+
+                double expectedSeconds(int level, double payloadSize) const;
+
+                mutable std::mutex _mutex;
+
+                int _level = DEFAULT_LEVEL;
+
+                std::array<LevelStats, MAX_LEVEL + 1> _stats;
+
+                // measured / prior, carries what was learned on one level over to the others
+                double _speedFactor = 1.0;
+                double _ratioFactor = 1.0;
+
+                double _uploadBytesPerSecond;
+                bool   _uploadMeasured = false;
+        };
+    }
+}
@@ -0,0 +1,156 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAEventAggregator.h"
+#include <algorithm>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        void GAEventAggregator::configure(bool enabled, std::chrono::seconds window, std::vector<double> histogramBounds, std::chrono::steady_clock::time_point now)
+        {
+            // the first window starts when aggregation is turned on, not when the aggregator was created
+            if(enabled && !_enabled)
+            {
+                _windowStart = now;
+            }
+
+            _enabled = enabled;
+            _window  = std::max(window, std::chrono::seconds(1));
+
+            histogramBounds = normalizeHistogramBounds(std::move(histogramBounds));
+
+            // summaries built with the old bounds can not be merged with the new ones
+            if(histogramBounds != _histogramBounds)
+            {
+                for(auto& entry : _summaries)
+                {
+                    entry.second.histogram.clear();
+                }
+            }
+
+            _histogramBounds = std::move(histogramBounds);
+        }
+
+        std::vector<double> GAEventAggregator::normalizeHistogramBounds(std::vector<double> histogramBounds)
+        {
+            std::sort(histogramBounds.begin(), histogramBounds.end());
+            histogramBounds.erase(std::unique(histogramBounds.begin(), histogramBounds.end()), histogramBounds.end());
+
+            if(histogramBounds.size() > MAX_HISTOGRAM_BOUNDS)
+            {
+                histogramBounds.resize(MAX_HISTOGRAM_BOUNDS);
+            }
+
+            return histogramBounds;
+        }
+
+        bool GAEventAggregator::isEnabled() const
+        {
+            return _enabled;
+        }
+
+        std::chrono::seconds GAEventAggregator::getWindow() const
+        {
+            return _window;
+        }
+
+        std::vector<double> const& GAEventAggregator::getHistogramBounds() const
+        {
+            return _histogramBounds;
+        }
+
+        std::string GAEventAggregator::makeKey(std::string const& eventId, std::array<std::string, NUM_DIMENSIONS> const& dimensions) const
+        {
+            // ':' is a valid event id separator so use a control character which can not be part of an id or dimension
+            constexpr char SEPARATOR = '\x1f';
+
+            std::string key = eventId;
+            for(std::string const& dimension : dimensions)
+            {
+                key += SEPARATOR;
+                key += dimension;
+            }
+
+            return key;
+        }
+
+        void GAEventAggregator::add(std::string const& eventId, std::array<std::string, NUM_DIMENSIONS> const& dimensions, double value)
+        {
+            const std::string key = makeKey(eventId, dimensions);
+
+            auto it = _summaries.find(key);
+            if(it == _summaries.end())
+            {
+                Summary summary;
+                summary.eventId    = eventId;
+                summary.dimensions = dimensions;
+                summary.min = value;
+                summary.max = value;
+
+                it = _summaries.emplace(key, std::move(summary)).first;
+                _order.push_back(key);
+            }
+
+            Summary& summary = it->second;
+
+            summary.count++;
+            summary.sum += value;
+            summary.min = std::min(summary.min, value);
+            summary.max = std::max(summary.max, value);
+
+            if(!_histogramBounds.empty())
+            {
+                summary.histogram.resize(_histogramBounds.size() + 1, 0u);
+
+                const std::size_t bucket = std::upper_bound(_histogramBounds.begin(), _histogramBounds.end(), value) - _histogramBounds.begin();
+                summary.histogram[bucket]++;
+            }
+        }
+
+        bool GAEventAggregator::isWindowElapsed(std::chrono::steady_clock::time_point now) const
+        {
+            return (now - _windowStart) >= _window;
+        }
+
+        void GAEventAggregator::flush(FlushHandler const& handler, std::chrono::steady_clock::time_point now)
+        {
+            _windowStart = now;
+
+            if(_summaries.empty())
+            {
+                return;
+            }
+
+            // take ownership first, the handler may end up adding new events
+            std::unordered_map<std::string, Summary> summaries;
+            std::vector<std::string> order;
+
+            summaries.swap(_summaries);
+            order.swap(_order);
+
+            if(!handler)
+            {
+                return;
+            }
+
+            for(std::string const& key : order)
+            {
+                handler(summaries.at(key));
+            }
+        }
+
+        std::size_t GAEventAggregator::size() const
+        {
+            return _summaries.size();
+        }
+
+        bool GAEventAggregator::empty() const
+        {
+            return _summaries.empty();
+        }
+    }
+}
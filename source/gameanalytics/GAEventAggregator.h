@@ -0,0 +1,78 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        // Collapses high frequency design events into one summary per (event id, custom dimensions)
+        // key and window. Only touched from the GA thread.
+        class GAEventAggregator
+        {
+            public:
+
+                static constexpr int         NUM_DIMENSIONS       = 3;
+                static constexpr std::size_t MAX_HISTOGRAM_BOUNDS = 16;
+
+                struct Summary
+                {
+                    std::string eventId;
+                    std::array<std::string, NUM_DIMENSIONS> dimensions;
+
+                    int64_t count = 0;
+                    double  sum   = 0.0;
+                    double  min   = 0.0;
+                    double  max   = 0.0;
+
+                    // histogram[i] counts values < bounds[i], the last bucket counts the remainder
+                    std::vector<uint32_t> histogram;
+                };
+
+                using FlushHandler = std::function<void(Summary const&)>;
+
+                // enabling starts a new window at now
+                void configure(bool enabled, std::chrono::seconds window, std::vector<double> histogramBounds = {},
+                               std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+                // sorted, without duplicates and at most MAX_HISTOGRAM_BOUNDS, as configure() keeps them
+                static std::vector<double> normalizeHistogramBounds(std::vector<double> histogramBounds);
+
+                bool isEnabled() const;
+                std::chrono::seconds getWindow() const;
+                std::vector<double> const& getHistogramBounds() const;
+
+                void add(std::string const& eventId, std::array<std::string, NUM_DIMENSIONS> const& dimensions, double value);
+
+                bool isWindowElapsed(std::chrono::steady_clock::time_point now) const;
+
+                // hands every summary to the handler and starts a new window
+                void flush(FlushHandler const& handler, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+                std::size_t size() const;
+                bool empty() const;
+
+            private:
+
+                std::string makeKey(std::string const& eventId, std::array<std::string, NUM_DIMENSIONS> const& dimensions) const;
+
+                bool                    _enabled = false;
+                std::chrono::seconds    _window{60};
+                std::vector<double>     _histogramBounds;
+
+                std::chrono::steady_clock::time_point _windowStart = std::chrono::steady_clock::now();
+
+                std::unordered_map<std::string, Summary> _summaries;
+                std::vector<std::string>                 _order;
+        };
+    }
+}
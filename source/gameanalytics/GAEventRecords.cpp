@@ -0,0 +1,327 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAEventRecords.h"
+#include "GAUtilities.h"
+#include "GALogger.h"
+
+#include <iterator>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        namespace
+        {
+            template<typename Json>
+            void setSampleRate(Json& fields, double sampleRate)
+            {
+                if(!fields.is_object())
+                {
+                    fields = Json::object();
+                }
+
+                // a field of the same name is replaced, sample_rate counts towards the custom fields limit
+                fields.erase("sample_rate");
+
+                const std::size_t maxFields = static_cast<std::size_t>(MAX_CUSTOM_FIELDS_COUNT) - 1;
+                if(fields.size() > maxFields)
+                {
+                    auto itr = fields.begin();
+                    std::advance(itr, maxFields);
+
+                    while(itr != fields.end())
+                    {
+                        logging::GALogger::w("Sampled event: custom field %s has been omitted to make room for sample_rate", std::string(itr.key()).c_str());
+                        itr = fields.erase(itr);
+                    }
+                }
+
+                fields["sample_rate"] = sampleRate;
+            }
+        }
+
+        void addSampleRate(json& fields, double sampleRate)
+        {
+            setSampleRate(fields, sampleRate);
+        }
+
+        void addSampleRate(EventJson& fields, double sampleRate)
+        {
+            setSampleRate(fields, sampleRate);
+        }
+
+        // ---- ANNOTATIONS ---- //
+
+        void EventAnnotations::write(utilities::GAJsonWriter& writer) const
+        {
+            writer.field("v", 2);
+            writer.field("event_uuid", eventUuid);
+            writer.field("user_id", userId);
+
+            if(configurations.is_array() && !configurations.empty())
+            {
+                writer.field("configurations_v3", configurations);
+            }
+
+            writer.field("sdk_version", sdkVersion);
+            writer.field("client_ts", clientTs);
+            writer.field("os_version", osVersion);
+            writer.field("manufacturer", manufacturer);
+            writer.field("device", device);
+            writer.field("platform", platform);
+            writer.field("session_id", sessionId);
+            writer.field("session_num", sessionNum);
+            writer.field("connection_type", connectionType);
+            writer.field("current_session_length", currentSessionLength);
+            writer.field("lifetime_session_length", lifetimeSessionLength);
+
+            writer.fieldIfNotEmpty("ab_id", abId);
+            writer.fieldIfNotEmpty("ab_variant_id", abVariantId);
+            writer.fieldIfNotEmpty("user_id_ext", externalUserId);
+            writer.fieldIfNotEmpty("build", build);
+            writer.fieldIfNotEmpty("engine_version", engineVersion);
+            writer.fieldIfNotEmpty("uwp_aid", uwpAid);
+            writer.fieldIfNotEmpty("uwp_id", uwpId);
+        }
+
+        static void addIfNotEmpty(json& out, const char* key, EventString const& str)
+        {
+            if(!str.empty())
+            {
+                out[key] = std::string(str.data(), str.size());
+            }
+        }
+
+        void EventAnnotations::toJson(json& out) const
+        {
+            out["v"]          = 2;
+            out["event_uuid"] = eventUuid;
+            out["user_id"]    = userId;
+
+            if(configurations.is_array() && !configurations.empty())
+            {
+                out["configurations_v3"] = configurations;
+            }
+
+            out["sdk_version"]              = sdkVersion;
+            out["client_ts"]                = clientTs;
+            out["os_version"]               = osVersion;
+            out["manufacturer"]             = manufacturer;
+            out["device"]                   = device;
+            out["platform"]                 = platform;
+            out["session_id"]               = sessionId;
+            out["session_num"]              = sessionNum;
+            out["connection_type"]          = connectionType;
+            out["current_session_length"]   = currentSessionLength;
+            out["lifetime_session_length"]  = lifetimeSessionLength;
+
+            addIfNotEmpty(out, "ab_id", abId);
+            addIfNotEmpty(out, "ab_variant_id", abVariantId);
+            addIfNotEmpty(out, "user_id_ext", externalUserId);
+            addIfNotEmpty(out, "build", build);
+            addIfNotEmpty(out, "engine_version", engineVersion);
+            addIfNotEmpty(out, "uwp_aid", uwpAid);
+            addIfNotEmpty(out, "uwp_id", uwpId);
+        }
+
+        // ---- RECORDS ---- //
+
+        void EventRecord::write(utilities::GAJsonWriter& writer, double sampleRate) const
+        {
+            writer.field("category", category());
+
+            writeFields(writer);
+
+            writer.fieldIfNotEmpty("custom_01", dimensions[0]);
+            writer.fieldIfNotEmpty("custom_02", dimensions[1]);
+            writer.fieldIfNotEmpty("custom_03", dimensions[2]);
+
+            const bool hasFields       = customFields.is_object() && !customFields.empty();
+            const bool hasGlobalFields = !hasFields && globalCustomFields && !globalCustomFields->empty();
+
+            if(sampleRate < 1.0)
+            {
+                // rare enough to go through json, the fields may already be at the limit or have a sample_rate
+                EventJson fields = hasFields ? customFields :
+                    hasGlobalFields ? EventJson::parse("{" + *globalCustomFields + "}") : EventJson::object();
+
+                addSampleRate(fields, sampleRate);
+                writer.field("custom_fields", fields);
+            }
+            else if(hasFields || hasGlobalFields)
+            {
+                writer.key("custom_fields");
+                writer.beginObject();
+
+                if(hasFields)
+                {
+                    for(auto const& item : customFields.items())
+                    {
+                        writer.key(item.key());
+                        writer.value(item.value());
+                    }
+                }
+                else
+                {
+                    writer.members(*globalCustomFields);
+                }
+
+                writer.endObject();
+            }
+        }
+
+        std::string EventRecord::customFieldsString() const
+        {
+            if(customFields.is_object() && !customFields.empty())
+            {
+                return customFields.dump(JSON_PRINT_INDENT);
+            }
+
+            if(globalCustomFields && !globalCustomFields->empty())
+            {
+                return json::parse("{" + *globalCustomFields + "}").dump(JSON_PRINT_INDENT);
+            }
+
+            return customFields.dump(JSON_PRINT_INDENT);
+        }
+
+        const char* BusinessEventRecord::category() const
+        {
+            return "business";
+        }
+
+        EventString BusinessEventRecord::eventId() const
+        {
+            return itemType + ':' + itemId;
+        }
+
+        void BusinessEventRecord::writeFields(utilities::GAJsonWriter& writer) const
+        {
+            writer.field("event_id", eventId());
+            writer.field("currency", currency);
+            writer.field("amount", amount);
+            writer.field("transaction_num", transactionNum);
+            writer.fieldIfNotEmpty("cart_type", cartType);
+        }
+
+        const char* ResourceEventRecord::category() const
+        {
+            return "resource";
+        }
+
+        EventString ResourceEventRecord::eventId() const
+        {
+            return flowType + ':' + currency + ':' + itemType + ':' + itemId;
+        }
+
+        void ResourceEventRecord::writeFields(utilities::GAJsonWriter& writer) const
+        {
+            writer.field("event_id", eventId());
+            writer.field("amount", amount);
+        }
+
+        const char* ProgressionEventRecord::category() const
+        {
+            return "progression";
+        }
+
+        EventString ProgressionEventRecord::eventId() const
+        {
+            return status + ':' + progression;
+        }
+
+        void ProgressionEventRecord::writeFields(utilities::GAJsonWriter& writer) const
+        {
+            writer.field("event_id", eventId());
+
+            if(hasScore)
+            {
+                writer.field("score", score);
+            }
+
+            if(hasAttempt)
+            {
+                writer.field("attempt_num", attemptNum);
+            }
+        }
+
+        const char* DesignEventRecord::category() const
+        {
+            return "design";
+        }
+
+        EventString DesignEventRecord::eventId() const
+        {
+            return id;
+        }
+
+        void DesignEventRecord::writeFields(utilities::GAJsonWriter& writer) const
+        {
+            writer.field("event_id", id);
+
+            if(hasValue)
+            {
+                writer.field("value", value);
+            }
+        }
+
+        const char* ErrorEventRecord::category() const
+        {
+            return "error";
+        }
+
+        void ErrorEventRecord::writeFields(utilities::GAJsonWriter& writer) const
+        {
+            writer.field("severity", severity);
+            writer.field("message", message);
+
+            if(!functionName.empty())
+            {
+                writer.field("function_name", functionName);
+
+                if(lineNumber >= 0)
+                {
+                    writer.field("line_number", static_cast<int64_t>(lineNumber));
+                }
+            }
+        }
+
+        const char* SessionEndEventRecord::category() const
+        {
+            return "session_end";
+        }
+
+        void SessionEndEventRecord::writeFields(utilities::GAJsonWriter& writer) const
+        {
+            writer.field("length", length);
+        }
+
+        const char* HealthEventRecord::category() const
+        {
+            return "health";
+        }
+
+        void HealthEventRecord::writeFields(utilities::GAJsonWriter& writer) const
+        {
+            if(!health.is_object())
+            {
+                return;
+            }
+
+            for(auto const& item : health.items())
+            {
+                // category is written by the record itself
+                if(item.key() == "category")
+                {
+                    continue;
+                }
+
+                writer.key(item.key());
+                writer.value(item.value());
+            }
+        }
+    }
+}
@@ -0,0 +1,178 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+#include "GAJsonWriter.h"
+#include "GAArena.h"
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        // strings and json used while building an event, allocated from the GA thread arena
+        // while a utilities::GAArena::Scope is open
+        using EventString = utilities::ArenaString;
+        using EventJson   = utilities::ArenaJson;
+
+        // Default annotations added to every event (see GAState::getEventAnnotations)
+        struct EventAnnotations
+        {
+            EventString  eventUuid;
+            EventString  userId;
+            EventString  sdkVersion;
+            EventString  osVersion;
+            EventString  manufacturer;
+            EventString  device;
+            EventString  platform;
+            EventString  sessionId;
+            EventString  connectionType;
+            EventString  abId;
+            EventString  abVariantId;
+            EventString  externalUserId;
+            EventString  build;
+            EventString  engineVersion;
+            EventString  uwpAid;
+            EventString  uwpId;
+
+            EventJson    configurations;
+
+            int64_t      clientTs              = 0;
+            int64_t      sessionNum            = 0;
+            int64_t      currentSessionLength  = 0;
+            int64_t      lifetimeSessionLength = 0;
+
+            void write(utilities::GAJsonWriter& writer) const;
+            void toJson(json& out) const;
+        };
+
+        // sets the sample_rate custom field of a sampled event, in place of a field of the same name
+        // and dropping the last fields if it would go over MAX_CUSTOM_FIELDS_COUNT
+        void addSampleRate(json& fields, double sampleRate);
+        void addSampleRate(EventJson& fields, double sampleRate);
+
+        // Typed event data, serialized directly without building a json DOM.
+        // Only the user supplied custom fields are kept as json.
+        struct EventRecord
+        {
+            std::array<EventString, 3>  dimensions;
+            EventJson                   customFields;
+
+            // the serialized global custom fields, written instead of customFields when the
+            // event brings no fields of their own (see GAEvents::addCustomFieldsToRecord)
+            std::shared_ptr<const std::string> globalCustomFields;
+
+            virtual ~EventRecord() = default;
+
+            virtual const char* category() const = 0;
+            virtual EventString eventId() const { return {}; }
+
+            // writes category, event specific values, custom dimensions and custom fields
+            void write(utilities::GAJsonWriter& writer, double sampleRate = 1.0) const;
+
+            // the custom fields as json text, for logging
+            std::string customFieldsString() const;
+
+        protected:
+
+            virtual void writeFields(utilities::GAJsonWriter& writer) const = 0;
+        };
+
+        struct BusinessEventRecord : EventRecord
+        {
+            EventString  itemType;
+            EventString  itemId;
+            EventString  currency;
+            EventString  cartType;
+            int64_t      amount         = 0;
+            int64_t      transactionNum = 0;
+
+            const char* category() const override;
+            EventString eventId() const override;
+
+        protected:
+            void writeFields(utilities::GAJsonWriter& writer) const override;
+        };
+
+        struct ResourceEventRecord : EventRecord
+        {
+            EventString  flowType;
+            EventString  currency;
+            EventString  itemType;
+            EventString  itemId;
+            double       amount = 0.0;
+
+            const char* category() const override;
+            EventString eventId() const override;
+
+        protected:
+            void writeFields(utilities::GAJsonWriter& writer) const override;
+        };
+
+        struct ProgressionEventRecord : EventRecord
+        {
+            EventString  status;
+            EventString  progression;
+            bool         hasScore   = false;
+            int64_t      score      = 0;
+            bool         hasAttempt = false;
+            int64_t      attemptNum = 0;
+
+            const char* category() const override;
+            EventString eventId() const override;
+
+        protected:
+            void writeFields(utilities::GAJsonWriter& writer) const override;
+        };
+
+        struct DesignEventRecord : EventRecord
+        {
+            EventString  id;
+            bool         hasValue = false;
+            double       value    = 0.0;
+
+            const char* category() const override;
+            EventString eventId() const override;
+
+        protected:
+            void writeFields(utilities::GAJsonWriter& writer) const override;
+        };
+
+        struct ErrorEventRecord : EventRecord
+        {
+            EventString  severity;
+            EventString  message;
+            EventString  functionName;
+            int32_t      lineNumber = -1;
+
+            const char* category() const override;
+
+        protected:
+            void writeFields(utilities::GAJsonWriter& writer) const override;
+        };
+
+        struct SessionEndEventRecord : EventRecord
+        {
+            int64_t      length = 0;
+
+            const char* category() const override;
+
+        protected:
+            void writeFields(utilities::GAJsonWriter& writer) const override;
+        };
+
+        struct HealthEventRecord : EventRecord
+        {
+            // filled by GAHealth, sent once per session so it stays a json object
+            json         health;
+
+            const char* category() const override;
+
+        protected:
+            void writeFields(utilities::GAJsonWriter& writer) const override;
+        };
+    }
+}
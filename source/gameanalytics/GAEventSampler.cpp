@@ -0,0 +1,257 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAEventSampler.h"
+#include "GALogger.h"
+#include <algorithm>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        GAEventSampler::GAEventSampler(uint32_t seed):
+            _rng(seed)
+        {
+        }
+
+        bool GAEventSampler::isExempt(std::string_view category)
+        {
+            // session bookkeeping and revenue are never dropped
+            return category == "user" || category == "session_end" || category == "business";
+        }
+
+        bool GAEventSampler::parseRule(json const& node, Rule& out)
+        {
+            if(!node.is_object())
+            {
+                return false;
+            }
+
+            Rule rule;
+            rule.sampleRate    = node.value("sample_rate", 1.0);
+            rule.ratePerSecond = node.value("rate_per_second", 0.0);
+            rule.burst         = node.value("burst", rule.ratePerSecond);
+
+            if(!(rule.sampleRate >= 0.0 && rule.sampleRate <= 1.0) || !(rule.ratePerSecond >= 0.0) || !(rule.burst >= 0.0))
+            {
+                return false;
+            }
+
+            // a bucket needs room for at least one event
+            if(rule.ratePerSecond > 0.0)
+            {
+                rule.burst = std::max(rule.burst, 1.0);
+            }
+
+            out = rule;
+            return true;
+        }
+
+        bool GAEventSampler::parseRuleSet(json const& rules, RuleSet& out)
+        {
+            if(!rules.is_object())
+            {
+                return false;
+            }
+
+            RuleSet result;
+
+            if(rules.contains("categories") && rules["categories"].is_object())
+            {
+                for(auto const& item : rules["categories"].items())
+                {
+                    Rule rule;
+                    if(!parseRule(item.value(), rule))
+                    {
+                        logging::GALogger::w("Event sampling: invalid rule for category '%s'", item.key().c_str());
+                        continue;
+                    }
+
+                    result.categories[item.key()] = rule;
+                }
+            }
+
+            if(rules.contains("prefixes") && rules["prefixes"].is_object())
+            {
+                for(auto const& item : rules["prefixes"].items())
+                {
+                    Rule rule;
+                    if(item.key().empty() || !parseRule(item.value(), rule))
+                    {
+                        logging::GALogger::w("Event sampling: invalid rule for prefix '%s'", item.key().c_str());
+                        continue;
+                    }
+
+                    result.prefixes.emplace_back(item.key(), rule);
+                }
+
+                std::sort(result.prefixes.begin(), result.prefixes.end(),
+                    [](auto const& a, auto const& b)
+                    {
+                        return a.first.size() > b.first.size();
+                    });
+            }
+
+            out = std::move(result);
+            return true;
+        }
+
+        bool GAEventSampler::setRules(json const& rules, ERuleSource source)
+        {
+            try
+            {
+                RuleSet ruleSet;
+                if(!parseRuleSet(rules, ruleSet))
+                {
+                    logging::GALogger::w("Event sampling: rules must be a json object");
+                    return false;
+                }
+
+                if(source == ERuleSource::Remote)
+                {
+                    _remoteRules    = std::move(ruleSet);
+                    _hasRemoteRules = true;
+                }
+                else
+                {
+                    _localRules = std::move(ruleSet);
+                }
+
+                // limits may have changed, start with full buckets again
+                _buckets.clear();
+                return true;
+            }
+            catch(json::exception const& e)
+            {
+                logging::GALogger::e("Event sampling: failed to parse rules: %s", e.what());
+            }
+
+            return false;
+        }
+
+        void GAEventSampler::clearRules(ERuleSource source)
+        {
+            if(source == ERuleSource::Remote)
+            {
+                _remoteRules    = {};
+                _hasRemoteRules = false;
+            }
+            else
+            {
+                _localRules = {};
+            }
+
+            _buckets.clear();
+        }
+
+        const GAEventSampler::Rule* GAEventSampler::findRule(RuleSet const& rules, std::string_view category, std::string_view eventId, std::string& bucketKey) const
+        {
+            if(!eventId.empty())
+            {
+                for(auto const& prefix : rules.prefixes)
+                {
+                    if(eventId.compare(0, prefix.first.size(), prefix.first) == 0)
+                    {
+                        bucketKey = "prefix:" + prefix.first;
+                        return &prefix.second;
+                    }
+                }
+            }
+
+            auto it = rules.categories.find(std::string(category));
+            if(it != rules.categories.end())
+            {
+                bucketKey = "category:" + it->first;
+                return &it->second;
+            }
+
+            return nullptr;
+        }
+
+        bool GAEventSampler::takeToken(std::string const& bucketKey, Rule const& rule, Clock::time_point now)
+        {
+            Bucket& bucket = _buckets[bucketKey];
+
+            if(!bucket.initialized)
+            {
+                bucket.tokens      = rule.burst;
+                bucket.lastRefill  = now;
+                bucket.initialized = true;
+            }
+            else if(now > bucket.lastRefill)
+            {
+                const double elapsed = std::chrono::duration<double>(now - bucket.lastRefill).count();
+                bucket.tokens     = std::min(rule.burst, bucket.tokens + elapsed * rule.ratePerSecond);
+                bucket.lastRefill = now;
+            }
+
+            if(bucket.tokens < 1.0)
+            {
+                return false;
+            }
+
+            bucket.tokens -= 1.0;
+            return true;
+        }
+
+        GAEventSampler::Decision GAEventSampler::admit(std::string_view category, std::string_view eventId, Clock::time_point now)
+        {
+            Decision decision;
+
+            if(isExempt(category))
+            {
+                return decision;
+            }
+
+            std::string bucketKey;
+            const Rule* rule = _hasRemoteRules ? findRule(_remoteRules, category, eventId, bucketKey) : nullptr;
+            if(!rule)
+            {
+                rule = findRule(_localRules, category, eventId, bucketKey);
+            }
+
+            if(!rule)
+            {
+                return decision;
+            }
+
+            if(rule->sampleRate < 1.0 && _distribution(_rng) >= rule->sampleRate)
+            {
+                decision.accepted = false;
+                _rejectedBySampling++;
+                _rejectedCounts[std::string(category)]++;
+                return decision;
+            }
+
+            if(rule->ratePerSecond > 0.0 && !takeToken(bucketKey, *rule, now))
+            {
+                decision.accepted = false;
+                _rejectedByRateLimit++;
+                _rejectedCounts[std::string(category)]++;
+                return decision;
+            }
+
+            decision.sampleRate = rule->sampleRate;
+            return decision;
+        }
+
+        int64_t GAEventSampler::getRejectedBySampling() const
+        {
+            return _rejectedBySampling;
+        }
+
+        int64_t GAEventSampler::getRejectedByRateLimit() const
+        {
+            return _rejectedByRateLimit;
+        }
+
+        std::unordered_map<std::string, int64_t> GAEventSampler::takeRejectedCounts()
+        {
+            std::unordered_map<std::string, int64_t> counts;
+            counts.swap(_rejectedCounts);
+            return counts;
+        }
+    }
+}
@@ -0,0 +1,100 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <string_view>
+
+namespace gameanalytics
+{
+    namespace events
+    {
+        // Probabilistic sampling and token bucket rate limiting per category and per event id prefix.
+        // Rules come from the local configuration and from remote configs, remote rules win.
+        // Only touched from the GA thread.
+        class GAEventSampler
+        {
+            public:
+
+                using Clock = std::chrono::steady_clock;
+
+                struct Rule
+                {
+                    double sampleRate    = 1.0;   // probability to keep an event, [0, 1]
+                    double ratePerSecond = 0.0;   // token refill rate, 0 disables rate limiting
+                    double burst         = 0.0;   // bucket capacity, defaults to ratePerSecond
+                };
+
+                struct Decision
+                {
+                    bool   accepted   = true;
+                    double sampleRate = 1.0;
+                };
+
+                enum class ERuleSource
+                {
+                    Local,
+                    Remote
+                };
+
+                // {"categories": {"error": {"sample_rate": 0.1, "rate_per_second": 5, "burst": 20}}, "prefixes": {"Combat:": {...}}}
+                static constexpr const char* RemoteConfigKey = "ga_event_sampling";
+
+                explicit GAEventSampler(uint32_t seed = std::random_device{}());
+
+                bool setRules(json const& rules, ERuleSource source);
+                void clearRules(ERuleSource source);
+
+                Decision admit(std::string_view category, std::string_view eventId, Clock::time_point now = Clock::now());
+
+                int64_t getRejectedBySampling() const;
+                int64_t getRejectedByRateLimit() const;
+
+                // rejected events per category since the last call
+                std::unordered_map<std::string, int64_t> takeRejectedCounts();
+
+                static bool isExempt(std::string_view category);
+
+            private:
+
+                struct RuleSet
+                {
+                    std::unordered_map<std::string, Rule>     categories;
+                    std::vector<std::pair<std::string, Rule>> prefixes;   // longest prefix first
+                };
+
+                struct Bucket
+                {
+                    double            tokens = 0.0;
+                    Clock::time_point lastRefill;
+                    bool              initialized = false;
+                };
+
+                static bool parseRule(json const& node, Rule& out);
+                static bool parseRuleSet(json const& rules, RuleSet& out);
+
+                const Rule* findRule(RuleSet const& rules, std::string_view category, std::string_view eventId, std::string& bucketKey) const;
+                bool takeToken(std::string const& bucketKey, Rule const& rule, Clock::time_point now);
+
+                RuleSet _localRules;
+                RuleSet _remoteRules;
+                bool    _hasRemoteRules = false;
+
+                std::unordered_map<std::string, Bucket>  _buckets;
+                std::unordered_map<std::string, int64_t> _rejectedCounts;
+
+                int64_t _rejectedBySampling  = 0;
+                int64_t _rejectedByRateLimit = 0;
+
+                std::mt19937                           _rng;
+                std::uniform_real_distribution<double> _distribution{0.0, 1.0};
+        };
+    }
+}
@@ -12,6 +12,7 @@
 #include "GADevice.h"
 #include "GAThreading.h"
 #include "GAValidator.h"
+#include "GAPattern.h"
 #include <string.h>
 #include <stdio.h>
 #include <cmath>
@@ -57,6 +58,21 @@ namespace gameanalytics
                     }
                 );
             }
+
+            if (!getInstance().isHeartbeatScheduled)
+            {
+                getInstance().isHeartbeatScheduled = true;
+                threading::GAThreading::scheduleTimer(GAEvents::HEARTBEAT_CHECK_INTERVAL,
+                    []()
+                    {
+                        GAEvents& instance = getInstance();
+                        if(instance.keepRunning && isSessionHeartbeatDue(std::chrono::steady_clock::now()))
+                        {
+                            instance.updateSessionTime();
+                        }
+                    }
+                );
+            }
         }
  
         // USER EVENTS
@@ -69,6 +85,10 @@ namespace gameanalytics
                     return;
                 }
 
+                // players of a GAContext are counted in memory, they share the queue and
+                // have no session of their own to recover
+                const bool isPlayer = state::GAState::getActivePlayer() != nullptr;
+
                 // Increment session number  and persist
                 state::GAState::incrementSessionNum();
                 int64_t sessionNum = state::GAState::getSessionNum();
@@ -79,8 +99,11 @@ namespace gameanalytics
                 eventDict["category"]       = CategorySessionStart;
                 eventDict["session_num"]    = sessionNum;
 
-                StringVector parameters = {"session_num", std::to_string(sessionNum)};
-                store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_state (key, value) VALUES(?, ?);", parameters);
+                if (!isPlayer)
+                {
+                    StringVector parameters = {"session_num", std::to_string(sessionNum)};
+                    store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_state (key, value) VALUES(?, ?);", parameters);
+                }
 
                 // Add custom dimensions
                 getInstance().addDimensionsToEvent(eventDict);
@@ -92,6 +115,15 @@ namespace gameanalytics
                 // Add to store
                 getInstance().addEventToStore(eventDict);
 
+                if (isPlayer)
+                {
+                    logging::GALogger::i("Add SESSION START event for player: %s", state::GAState::getUserId().c_str());
+                    return;
+                }
+
+                // Record the session right away so it can be recovered
+                getInstance().updateSessionTime();
+
                 // Log
                 logging::GALogger::i("Add SESSION START event");
 
@@ -116,8 +148,10 @@ namespace gameanalytics
             
             try
             {
+                state::PlayerState* player = state::GAState::getActivePlayer();
+
                 // get session length in seconds
-                int64_t sessionLength  = state.calculateSessionLength<std::chrono::seconds>();
+                int64_t sessionLength  = player ? player->sessionLength() : state.calculateSessionLength<std::chrono::seconds>();
 
                 if(sessionLength < 0ll)
                 {
@@ -127,24 +161,33 @@ namespace gameanalytics
                     sessionLength = 0ll;
                 }
 
-                // Event specific data
-                json eventDict;
-                eventDict["category"]   = GAEvents::CategorySessionEnd;
-                eventDict["length"]     = sessionLength;
+                // Event specific data, strings and custom fields of the record are released with the arena scope
+                utilities::GAArena::Scope arenaScope;
+                SessionEndEventRecord record;
+                record.length = sessionLength;
 
                 // Add custom dimensions
-                getInstance().addDimensionsToEvent(eventDict);
-
-                json cleanedFields = state::GAState::getValidatedCustomFields();
+                getInstance().addDimensionsToRecord(record);
 
-                getInstance().addCustomFieldsToEvent(eventDict, cleanedFields);
+                getInstance().addCustomFieldsToRecord(record, json());
 
                 // Add to store
-                getInstance().addEventToStore(eventDict);
+                getInstance().addEventToStore(record);
+
+                // sent with the next batch, thousands of players must not flush the queue each
+                if (player)
+                {
+                    logging::GALogger::i("Add SESSION END event for player: %s", player->userId.c_str());
+                    return;
+                }
 
                 // Log
                 logging::GALogger::i("Add SESSION END event.");
 
+                const validators::GAValidatedIdCache::Stats idCache = validators::GAValidator::getValidatedIdCacheStats();
+                GA_LOG_DEBUG("Validated event id cache: %zu ids, %llu hits, %llu misses (%.1f%% hit rate)",
+                    idCache.size, static_cast<unsigned long long>(idCache.hits), static_cast<unsigned long long>(idCache.misses), idCache.hitRate() * 100.0);
+
                 // Send all event right away
                 GAEvents::processEvents("", false);
             }
@@ -174,37 +217,37 @@ namespace gameanalytics
                     return;
                 }
 
-                // Create empty eventData
-                json eventDict;
-
                 // Increment transaction number and persist
                 state::GAState::incrementTransactionNum();
 
                 const int64_t transactionNum = state::GAState::getTransactionNum();
 
-                StringVector params = {"transaction_num", std::to_string(transactionNum)};
-                store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_state (key, value) VALUES(?, ?);", params);
-
-                eventDict["category"] = GAEvents::CategoryBusiness;
-                eventDict["event_id"] = itemType + ':' + itemId;
-                eventDict["currency"] = currency;
-                eventDict["amount"]   = amount;
-                eventDict["transaction_num"] = transactionNum;
+                if (!state::GAState::getActivePlayer())
+                {
+                    StringVector params = {"transaction_num", std::to_string(transactionNum)};
+                    store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_state (key, value) VALUES(?, ?);", params);
+                }
 
-                utilities::addIfNotEmpty(eventDict, "cart_type", cartType);
+                utilities::GAArena::Scope arenaScope;
+                BusinessEventRecord record;
+                record.itemType       = itemType;
+                record.itemId         = itemId;
+                record.currency       = currency;
+                record.cartType       = cartType;
+                record.amount         = amount;
+                record.transactionNum = transactionNum;
 
                 // Add custom dimensions
-                getInstance().addDimensionsToEvent(eventDict);
+                getInstance().addDimensionsToRecord(record);
 
-                json cleanedFields = state::GAState::getValidatedCustomFields(fields);
-                getInstance().addCustomFieldsToEvent(eventDict, cleanedFields);
+                getInstance().addCustomFieldsToRecord(record, fields);
 
                 // Log
-                logging::GALogger::i("Add BUSINESS event: {currency:%s, amount:%d, itemType:%s, itemId:%s, cartType:%s, fields:%s}",
-                    currency.c_str(), amount, itemType.c_str(), itemId.c_str(), cartType.c_str(), cleanedFields.dump(JSON_PRINT_INDENT).c_str());
+                GA_LOG_INFO("Add BUSINESS event: {currency:%s, amount:%d, itemType:%s, itemId:%s, cartType:%s, fields:%s}",
+                    currency.c_str(), amount, itemType.c_str(), itemId.c_str(), cartType.c_str(), record.customFieldsString().c_str());
 
                 // Send to store
-                getInstance().addEventToStore(eventDict);
+                getInstance().addEventToStore(record);
             } 
             catch (std::exception const& e)
             {
@@ -238,28 +281,26 @@ namespace gameanalytics
                     amount *= -1;
                 }
 
-                // Create empty eventData
-                json eventDict;
-                
-                const std::string flowStr = resourceFlowTypeString(flowType);
-
                 // insert event specific values
-                eventDict["event_id"] = flowStr + ':' + currency + ':' + itemType + ':' + itemId;
-                eventDict["category"] = GAEvents::CategoryResource;
-                eventDict["amount"]   = amount;
+                utilities::GAArena::Scope arenaScope;
+                ResourceEventRecord record;
+                record.flowType = resourceFlowTypeString(flowType);
+                record.currency = currency;
+                record.itemType = itemType;
+                record.itemId   = itemId;
+                record.amount   = amount;
 
                 // Add custom dimensions
-                getInstance().addDimensionsToEvent(eventDict);
+                getInstance().addDimensionsToRecord(record);
 
-                json cleanedFields = state::GAState::getValidatedCustomFields(fields);
-                getInstance().addCustomFieldsToEvent(eventDict, cleanedFields);
+                getInstance().addCustomFieldsToRecord(record, fields);
 
                 // Log
-                logging::GALogger::i("Add RESOURCE event: {currency:%s, amount: %f, itemType:%s, itemId:%s, fields:%s}", 
-                    currency.c_str(), amount, itemType.c_str(), itemId.c_str(), cleanedFields.dump(JSON_PRINT_INDENT).c_str());
+                GA_LOG_INFO("Add RESOURCE event: {currency:%s, amount: %f, itemType:%s, itemId:%s, fields:%s}", 
+                    currency.c_str(), amount, itemType.c_str(), itemId.c_str(), record.customFieldsString().c_str());
 
                 // Send to store
-                getInstance().addEventToStore(eventDict);
+                getInstance().addEventToStore(record);
             }
             catch(const json::exception& e)
             {
@@ -291,9 +332,6 @@ namespace gameanalytics
                     return;
                 }
 
-                // Create empty eventData
-                json eventDict;
-
                 // Progression identifier
                 std::string progressionIdentifier = progression01;
 
@@ -311,8 +349,10 @@ namespace gameanalytics
 
                 const std::string statusString = progressionStatusString(progressionStatus);
 
-                eventDict["category"] = GAEvents::CategoryProgression;
-                eventDict["event_id"] = statusString + ':' + progressionIdentifier;
+                utilities::GAArena::Scope arenaScope;
+                ProgressionEventRecord record;
+                record.status      = statusString;
+                record.progression = progressionIdentifier;
 
                 // Attempt
                 int attempt_num = 0;
@@ -320,7 +360,8 @@ namespace gameanalytics
                 // Add score if specified and status is not start
                 if (sendScore && progressionStatus != EGAProgressionStatus::Start)
                 {
-                    eventDict["score"] = score;
+                    record.hasScore = true;
+                    record.score    = score;
                 }
 
                 // Count attempts on each progression fail and persist
@@ -338,25 +379,24 @@ namespace gameanalytics
 
                     // Add to event
                     attempt_num = state::GAState::getProgressionTries(progressionIdentifier);
-                    eventDict["attempt_num"] = attempt_num;
+                    record.hasAttempt = true;
+                    record.attemptNum = attempt_num;
 
                     // Clear
                     state::GAState::clearProgressionTries(progressionIdentifier);
                 }
 
                 // Add custom dimensions
-                getInstance().addDimensionsToEvent(eventDict);
-
-                json cleanedFields = state::GAState::getValidatedCustomFields(fields);
+                getInstance().addDimensionsToRecord(record);
 
-                getInstance().addCustomFieldsToEvent(eventDict, cleanedFields);
+                getInstance().addCustomFieldsToRecord(record, fields);
 
                 // Log
-                logging::GALogger::i("Add PROGRESSION event: {status:%s, progression01:%s, progression02:%s, progression03:%s, score:%d, attempt:%d, fields:%s}", 
-                    statusString.c_str(), progression01.c_str(), progression02.c_str(), progression03.c_str(), score, attempt_num, cleanedFields.dump(JSON_PRINT_INDENT).c_str());
+                GA_LOG_INFO("Add PROGRESSION event: {status:%s, progression01:%s, progression02:%s, progression03:%s, score:%d, attempt:%d, fields:%s}", 
+                    statusString.c_str(), progression01.c_str(), progression02.c_str(), progression03.c_str(), score, attempt_num, record.customFieldsString().c_str());
 
                 // Send to store
-                getInstance().addEventToStore(eventDict);
+                getInstance().addEventToStore(record);
             }
             catch(std::exception& e)
             {
@@ -383,29 +423,34 @@ namespace gameanalytics
                     return;
                 }
 
-                // Create empty eventData
-                json eventData;
-                eventData["category"] = GAEvents::CategoryDesign;
-                eventData["event_id"] = eventId;
-
-                if (sendValue)
+                // Collapse into the current aggregation window, custom fields would make every event unique.
+                // The summaries are sent for the default user, so events of GAContext players are not aggregated
+                GAEventAggregator& aggregator = getInstance().designAggregator;
+                if (sendValue && aggregator.isEnabled() && fields.empty() && !state::GAState::getActivePlayer())
                 {
-                    eventData["value"] = value;
+                    aggregator.add(eventId, {state::GAState::getCurrentCustomDimension01(), state::GAState::getCurrentCustomDimension02(), state::GAState::getCurrentCustomDimension03()}, value);
+
+                    logging::GALogger::v("Aggregated DESIGN event: {eventId:%s, value:%f}", eventId.c_str(), value);
+                    return;
                 }
 
-                json cleanedFields = state::GAState::getValidatedCustomFields(fields);
+                utilities::GAArena::Scope arenaScope;
+                DesignEventRecord record;
+                record.id       = eventId;
+                record.hasValue = sendValue;
+                record.value    = value;
 
-                GAEvents::getInstance().addCustomFieldsToEvent(eventData, cleanedFields);
+                getInstance().addCustomFieldsToRecord(record, fields);
 
                 // Add custom dimensions
-                getInstance().addDimensionsToEvent(eventData);
+                getInstance().addDimensionsToRecord(record);
 
                 // Log
-                logging::GALogger::i("Add DESIGN event: {eventId:%s, value:%f, fields:%s}", 
-                    eventId.c_str(), value, cleanedFields.dump(JSON_PRINT_INDENT).c_str());
+                GA_LOG_INFO("Add DESIGN event: {eventId:%s, value:%f, fields:%s}", 
+                    eventId.c_str(), value, record.customFieldsString().c_str());
 
                 // Send to store
-                getInstance().addEventToStore(eventData);
+                getInstance().addEventToStore(record);
             }
             catch(json::exception const& e)
             {
@@ -436,37 +481,32 @@ namespace gameanalytics
                     return;
                 }
 
-                // Create empty eventData
-                json eventData;
-                eventData["category"] = GAEvents::CategoryError;
-                eventData["severity"] = errorSeverityString(severity);
-                eventData["message"]  = message;
+                utilities::GAArena::Scope arenaScope;
+                ErrorEventRecord record;
+                record.severity = errorSeverityString(severity);
+                record.message  = message;
 
                 constexpr int MAX_FUNCTION_LEN = 256;
                 if(!function.empty())
                 {
-                    eventData["function_name"] = utilities::trimString(function, MAX_FUNCTION_LEN);
-
-                    if(line >= 0)
-                        eventData["line_number"] = line;
+                    record.functionName = utilities::trimString(function, MAX_FUNCTION_LEN);
+                    record.lineNumber   = line;
                 }
 
-                json cleanedFields;
                 if(!skipAddingFields)
                 {
-                    cleanedFields = state::GAState::getValidatedCustomFields(fields);
-                    getInstance().addCustomFieldsToEvent(eventData, cleanedFields);
+                    getInstance().addCustomFieldsToRecord(record, fields);
                 }
 
                 // Add custom dimensions
-                getInstance().addDimensionsToEvent(eventData);
+                getInstance().addDimensionsToRecord(record);
 
                 // Log
-                logging::GALogger::i("Add ERROR event: {severity:%s, message:%s, fields:%s}", 
-                    errorSeverityString(severity).c_str(), message.c_str(), cleanedFields.dump(JSON_PRINT_INDENT).c_str());
+                GA_LOG_INFO("Add ERROR event: {severity:%s, message:%s, fields:%s}", 
+                    record.severity.c_str(), message.c_str(), record.customFieldsString().c_str());
 
                 // Send to store
-                getInstance().addEventToStore(eventData);
+                getInstance().addEventToStore(record);
             }
             catch(std::exception& e)
             {
@@ -474,8 +514,160 @@ namespace gameanalytics
             }
         }
 
+        void GAEvents::configureDesignEventAggregation(bool enabled, std::chrono::seconds window, std::vector<double> const& histogramBounds)
+        {
+            GAEvents& instance = getInstance();
+
+            // don't lose what was collected with the previous settings, summaries can't change their
+            // window or histogram buckets halfway
+            GAEventAggregator const& aggregator = instance.designAggregator;
+            if (!enabled || window != aggregator.getWindow() ||
+                GAEventAggregator::normalizeHistogramBounds(histogramBounds) != aggregator.getHistogramBounds())
+            {
+                flushAggregatedDesignEvents();
+            }
+
+            instance.designAggregator.configure(enabled, window, histogramBounds);
+
+            if (enabled && !instance.isAggregationScheduled)
+            {
+                instance.isAggregationScheduled = true;
+                threading::GAThreading::scheduleTimer(GAEvents::AGGREGATION_CHECK_INTERVAL,
+                    []()
+                    {
+                        GAEventAggregator& aggregator = getInstance().designAggregator;
+                        if (aggregator.isEnabled() && aggregator.isWindowElapsed(std::chrono::steady_clock::now()))
+                        {
+                            flushAggregatedDesignEvents();
+                        }
+                    }
+                );
+            }
+
+            logging::GALogger::i("Design event aggregation %s (window: %llds, histogram buckets: %d)",
+                enabled ? "enabled" : "disabled", static_cast<long long>(window.count()), static_cast<int>(histogramBounds.size()));
+        }
+
+        void GAEvents::flushAggregatedDesignEvents()
+        {
+            getInstance().designAggregator.flush(
+                [](GAEventAggregator::Summary const& summary)
+                {
+                    getInstance().addAggregatedDesignEvent(summary);
+                }
+            );
+        }
+
+        void GAEvents::addAggregatedDesignEvent(GAEventAggregator::Summary const& summary)
+        {
+            try
+            {
+                if(!state::GAState::isEventSubmissionEnabled())
+                {
+                    return;
+                }
+
+                utilities::GAArena::Scope arenaScope;
+                DesignEventRecord record;
+                record.id       = summary.eventId;
+                record.hasValue = true;
+                record.value    = summary.sum;
+
+                // use the dimensions that were active when the values were recorded
+                std::copy(summary.dimensions.begin(), summary.dimensions.end(), record.dimensions.begin());
+
+                std::vector<double> const& bounds = designAggregator.getHistogramBounds();
+                const bool hasHistogram = !summary.histogram.empty() && summary.histogram.size() == bounds.size() + 1;
+
+                EventJson& cleanedFields = record.customFields;
+                state::GAState::getValidatedCustomFields(json(), cleanedFields);
+                if (!cleanedFields.is_object())
+                {
+                    cleanedFields = EventJson::object();
+                }
+
+                // the agg_* fields count towards the custom fields limit, make room for them
+                const std::size_t aggFieldsCount = hasHistogram ? 6 : 4;
+                const std::size_t maxGlobalFields = static_cast<std::size_t>(MAX_CUSTOM_FIELDS_COUNT) - aggFieldsCount;
+                if (cleanedFields.size() > maxGlobalFields)
+                {
+                    auto itr = cleanedFields.begin();
+                    std::advance(itr, maxGlobalFields);
+
+                    while (itr != cleanedFields.end())
+                    {
+                        logging::GALogger::w("addAggregatedDesignEvent: custom field %s has been omitted to make room for the aggregation fields", std::string(itr.key()).c_str());
+                        itr = cleanedFields.erase(itr);
+                    }
+                }
+
+                cleanedFields["agg_count"] = summary.count;
+                cleanedFields["agg_sum"]   = summary.sum;
+                cleanedFields["agg_min"]   = summary.min;
+                cleanedFields["agg_max"]   = summary.max;
+
+                if (hasHistogram)
+                {
+                    std::string boundsString;
+                    std::string countsString;
+
+                    for (std::size_t i = 0; i < summary.histogram.size(); ++i)
+                    {
+                        if (i < bounds.size())
+                        {
+                            if (!boundsString.empty())
+                                boundsString += ',';
+                            boundsString += utilities::printString("%g", bounds[i]);
+                        }
+
+                        if (i > 0)
+                            countsString += ',';
+                        countsString += std::to_string(summary.histogram[i]);
+                    }
+
+                    cleanedFields["agg_hist_bounds"] = boundsString;
+                    cleanedFields["agg_hist_counts"] = countsString;
+                }
+
+                logging::GALogger::i("Add aggregated DESIGN event: {eventId:%s, count:%lld, sum:%f, min:%f, max:%f}",
+                    summary.eventId.c_str(), static_cast<long long>(summary.count), summary.sum, summary.min, summary.max);
+
+                addEventToStore(record);
+            }
+            catch(json::exception const& e)
+            {
+                logging::GALogger::e("addAggregatedDesignEvent - Failed to parse json: %s", e.what());
+            }
+            catch(std::exception const& e)
+            {
+                logging::GALogger::e("addAggregatedDesignEvent - Exception thrown: %s", e.what());
+            }
+        }
+
+        void GAEvents::setEventSamplingRules(json const& rules, GAEventSampler::ERuleSource source)
+        {
+            if (getInstance().eventSampler.setRules(rules, source))
+            {
+                logging::GALogger::i("Event sampling rules updated from %s configuration", source == GAEventSampler::ERuleSource::Remote ? "remote" : "local");
+            }
+        }
+
+        void GAEvents::clearEventSamplingRules(GAEventSampler::ERuleSource source)
+        {
+            getInstance().eventSampler.clearRules(source);
+        }
+
+        void GAEvents::logRejectedEvents()
+        {
+            for (auto const& entry : eventSampler.takeRejectedCounts())
+            {
+                logging::GALogger::w("Event sampling: dropped %lld %s event(s)", static_cast<long long>(entry.second), entry.first.c_str());
+            }
+        }
+
         void GAEvents::processEventQueue()
         {
+            logRejectedEvents();
             processEvents("", true);
 
             if (!getInstance().keepRunning)
@@ -491,6 +683,9 @@ namespace gameanalytics
                 return;
             }
 
+            // sdk errors collected since the last run go out as one request
+            http::GAHTTPApi::getInstance().sendPendingSdkErrors();
+
             // Request identifier
             std::string requestIdentifier = utilities::GAUtilities::generateUUID();
 
@@ -516,7 +711,6 @@ namespace gameanalytics
             if (events.is_null() || events.size() == 0)
             {
                 logging::GALogger::i("Event queue: No events to send");
-                getInstance().updateSessionTime();
                 return;
             }
 
@@ -560,11 +754,14 @@ namespace gameanalytics
 
             // Create payload data from events
             json payloadArray;
+            std::size_t payloadSize = 2;
             for (auto& node : events)
             {
                 const std::string eventDict = utilities::getOptionalValue<std::string>(node, "event");
                 if (!eventDict.empty())
                 {
+                    payloadSize += eventDict.size() + 1;
+
                     try
                     {
                         json d = json::parse(eventDict);
@@ -581,7 +778,7 @@ namespace gameanalytics
                     catch(const json::exception& e)
                     {
                         logging::GALogger::d("processEvents -- JSON error: %s", e.what());
-                        logging::GALogger::d(eventDict.c_str());
+                        logging::GALogger::d("%s", eventDict.c_str());
                     }
                 }
             }
@@ -618,7 +815,7 @@ namespace gameanalytics
                 }
             }
 #else
-            responseEnum = http.sendEventsInArray(dataDict, payloadArray);
+            responseEnum = http.sendEventsInArray(dataDict, payloadArray, payloadSize);
 #endif
 
             if (responseEnum == http::Ok || responseEnum == http::NoContent)
@@ -653,28 +850,72 @@ namespace gameanalytics
             }
         }
 
+        void GAEvents::setSessionHeartbeatInterval(std::chrono::seconds interval)
+        {
+            getInstance().sessionHeartbeatInterval = std::max(interval, std::chrono::seconds(1));
+            logging::GALogger::i("Session heartbeat interval set to %llds", static_cast<long long>(getInstance().sessionHeartbeatInterval.count()));
+        }
+
+        std::chrono::seconds GAEvents::getSessionHeartbeatInterval()
+        {
+            return getInstance().sessionHeartbeatInterval;
+        }
+
+        bool GAEvents::isSessionHeartbeatDue(std::chrono::steady_clock::time_point now)
+        {
+            GAEvents const& instance = getInstance();
+            return now - instance.lastSessionHeartbeat >= instance.sessionHeartbeatInterval;
+        }
+
+        void GAEvents::writeSessionHeartbeat()
+        {
+            getInstance().updateSessionTime();
+        }
+
+        void GAEvents::invalidateSessionSnapshot()
+        {
+            getInstance().sessionSnapshot = json();
+        }
+
         void GAEvents::updateSessionTime()
         {
             if(state::GAState::sessionIsStarted())
             {
                 try
                 {
-                    json ev;
-                    state::GAState::getEventAnnotations(ev);
+                    lastSessionHeartbeat = std::chrono::steady_clock::now();
+
+                    // annotations, dimensions and global fields only change on session start, when set
+                    // or when new configs arrive, so the snapshot is built once and only the fields that
+                    // move between heartbeats are refreshed
+                    state::GAState& state = state::GAState::getInstance();
+                    if(sessionSnapshot.is_null())
+                    {
+                        json ev;
+                        state::GAState::getEventAnnotations(ev);
 
-                    // Add custom dimensions
-                    GAEvents::addDimensionsToEvent(ev);
+                        // Add custom dimensions
+                        GAEvents::addDimensionsToEvent(ev);
 
-                    json cleanedFields = state::GAState::getValidatedCustomFields();
-                    GAEvents::addCustomFieldsToEvent(ev, cleanedFields);
+                        json cleanedFields = state::GAState::getValidatedCustomFields();
+                        GAEvents::addCustomFieldsToEvent(ev, cleanedFields);
 
-                    std::string jsonDefaults = ev.dump();
+                        sessionSnapshot = std::move(ev);
+                    }
+                    else
+                    {
+                        sessionSnapshot["client_ts"]                = utilities::GAUtilities::timeIntervalSince1970();
+                        sessionSnapshot["connection_type"]          = device::GADevice::getConnectionType();
+                        sessionSnapshot["current_session_length"]   = state.calculateSessionLength();
+                        sessionSnapshot["lifetime_session_length"]  = state.getTotalSessionLength();
+                    }
+
+                    std::string jsonDefaults = sessionSnapshot.dump();
                     constexpr const char* sql = "INSERT OR REPLACE INTO ga_session(session_id, timestamp, event) VALUES(?, ?, ?);";
-                    state::GAState& state = state::GAState::getInstance();
 
                     const std::string sessionStart = std::to_string(state.getSessionStart());
                     
-                    const StringVector parameters = { ev["session_id"].get<std::string>(), sessionStart, jsonDefaults};
+                    const StringVector parameters = { sessionSnapshot["session_id"].get<std::string>(), sessionStart, jsonDefaults};
                     store::GAStore::executeQuerySync(sql, parameters);
                 }
                 catch(json::exception const& e)
@@ -741,7 +982,7 @@ namespace gameanalytics
                     catch(json::exception const& e)
                     {
                         logging::GALogger::d("fixMissingSessionEndEvents -- JSON error: %s", e.what());
-                        logging::GALogger::d("%s", session["event"].dump(JSON_PRINT_INDENT).c_str());
+                        GA_LOG_DEBUG("%s", session["event"].dump(JSON_PRINT_INDENT).c_str());
                     }
                     catch(std::exception const& e)
                     {
@@ -782,9 +1023,24 @@ namespace gameanalytics
 
             try
             {
+                // Shed load before anything is serialized or written
+                const std::string category = eventData["category"].get<std::string>();
+                const GAEventSampler::Decision decision = eventSampler.admit(category, utilities::getOptionalValue<std::string>(eventData, "event_id"));
+                if (!decision.accepted)
+                {
+                    logging::GALogger::v("Event dropped by sampling rules: %s", category.c_str());
+                    return;
+                }
+
+                if (decision.sampleRate < 1.0)
+                {
+                    // lets analysis reweight the sampled events
+                    addSampleRate(eventData["custom_fields"], decision.sampleRate);
+                }
+
                 // Check db size limits (10mb)
                 // If database is too large block all except user, session and business
-                if (store::GAStore::isDbTooLargeForEvents() && !utilities::GAUtilities::stringMatch(eventData["category"].get<std::string>(), "^(user|session_end|business)$"))
+                if (store::GAStore::isDbTooLargeForEvents() && !utilities::matchAnyOf(eventData["category"].get<std::string>(), {"user", "session_end", "business"}))
                 {
                     logging::GALogger::w("Database too large. Event has been blocked.");
                     http::GAHTTPApi& httpInstance = http::GAHTTPApi::getInstance();
@@ -796,7 +1052,7 @@ namespace gameanalytics
                 json ev;
                 state::GAState::getEventAnnotations(ev);
                 
-                logging::GALogger::i(ev.dump().c_str());
+                GA_LOG_INFO("%s", ev.dump().c_str());
                 
                 ev.merge_patch(eventData);
 
@@ -812,20 +1068,100 @@ namespace gameanalytics
 
                 store::GAStore::executeQuerySync(sql, parameters);
 
-                // Add to session store if not last
+                // Session is closed, the heartbeat is no longer needed
                 if (eventData["category"].get<std::string>() == GAEvents::CategorySessionEnd)
                 {
                     StringVector params = { ev["session_id"].get<std::string>() };
                     store::GAStore::executeQuerySync("DELETE FROM ga_session WHERE session_id = ?;", params);
                 }
-                else
+            }
+            catch(json::exception const& e)
+            {
+                logging::GALogger::e("Failed to parse json: %s", e.what());
+            }
+            catch(std::exception const& e)
+            {
+                logging::GALogger::e("Exception thrown: %s", e.what());
+            }
+        }
+
+        void GAEvents::addEventToStore(EventRecord const& record)
+        {
+            if(!state::GAState::isEventSubmissionEnabled())
+            {
+                return;
+            }
+
+            // Check if datastore is available
+            if (!store::GAStore::getTableReady())
+            {
+                logging::GALogger::w("Could not add event: SDK datastore error");
+                return;
+            }
+
+            // Check if we are initialized
+            if (!state::GAState::isInitialized())
+            {
+                logging::GALogger::w("Could not add event: SDK is not initialized");
+                return;
+            }
+
+            try
+            {
+                const std::string category = record.category();
+
+                // Shed load before anything is serialized or written
+                const GAEventSampler::Decision decision = eventSampler.admit(category, record.eventId());
+                if (!decision.accepted)
+                {
+                    logging::GALogger::v("Event dropped by sampling rules: %s", category.c_str());
+                    return;
+                }
+
+                // Check db size limits (10mb)
+                // If database is too large block all except user, session and business
+                if (store::GAStore::isDbTooLargeForEvents() && category != CategorySessionStart && category != CategorySessionEnd && category != CategoryBusiness)
+                {
+                    logging::GALogger::w("Database too large. Event has been blocked.");
+                    http::GAHTTPApi& httpInstance = http::GAHTTPApi::getInstance();
+                    httpInstance.sendSdkErrorEvent(http::EGASdkErrorCategory::Database, http::EGASdkErrorArea::AddEventsToStore, http::EGASdkErrorAction::DatabaseTooLarge, (http::EGASdkErrorParameter)0, "", state::GAState::getGameKey(), state::GAState::getGameSecret());
+                    return;
+                }
+
+                // Get default annotations
+                EventAnnotations annotations;
+                state::GAState::getEventAnnotations(annotations);
+
+                // serialize annotations and event values into one object, no intermediate json
+                eventWriter.reset();
+                eventWriter.beginObject();
+                annotations.write(eventWriter);
+                record.write(eventWriter, decision.sampleRate);
+                eventWriter.endObject();
+
+                std::string const& jsonString = eventWriter.str();
+
+                // output if VERBOSE LOG enabled
+                logging::GALogger::v("Event added to queue: %s", jsonString.c_str());
+
+                // Add to store
+                const std::string sessionId(annotations.sessionId);
+
+                StringVector parameters = { "new", category, sessionId, std::to_string(annotations.clientTs), jsonString };
+                constexpr const char* sql = "INSERT INTO ga_events (status, category, session_id, client_ts, event) VALUES(?, ?, ?, ?, ?);";
+
+                store::GAStore::executeQuerySync(sql, parameters);
+
+                // Session is closed, the heartbeat is no longer needed
+                if (category == GAEvents::CategorySessionEnd)
                 {
-                    GAEvents::updateSessionTime();
+                    StringVector params = { sessionId };
+                    store::GAStore::executeQuerySync("DELETE FROM ga_session WHERE session_id = ?;", params);
                 }
             }
             catch(json::exception const& e)
             {
-                logging::GALogger::e("Failed to parse json: %s", e.what());
+                logging::GALogger::e("Failed to serialize event: %s", e.what());
             }
             catch(std::exception const& e)
             {
@@ -833,6 +1169,25 @@ namespace gameanalytics
             }
         }
 
+        void GAEvents::addDimensionsToRecord(EventRecord& record)
+        {
+            record.dimensions[0] = state::GAState::getCurrentCustomDimension01();
+            record.dimensions[1] = state::GAState::getCurrentCustomDimension02();
+            record.dimensions[2] = state::GAState::getCurrentCustomDimension03();
+        }
+
+        void GAEvents::addCustomFieldsToRecord(EventRecord& record, const json& fields)
+        {
+            if(fields.empty())
+            {
+                // nothing to validate or merge, the global fields are written as they were serialized
+                record.globalCustomFields = state::GAState::getGlobalCustomEventFieldsMembers();
+                return;
+            }
+
+            state::GAState::getValidatedCustomFields(fields, record.customFields);
+        }
+
         void GAEvents::addDimensionsToEvent(json& eventData)
         {
             if (eventData.is_null())
@@ -943,7 +1298,7 @@ namespace gameanalytics
                 getInstance().addDimensionsToEvent(eventDict);
 
                 // Log
-                logging::GALogger::i("Added sdk init event: %s", eventDict.dump().c_str());
+                GA_LOG_INFO("Added sdk init event: %s", eventDict.dump().c_str());
 
                 // Send to store
                 getInstance().addEventToStore(eventDict);
@@ -978,23 +1333,20 @@ namespace gameanalytics
                     return;
                 }
 
-                // Create empty eventData
-                json eventDict;
-                
-                // insert event specific values
-                eventDict["category"] = GAEvents::CategoryHealth;
+                utilities::GAArena::Scope arenaScope;
+                HealthEventRecord record;
 
-                healthTracker->addHealthAnnotations(eventDict);
-                healthTracker->addPerformanceData(eventDict);
+                healthTracker->addHealthAnnotations(record.health);
+                healthTracker->addPerformanceData(record.health);
 
                 // Add custom dimensions
-                getInstance().addDimensionsToEvent(eventDict);
+                getInstance().addDimensionsToRecord(record);
 
                 // Log
-                logging::GALogger::i("Added health event: %s", eventDict.dump().c_str());
+                GA_LOG_INFO("Added health event: %s", record.health.dump().c_str());
 
                 // Send to store
-                getInstance().addEventToStore(eventDict);
+                getInstance().addEventToStore(record);
             }
             catch(const json::exception& e)
             {
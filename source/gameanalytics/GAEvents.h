@@ -6,6 +6,10 @@
 #pragma once
 
 #include "GACommon.h"
+#include "GAEventAggregator.h"
+#include "GAEventSampler.h"
+#include "GAEventRecords.h"
+#include "GAJsonWriter.h"
 
 namespace gameanalytics
 {
@@ -30,6 +34,12 @@ namespace gameanalytics
 
             static void addSDKInitEvent();
             static void addHealthEvent();
+
+            static void configureDesignEventAggregation(bool enabled, std::chrono::seconds window, std::vector<double> const& histogramBounds);
+            static void flushAggregatedDesignEvents();
+
+            static void setEventSamplingRules(json const& rules, GAEventSampler::ERuleSource source);
+            static void clearEventSamplingRules(GAEventSampler::ERuleSource source);
             
             static std::string progressionStatusString(EGAProgressionStatus progressionStatus);
             static std::string errorSeverityString(EGAErrorSeverity errorSeverity);
@@ -37,6 +47,16 @@ namespace gameanalytics
 
             static void processEvents(std::string const& category, bool performCleanUp);
 
+            static void setSessionHeartbeatInterval(std::chrono::seconds interval);
+            static std::chrono::seconds getSessionHeartbeatInterval();
+            // true once the interval has passed since the session row was last written
+            static bool isSessionHeartbeatDue(std::chrono::steady_clock::time_point now);
+            static void writeSessionHeartbeat();
+            static void invalidateSessionSnapshot();
+
+            // adds a session_end event for every ga_session row left by an earlier session
+            void fixMissingSessionEndEvents();
+
             bool enableSDKInitEvent{false};
             bool enableHealthEvent{false};
 
@@ -54,6 +74,9 @@ namespace gameanalytics
             static constexpr int         MaxEventCount                  = 500;
 
             static constexpr std::chrono::milliseconds PROCESS_EVENTS_INTERVAL{8000};
+            static constexpr std::chrono::milliseconds AGGREGATION_CHECK_INTERVAL{1000};
+            static constexpr std::chrono::milliseconds HEARTBEAT_CHECK_INTERVAL{1000};
+            static constexpr std::chrono::seconds      DEFAULT_SESSION_HEARTBEAT_INTERVAL{10};
 
             GAEvents();
             ~GAEvents();
@@ -62,14 +85,32 @@ namespace gameanalytics
 
             void processEventQueue();
             void cleanupEvents();
-            void fixMissingSessionEndEvents();
             void addEventToStore(json& eventData);
+            void addEventToStore(EventRecord const& record);
             void addDimensionsToEvent(json& eventData);
+            void addDimensionsToRecord(EventRecord& record);
             void addCustomFieldsToEvent(json& eventData, json& fields);
+            void addCustomFieldsToRecord(EventRecord& record, const json& fields);
             void updateSessionTime();
+            void addAggregatedDesignEvent(GAEventAggregator::Summary const& summary);
+            void logRejectedEvents();
 
             bool isRunning  {false};
             bool keepRunning{false};
+
+            // ga_session row used to recover a missing session_end, written at most every interval
+            json                                  sessionSnapshot;
+            std::chrono::seconds                  sessionHeartbeatInterval{DEFAULT_SESSION_HEARTBEAT_INTERVAL};
+            std::chrono::steady_clock::time_point lastSessionHeartbeat;
+            bool                                  isHeartbeatScheduled{false};
+
+            GAEventAggregator designAggregator;
+            bool              isAggregationScheduled{false};
+
+            GAEventSampler    eventSampler;
+
+            // reused for every event, only touched from the GA thread
+            utilities::GAJsonWriter eventWriter;
         };
     }
 }
@@ -9,6 +9,10 @@
 #include "GALogger.h"
 #include "GAUtilities.h"
 #include "GAValidator.h"
+#include "GAPayloadEncoder.h"
+#include "GAThreading.h"
+
+#include <algorithm>
 
 #ifdef GA_HTTP_CURL
     #include "Http/GAHttpCurl.h"
@@ -35,11 +39,13 @@ namespace gameanalytics
         constexpr int HTTP_RESPONSE_UNAUTHORIZED = 401;
         constexpr int HTTP_RESPONSE_INTERNAL_ERROR = 500;
 
+        // serialized json handed to the compressor at a time
+        constexpr std::size_t PAYLOAD_CHUNK_SIZE = 16 * 1024;
+
         // Constructor - setup the basic information for HTTP
         GAHTTPApi::GAHTTPApi()
         {
-            baseUrl              = protocol + "://" + hostName + "/" + version;
-            remoteConfigsBaseUrl = protocol + "://" + hostName + "/remote_configs/" + remoteConfigsVersion;
+            setCollectorHost(protocol, hostName);
 
             // use gzip compression on JSON body
 #if defined(_DEBUG)
@@ -62,9 +68,14 @@ namespace gameanalytics
             return state::GAState::getInstance()._gaHttp;
         }
         
-        void GAHTTPApi::setCustomHttpImpl(std::unique_ptr<GAHttpClient>&& customImpl)
+        std::unique_ptr<GAHttpClient> GAHTTPApi::setCustomHttpImpl(std::unique_ptr<GAHttpClient>&& customImpl)
         {
-            getInstance().impl = std::move(customImpl);
+            return std::exchange(getInstance().impl, std::move(customImpl));
+        }
+
+        GACompressionPolicy& GAHTTPApi::getCompressionPolicy()
+        {
+            return compression;
         }
 
         void GAHTTPApi::initializeClient()
@@ -78,6 +89,53 @@ namespace gameanalytics
             }
 
             impl->initialize();
+
+            if(warmUpEnabled)
+            {
+                warmUpConnection();
+
+                if(!warmUpScheduled)
+                {
+                    warmUpScheduled = true;
+                    threading::GAThreading::scheduleTimer(std::chrono::seconds(warmUpInterval.load()), []()
+                    {
+                        // an idle connection is not worth keeping open while suspended
+                        if(state::GAState::sessionIsStarted())
+                        {
+                            getInstance().warmUpConnection();
+                        }
+                    });
+                }
+            }
+        }
+
+        void GAHTTPApi::setConnectionWarmUp(bool enabled, std::chrono::seconds interval)
+        {
+            warmUpEnabled  = enabled;
+            warmUpInterval = std::max<int64_t>(interval.count(), 1);
+        }
+
+        void GAHTTPApi::warmUpConnection()
+        {
+            if(!impl || !warmUpEnabled)
+            {
+                return;
+            }
+
+            // init and events share the host, so one connection serves both
+            const std::string url = protocol + "://" + hostName + "/";
+            logging::GALogger::d("Warming up connection to %s", url.c_str());
+
+            impl->warmUp(url, std::chrono::seconds(warmUpInterval.load()));
+        }
+
+        void GAHTTPApi::setCollectorHost(std::string const& protocol, std::string const& host)
+        {
+            this->protocol = protocol;
+            hostName       = host;
+
+            baseUrl              = protocol + "://" + hostName + "/" + version;
+            remoteConfigsBaseUrl = protocol + "://" + hostName + "/remote_configs/" + remoteConfigsVersion;
         }
 
         EGAHTTPApiResponse GAHTTPApi::requestInitReturningDict(json& json_out, std::string const& configsHash)
@@ -88,101 +146,172 @@ namespace gameanalytics
                 return SdkError;
             }
 
-            std::string gameKey = state::GAState::getGameKey();
+            try
+            {
+                InitRequest request;
+                EGAHTTPApiResponse result = prepareInitRequest(configsHash, request);
+                if (result != Ok)
+                {
+                    return result;
+                }
 
-            // Generate URL
-            std::string url = remoteConfigsBaseUrl + "/" + initializeUrlPath + "?game_key=" + gameKey + "&interval_seconds=0&configs_hash=" + configsHash + "&config_vsn_supported=3";
+                GAHttpClient::Response& response = responseBuffer;
+                post(request.url, request.auth, request.payload, request.gzip, response);
 
-            logging::GALogger::d("Sending 'init' URL: %s", url.c_str());
+                return processInitResponse(request, response, json_out);
+            }
+            catch (json::exception& e)
+            {
+                logging::GALogger::e("Failed to parse json: %s", e.what());
+                return InternalError;
+            }
+            catch (std::exception& e)
+            {
+                logging::GALogger::e("Exception thrown: %s", e.what());
+                return InternalError;
+            }
+        }
+
+        void GAHTTPApi::requestInitAsync(std::string const& configsHash, InitCallback callback)
+        {
+            if(!impl)
+            {
+                logging::GALogger::e("Invalid http implmentation");
+                callback(SdkError, json());
+                return;
+            }
 
-            json initAnnotations;
-            state::GAState::getInitAnnotations(initAnnotations);
-            
             try
             {
-                std::string jsonString = initAnnotations.dump();
-                if (jsonString.empty())
+                auto request = std::make_shared<InitRequest>();
+                EGAHTTPApiResponse result = prepareInitRequest(configsHash, *request);
+                if (result != Ok)
                 {
-                    return JsonEncodeFailed;
+                    callback(result, json());
+                    return;
                 }
 
-                std::vector<uint8_t> payloadData = createPayloadData(jsonString, useGzip);
+                const std::string auth = "Authorization: " + request->auth;
+
+                // the client may call back on its own thread, the response is handled on the GA thread
+                impl->sendRequestAsync(request->url, auth, request->payload, request->gzip, nullptr,
+                    [request, callback](GAHttpClient::Response response)
+                    {
+                        threading::GAThreading::performTaskOnGAThread(
+                            [request, callback, response = std::move(response)]()
+                            {
+                                json json_out;
+                                EGAHTTPApiResponse result = InternalError;
+
+                                try
+                                {
+                                    result = getInstance().processInitResponse(*request, response, json_out);
+                                }
+                                catch (json::exception& e)
+                                {
+                                    logging::GALogger::e("Failed to parse json: %s", e.what());
+                                }
+                                catch (std::exception& e)
+                                {
+                                    logging::GALogger::e("Exception thrown: %s", e.what());
+                                }
+
+                                callback(result, std::move(json_out));
+                            });
+                    });
+            }
+            catch (json::exception& e)
+            {
+                logging::GALogger::e("Failed to parse json: %s", e.what());
+                callback(InternalError, json());
+            }
+            catch (std::exception& e)
+            {
+                logging::GALogger::e("Exception thrown: %s", e.what());
+                callback(InternalError, json());
+            }
+        }
 
-                std::string const auth = createAuth(payloadData);
-                GAHttpClient::Response response = impl->sendRequest(url, auth, payloadData, useGzip, nullptr);
+        EGAHTTPApiResponse GAHTTPApi::prepareInitRequest(std::string const& configsHash, InitRequest& request)
+        {
+            std::string gameKey = state::GAState::getGameKey();
 
-                if(response.code < 0)
-                {
-                    logging::GALogger::e("Request failed: %s", url.c_str());
-                    return EGAHTTPApiResponse::NoResponse;
-                }
+            // Generate URL
+            request.url = remoteConfigsBaseUrl + "/" + initializeUrlPath + "?game_key=" + gameKey + "&interval_seconds=0&configs_hash=" + configsHash + "&config_vsn_supported=3";
 
-                std::string_view content = response.toString();
+            logging::GALogger::d("Sending 'init' URL: %s", request.url.c_str());
 
-                // process the response
-                logging::GALogger::d("init request content: %.*s, json: %s", (int)content.size(), content.data(), jsonString.c_str());
+            json initAnnotations;
+            state::GAState::getInitAnnotations(initAnnotations);
 
-                EGAHTTPApiResponse requestResponseEnum = processRequestResponse(response, "Init");
+            request.jsonString = initAnnotations.dump();
+            if (request.jsonString.empty())
+            {
+                return JsonEncodeFailed;
+            }
 
-                // if not 200 result
-                if (requestResponseEnum != Ok && requestResponseEnum != Created && requestResponseEnum != BadRequest)
-                {
-                    logging::GALogger::d("Failed Init Call. URL: %s, JSONString: %s, Authorization: %s", url.c_str(), jsonString.c_str(), auth.c_str());
+            request.gzip    = useGzip;
+            request.payload = createPayloadData(request.jsonString, request.gzip, request.auth);
+            if (request.payload.empty())
+            {
+                return JsonEncodeFailed;
+            }
 
-                    return requestResponseEnum;
-                }
+            return Ok;
+        }
 
-                json requestJsonDict = json::parse(content);
-                if (requestJsonDict.is_null())
-                {
-                    logging::GALogger::d("Failed Init Call. Json decoding failed");
-                    return JsonDecodeFailed;
-                }
+        EGAHTTPApiResponse GAHTTPApi::processInitResponse(InitRequest const& request, GAHttpClient::Response const& response, json& json_out)
+        {
+            if(response.code < 0)
+            {
+                logging::GALogger::e("Request failed: %s", request.url.c_str());
+                return EGAHTTPApiResponse::NoResponse;
+            }
 
-                // print reason if bad request
-                if (requestResponseEnum == BadRequest)
-                {
-                    logging::GALogger::d("Failed Init Call. Bad request. Response: %s", requestJsonDict.dump().c_str());
+            std::string_view content = response.toString();
 
-                    // return bad request result
-                    return requestResponseEnum;
-                }
+            // process the response
+            logging::GALogger::d("init request content: %.*s, json: %s", (int)content.size(), content.data(), request.jsonString.c_str());
 
-                // validate Init call values
-                validators::GAValidator::validateAndCleanInitRequestResponse(requestJsonDict, json_out, requestResponseEnum == Created);
+            EGAHTTPApiResponse requestResponseEnum = processRequestResponse(response, "Init");
 
-                if (json_out.is_null())
-                {
-                    return BadResponse;
-                }
+            // if not 200 result
+            if (requestResponseEnum != Ok && requestResponseEnum != Created && requestResponseEnum != BadRequest)
+            {
+                logging::GALogger::d("Failed Init Call. URL: %s, JSONString: %s, Authorization: %s", request.url.c_str(), request.jsonString.c_str(), request.auth.c_str());
 
-                // all ok
                 return requestResponseEnum;
             }
-            catch (json::exception& e)
+
+            json requestJsonDict = json::parse(content);
+            if (requestJsonDict.is_null())
             {
-                logging::GALogger::e("Failed to parse json: %s", e.what());
-                return InternalError;
+                logging::GALogger::d("Failed Init Call. Json decoding failed");
+                return JsonDecodeFailed;
             }
-            catch (std::exception& e)
+
+            // print reason if bad request
+            if (requestResponseEnum == BadRequest)
             {
-                logging::GALogger::e("Exception thrown: %s", e.what());
-                return InternalError;
+                GA_LOG_DEBUG("Failed Init Call. Bad request. Response: %s", requestJsonDict.dump().c_str());
+
+                // return bad request result
+                return requestResponseEnum;
             }
-        }
 
-        std::string GAHTTPApi::createAuth(std::vector<uint8_t> const& payloadData)
-        {        
-            const std::string key = state::GAState::getGameSecret();
+            // validate Init call values
+            validators::GAValidator::validateAndCleanInitRequestResponse(requestJsonDict, json_out, requestResponseEnum == Created);
 
-            std::vector<uint8_t> authorization;
-            utilities::GAUtilities::hmacWithKey(key.c_str(), payloadData, authorization);
-            std::string auth = "Authorization: " + std::string(reinterpret_cast<char*>(authorization.data()), authorization.size());
+            if (json_out.is_null())
+            {
+                return BadResponse;
+            }
 
-            return auth;
+            // all ok
+            return requestResponseEnum;
         }
 
-        EGAHTTPApiResponse GAHTTPApi::sendEventsInArray(json& json_out, const json& eventArray)
+        EGAHTTPApiResponse GAHTTPApi::sendEventsInArray(json& json_out, const json& eventArray, std::size_t sizeHint)
         {
             if(!impl)
             {
@@ -204,17 +333,48 @@ namespace gameanalytics
                 const std::string url = baseUrl + '/' + gameKey + '/' + eventsUrlPath;
                 logging::GALogger::d("Sending 'events' URL: %s", url.c_str());
 
-                std::string const jsonString = eventArray.dump();
-                if (jsonString.empty())
+                const int level = useGzip ? compression.chooseLevel(sizeHint) : 0;
+                const bool gzip = level > 0;
+
+                const auto encodeStart = std::chrono::steady_clock::now();
+
+                // serialize, compress and sign in one pass, the json text only exists in small chunks
+                utilities::GAPayloadEncoder encoder(gzip, state::GAState::getGameSecret(), gzip ? level : utilities::GAPayloadEncoder::DEFAULT_COMPRESSION_LEVEL);
+                utilities::GAJsonWriter writer;
+
+                writer.beginArray();
+                for (json const& event : eventArray)
+                {
+                    writer.value(event);
+                    if (writer.size() >= PAYLOAD_CHUNK_SIZE)
+                    {
+                        encoder.write(writer);
+                    }
+                }
+                writer.endArray();
+                encoder.write(writer);
+
+                if (!encoder.finish())
                 {
                     logging::GALogger::d("sendEventsInArray JSON encoding failed of eventArray");
                     return JsonEncodeFailed;
                 }
 
-                std::vector<uint8_t> payloadData = createPayloadData(jsonString, useGzip);
+                const auto encodeEnd = std::chrono::steady_clock::now();
+                compression.recordCompression(level, encoder.inputSize(), encoder.payload().size(), encodeEnd - encodeStart);
 
-                std::string const auth = createAuth(payloadData);
-                GAHttpClient::Response response = impl->sendRequest(url, auth, payloadData, useGzip, nullptr);
+                logging::GALogger::d("Payload stats. Size: %zu, Sent: %zu, Gzip level: %d", encoder.inputSize(), encoder.payload().size(), level);
+
+                std::string_view auth = encoder.signature();
+                std::vector<uint8_t> const& payloadData = encoder.payload();
+
+                GAHttpClient::Response& response = responseBuffer;
+                post(url, auth, payloadData, gzip, response);
+
+                if(response.code > 0)
+                {
+                    compression.recordUpload(payloadData.size(), std::chrono::steady_clock::now() - encodeEnd);
+                }
 
                 if(response.code < 0)
                 {
@@ -233,7 +393,7 @@ namespace gameanalytics
                 // if not 200 result
                 if (!isValidResponse && requestResponseEnum != BadRequest)
                 {
-                    logging::GALogger::d("Failed Events Call. URL: %s, JSONString: %s, Authorization: %s", url.c_str(), jsonString.c_str(), auth.c_str());
+                    logging::GALogger::d("Failed Events Call. URL: %s, Events: %zu, Authorization: %.*s", url.c_str(), eventArray.size(), (int)auth.size(), auth.data());
                     return requestResponseEnum;
                 }
 
@@ -243,7 +403,7 @@ namespace gameanalytics
                 }
 
                 // decode JSON
-                json requestJsonDict = json::parse(response.toString());
+                json requestJsonDict = json::parse(content);
                 if (requestJsonDict.is_null())
                 {
                     return JsonDecodeFailed;
@@ -252,7 +412,7 @@ namespace gameanalytics
                 // print reason if bad request
                 if (requestResponseEnum == BadRequest)
                 {
-                    logging::GALogger::d("Failed Events Call. Bad request. Response: %s", 
+                    GA_LOG_DEBUG("Failed Events Call. Bad request. Response: %s", 
                         requestJsonDict.dump(JSON_PRINT_INDENT).c_str());
 
                     return requestResponseEnum;
@@ -275,14 +435,67 @@ namespace gameanalytics
             }
         }
 
-        void GAHTTPApi::sendSdkErrorEvent(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, std::string const& reason, std::string const& gameKey, const std::string& secretKey)
+        void GASdkErrorQueue::add(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, std::string const& reason)
         {
-            if(!impl)
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            Entry& entry = _pending[std::make_tuple(category, area, action, parameter)];
+            if (entry.count == 0)
             {
-                logging::GALogger::e("Invalid http implmentation");
-                return;
+                entry.category  = category;
+                entry.area      = area;
+                entry.action    = action;
+                entry.parameter = parameter;
+                entry.reason    = reason;
             }
 
+            ++entry.count;
+        }
+
+        std::vector<GASdkErrorQueue::Entry> GASdkErrorQueue::take(int64_t now)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            std::vector<Entry> out;
+            for (auto& pending : _pending)
+            {
+                Entry& entry = pending.second;
+
+                CapWindowState& window = _windows[std::make_tuple(entry.category, entry.area)];
+                if (now - window.start >= CapWindow)
+                {
+                    window.start = now;
+                    window.sent  = 0;
+                }
+
+                if (window.sent >= MaxPerHour)
+                {
+                    _dropped += entry.count;
+                    continue;
+                }
+
+                ++window.sent;
+                out.push_back(std::move(entry));
+            }
+
+            _pending.clear();
+            return out;
+        }
+
+        bool GASdkErrorQueue::empty() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _pending.empty();
+        }
+
+        int64_t GASdkErrorQueue::getDropped() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _dropped;
+        }
+
+        void GAHTTPApi::sendSdkErrorEvent(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, std::string const& reason, std::string const& gameKey, const std::string& secretKey)
+        {
             if(!state::GAState::isEventSubmissionEnabled())
             {
                 return;
@@ -294,67 +507,73 @@ namespace gameanalytics
                 return;
             }
 
-            // Generate URL
-            const std::string url = baseUrl + "/" + gameKey + "/" + eventsUrlPath;
-
-            logging::GALogger::d("Sending 'events' URL: %s", url.c_str());
-
-            json jsonObject;
-            state::GAState::getSdkErrorEventAnnotations(jsonObject);
-
-            jsonObject["error_category"] = sdkErrorCategoryString(category);
-            jsonObject["error_area"]     = sdkErrorAreaString(area);
-            jsonObject["error_action"]   = sdkErrorActionString(action);
-            
-            utilities::addIfNotEmpty(jsonObject, "error_parameter", sdkErrorParameterString(parameter));
-            utilities::addIfNotEmpty(jsonObject, "reason", reason);
+            sdkErrors.add(category, area, action, parameter, reason);
+        }
 
-            json eventArray = json::array();
-            eventArray.push_back(jsonObject);
+        void GAHTTPApi::sendPendingSdkErrors()
+        {
+            if(!impl)
+            {
+                logging::GALogger::e("Invalid http implmentation");
+                return;
+            }
 
-            std::string payloadJSONString = eventArray.dump();
-            if(payloadJSONString.empty())
+            if(sdkErrors.empty())
             {
-                logging::GALogger::w("sendSdkErrorEvent: JSON encoding failed.");
                 return;
             }
 
-            logging::GALogger::d("sendSdkErrorEvent json: %s", payloadJSONString.c_str());
+            const std::vector<GASdkErrorQueue::Entry> entries = sdkErrors.take(utilities::GAUtilities::timeIntervalSince1970());
+            if(entries.empty())
+            {
+                logging::GALogger::d("sendPendingSdkErrors: hourly limit reached, %lld sdk error(s) dropped so far", static_cast<long long>(sdkErrors.getDropped()));
+                return;
+            }
 
-            ErrorType errorType = std::make_tuple(category, area);
+            // Generate URL
+            const std::string url = baseUrl + "/" + state::GAState::getGameKey() + "/" + eventsUrlPath;
 
-            bool useGzip = this->useGzip;
+            logging::GALogger::d("Sending 'events' URL: %s", url.c_str());
 
-            auto task = std::async(std::launch::async, [=]() -> void
+            try
             {
-                int64_t now = utilities::GAUtilities::timeIntervalSince1970();
-                if(timestampMap.count(errorType) == 0)
-                {
-                    timestampMap[errorType] = now;
-                }
-                if(countMap.count(errorType) == 0)
+                json eventArray = json::array();
+                for(GASdkErrorQueue::Entry const& entry : entries)
                 {
-                    countMap[errorType] = 0;
-                }
-                
-                constexpr int64_t FREQUENCY = 3600; // 1h
+                    json jsonObject;
+                    state::GAState::getSdkErrorEventAnnotations(jsonObject);
 
-                int64_t diff = now - timestampMap[errorType];
-                if(diff >= FREQUENCY)
-                {
-                    countMap[errorType] = 0;
-                    timestampMap[errorType] = now;
+                    jsonObject["error_category"] = sdkErrorCategoryString(entry.category);
+                    jsonObject["error_area"]     = sdkErrorAreaString(entry.area);
+                    jsonObject["error_action"]   = sdkErrorActionString(entry.action);
+
+                    utilities::addIfNotEmpty(jsonObject, "error_parameter", sdkErrorParameterString(entry.parameter));
+
+                    std::string reason = entry.reason;
+                    if(entry.count > 1)
+                    {
+                        reason += (reason.empty() ? "" : " ") + utilities::printString("(occurred %lld times)", static_cast<long long>(entry.count));
+                    }
+                    utilities::addIfNotEmpty(jsonObject, "reason", reason);
+
+                    eventArray.push_back(std::move(jsonObject));
                 }
 
-                if(countMap[errorType] >= MaxCount)
+                const std::string payloadJSONString = eventArray.dump();
+
+                logging::GALogger::d("sendPendingSdkErrors json: %s", payloadJSONString.c_str());
+
+                std::string auth;
+                bool gzip = useGzip;
+                std::vector<uint8_t> payloadData = createPayloadData(payloadJSONString, gzip, auth);
+                if(payloadData.empty())
                 {
+                    logging::GALogger::w("sendPendingSdkErrors: JSON encoding failed.");
                     return;
                 }
 
-                std::vector<uint8_t> payloadData = getInstance().createPayloadData(payloadJSONString, useGzip);
-
-                std::string auth = createAuth(payloadData);
-                GAHttpClient::Response response = impl->sendRequest(url, auth, payloadData, useGzip, nullptr);
+                GAHttpClient::Response& response = responseBuffer;
+                post(url, auth, payloadData, gzip, response);
 
                 if(response.code < 0)
                 {
@@ -371,33 +590,87 @@ namespace gameanalytics
                 if (response.code != HTTP_RESPONSE_OK && response.code != HTTP_RESPONSE_NO_CONTENT)
                 {
                     logging::GALogger::d("sdk error failed. response code not 200 or 204. status code: %ld", response.code);
-                    return;
                 }
-
-                countMap[errorType] = countMap[errorType] + 1;
-            });
+            }
+            catch (json::exception& e)
+            {
+                logging::GALogger::e("Json exception: %s", e.what());
+            }
+            catch (std::exception& e)
+            {
+                logging::GALogger::e("Exception thrown: %s", e.what());
+            }
         }
 
-        std::vector<uint8_t> GAHTTPApi::createPayloadData(std::string const& payload, bool gzip)
+        std::vector<uint8_t> GAHTTPApi::createPayloadData(std::string_view payload, bool& gzip, std::string& auth)
         {
             if (payload.empty())
             {
                 return {};
             }
 
-            std::vector<uint8_t> payloadData;
+            const int level = gzip ? compression.chooseLevel(payload.size()) : 0;
+            gzip = level > 0;
+
+            utilities::GAPayloadEncoder encoder(gzip, state::GAState::getGameSecret(), gzip ? level : utilities::GAPayloadEncoder::DEFAULT_COMPRESSION_LEVEL);
+            encoder.write(payload);
+            if (!encoder.finish())
+            {
+                return {};
+            }
 
             if (gzip)
             {
-                payloadData = utilities::GAUtilities::gzipCompress(payload.c_str());
-                logging::GALogger::d("Gzip stats. Size: %lu, Compressed: %lu", payload.size(), payloadData.size());
+                logging::GALogger::d("Gzip stats. Size: %zu, Compressed: %zu, Level: %d", payload.size(), encoder.payload().size(), level);
+            }
+
+            auth = encoder.signature();
+            return encoder.releasePayload();
+        }
+
+        void GAHTTPApi::post(std::string const& url, std::string_view signature, std::vector<uint8_t> const& payload, bool gzip, GAHttpClient::Response& response)
+        {
+            // a large init response shouldn't stay around for the lifetime of the sdk
+            if (response.packet.capacity() > MAX_RETAINED_RESPONSE_SIZE)
+            {
+                std::vector<uint8_t>().swap(response.packet);
             }
-            else
+
+            const GAHttpClient::Header headers[] =
             {
-                payloadData = std::vector<uint8_t>(payload.begin(), payload.end());
+                {"Authorization",    signature},
+                {"Content-Type",     "application/json"},
+                {"Content-Encoding", "gzip"}
+            };
+
+            GAHttpClient::Request request;
+            request.url          = url;
+            request.headers      = {headers, gzip ? 3u : 2u};
+            request.payload      = payload;
+            request.timeouts     = timeouts;
+            request.cancellation = &cancellation;
+
+            impl->send(request, response);
+
+            if (response.code < 0 && cancellation.isCancelled())
+            {
+                logging::GALogger::d("Request cancelled: %s", url.c_str());
             }
+        }
 
-            return payloadData;
+        void GAHTTPApi::setTimeouts(GAHttpClient::Timeouts const& value)
+        {
+            timeouts = value;
+        }
+
+        void GAHTTPApi::cancelRequestsAt(GAHttpClient::CancellationToken::Clock::time_point deadline)
+        {
+            cancellation.cancelAt(deadline);
+        }
+
+        void GAHTTPApi::resetCancellation()
+        {
+            cancellation.reset();
         }
 
         EGAHTTPApiResponse GAHTTPApi::processRequestResponse(GAHttpClient::Response const& response, std::string const& requestId)
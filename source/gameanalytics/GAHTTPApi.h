@@ -7,7 +7,10 @@
 
 #include "GACommon.h"
 #include "GameAnalytics/GAHttpClient.h"
+#include "GACompressionPolicy.h"
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <map>
 #include <mutex>
@@ -107,12 +110,54 @@ namespace gameanalytics
 
         typedef std::tuple<EGASdkErrorCategory, EGASdkErrorArea> ErrorType;
 
+        // Identical sdk errors (same category, area, action and parameter) are counted instead of
+        // being sent one by one. Pending errors go out as one request when the events queue is
+        // processed, at most MaxPerHour of them per category and area.
+        class GASdkErrorQueue
+        {
+            public:
+
+                static constexpr int     MaxPerHour = 10;
+                static constexpr int64_t CapWindow  = 3600; // 1h
+
+                struct Entry
+                {
+                    EGASdkErrorCategory  category;
+                    EGASdkErrorArea      area;
+                    EGASdkErrorAction    action;
+                    EGASdkErrorParameter parameter;
+                    std::string          reason;    // of the first occurrence
+                    int64_t              count = 0;
+                };
+
+                void add(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, std::string const& reason);
+
+                // removes the pending errors, returns those still under the hourly cap and drops the rest
+                std::vector<Entry> take(int64_t now);
+
+                bool    empty() const;
+                int64_t getDropped() const;
+
+            private:
+
+                typedef std::tuple<EGASdkErrorCategory, EGASdkErrorArea, EGASdkErrorAction, EGASdkErrorParameter> Key;
+
+                struct CapWindowState
+                {
+                    int64_t start = 0;
+                    int     sent  = 0;
+                };
+
+                mutable std::mutex _mutex;
+                std::map<Key, Entry> _pending;
+                std::map<ErrorType, CapWindowState> _windows;
+                int64_t _dropped = 0;
+        };
+
         class GAHTTPApi
         {
             friend class state::GAState;
             
-            static constexpr const char* PROTOCOL               = "https";
-            static constexpr const char* HOST_NAME              = "api.gameanalytics.com";
             static constexpr const char* VERSION                = "v2";
             static constexpr const char* REMOTE_CONFIG_VERSION  = "v1";
             static constexpr const char* INIT_URL_PATH          = "init";
@@ -120,6 +165,9 @@ namespace gameanalytics
 
         public:
 
+            static constexpr const char* PROTOCOL               = "https";
+            static constexpr const char* HOST_NAME              = "api.gameanalytics.com";
+
             static constexpr const char* sdkErrorCategoryString(EGASdkErrorCategory value);
             static constexpr const char* sdkErrorAreaString(EGASdkErrorArea value);
             static constexpr const char* sdkErrorActionString(EGASdkErrorAction value);
@@ -127,13 +175,44 @@ namespace gameanalytics
 
             static GAHTTPApi& getInstance();
 
-            static void setCustomHttpImpl(std::unique_ptr<GAHttpClient>&& customImpl);
+            // returns the client it replaces, so it can be put back
+            static std::unique_ptr<GAHttpClient> setCustomHttpImpl(std::unique_ptr<GAHttpClient>&& customImpl);
+
+            GACompressionPolicy& getCompressionPolicy();
+
+            // applied to every request, set from the GA thread
+            void setTimeouts(GAHttpClient::Timeouts const& value);
+
+            // requests running at or started after deadline fail as NoResponse, so their events stay
+            // in the store; thread safe, used to bound suspend and quit
+            void cancelRequestsAt(GAHttpClient::CancellationToken::Clock::time_point deadline);
+            void resetCancellation();
 
             void initializeClient();
 
+            // With warm-up on, initializeClient has the client resolve the collector host and open a
+            // connection in the background, and the GA thread repeats that every interval while a
+            // session runs, refreshing the cached DNS. Thread safe, takes effect in initializeClient.
+            static constexpr std::chrono::seconds DEFAULT_WARM_UP_INTERVAL{60};
+            void setConnectionWarmUp(bool enabled, std::chrono::seconds interval = DEFAULT_WARM_UP_INTERVAL);
+
+            // points the init and events requests at another collector, e.g. a local stand-in
+            // in tests and benchmarks; host may include a port
+            void setCollectorHost(std::string const& protocol, std::string const& host);
+
             EGAHTTPApiResponse requestInitReturningDict(json& json_out, std::string const& configsHash);
-            EGAHTTPApiResponse sendEventsInArray(json& json_out, const json& eventArray);
-            void sendSdkErrorEvent(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, std::string const& reason, std::string const& gameKey, std::string const& secretKey);            
+
+            using InitCallback = std::function<void(EGAHTTPApiResponse, json)>;
+            // sends the init request without blocking, callback gets the same result as
+            // requestInitReturningDict and runs on the GA thread
+            void requestInitAsync(std::string const& configsHash, InitCallback callback);
+
+            // sizeHint is the expected json size of the batch, used to pick the compression level
+            EGAHTTPApiResponse sendEventsInArray(json& json_out, const json& eventArray, std::size_t sizeHint);
+            // queues the error, see GASdkErrorQueue
+            void sendSdkErrorEvent(EGASdkErrorCategory category, EGASdkErrorArea area, EGASdkErrorAction action, EGASdkErrorParameter parameter, std::string const& reason, std::string const& gameKey, std::string const& secretKey);
+            // sends the queued sdk errors in one request, called from the GA thread
+            void sendPendingSdkErrors();
 
         private:
 
@@ -141,8 +220,23 @@ namespace gameanalytics
             ~GAHTTPApi();
             GAHTTPApi(const GAHTTPApi&) = delete;
             GAHTTPApi& operator=(const GAHTTPApi&) = delete;
-            std::vector<uint8_t> createPayloadData(std::string const& payload, bool gzip);
-            std::string createAuth(std::vector<uint8_t> const& payload);
+            // compresses (at the level of the compression policy) and signs the json in one pass,
+            // auth receives the signature and gzip whether the payload was compressed
+            std::vector<uint8_t> createPayloadData(std::string_view payload, bool& gzip, std::string& auth);
+            // posts a payload to the collector with the Authorization, Content-Type and Content-Encoding headers
+            void post(std::string const& url, std::string_view signature, std::vector<uint8_t> const& payload, bool gzip, GAHttpClient::Response& response);
+            struct InitRequest
+            {
+                std::string          url;
+                std::string          jsonString;
+                std::string          auth;
+                std::vector<uint8_t> payload;
+                bool                 gzip = false;
+            };
+
+            EGAHTTPApiResponse prepareInitRequest(std::string const& configsHash, InitRequest& request);
+            EGAHTTPApiResponse processInitResponse(InitRequest const& request, GAHttpClient::Response const& response, json& json_out);
+            void warmUpConnection();
             EGAHTTPApiResponse processRequestResponse(GAHttpClient::Response const& response, std::string const& requestId);
 
             std::unique_ptr<GAHttpClient> impl;
@@ -160,10 +254,19 @@ namespace gameanalytics
             std::string remoteConfigsBaseUrl;
 
             bool useGzip;
+            GACompressionPolicy compression;
+            GAHttpClient::Timeouts timeouts;
+            GAHttpClient::CancellationToken cancellation;
+
+            std::atomic<bool>    warmUpEnabled{false};
+            std::atomic<int64_t> warmUpInterval{DEFAULT_WARM_UP_INTERVAL.count()};
+            bool                 warmUpScheduled = false;
+
+            // reused by the init, events and sdk error requests, all are sent from the GA thread
+            static constexpr std::size_t MAX_RETAINED_RESPONSE_SIZE = 256 * 1024;
+            GAHttpClient::Response responseBuffer;
             
-            static constexpr int MaxCount = 10;
-            std::map<ErrorType, int> countMap;
-            std::map<ErrorType, int64_t> timestampMap;
+            GASdkErrorQueue sdkErrors;
 
             static std::unique_ptr<GAHttpClient> pendingCustomImpl;
         };
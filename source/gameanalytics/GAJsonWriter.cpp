@@ -0,0 +1,229 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAJsonWriter.h"
+#include <charconv>
+#include <cmath>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        void GAJsonWriter::reset()
+        {
+            _buffer.clear();
+            _hasElements.clear();
+            _afterKey = false;
+        }
+
+        void GAJsonWriter::beforeValue()
+        {
+            if(_afterKey)
+            {
+                _afterKey = false;
+                return;
+            }
+
+            if(!_hasElements.empty())
+            {
+                if(_hasElements.back())
+                {
+                    _buffer += ',';
+                }
+
+                _hasElements.back() = 1;
+            }
+        }
+
+        void GAJsonWriter::beginObject()
+        {
+            beforeValue();
+            _buffer += '{';
+            _hasElements.push_back(0);
+        }
+
+        void GAJsonWriter::endObject()
+        {
+            _buffer += '}';
+            _hasElements.pop_back();
+        }
+
+        void GAJsonWriter::beginArray()
+        {
+            beforeValue();
+            _buffer += '[';
+            _hasElements.push_back(0);
+        }
+
+        void GAJsonWriter::endArray()
+        {
+            _buffer += ']';
+            _hasElements.pop_back();
+        }
+
+        void GAJsonWriter::key(std::string_view name)
+        {
+            beforeValue();
+            _buffer += '"';
+            writeEscaped(name);
+            _buffer += "\":";
+            _afterKey = true;
+        }
+
+        void GAJsonWriter::members(std::string_view serialized)
+        {
+            if(serialized.empty())
+            {
+                return;
+            }
+
+            beforeValue();
+            _buffer.append(serialized.data(), serialized.size());
+        }
+
+        void GAJsonWriter::writeEscaped(std::string_view str)
+        {
+            constexpr const char* HEX = "0123456789abcdef";
+
+            std::size_t start = 0;
+            for(std::size_t i = 0; i < str.size(); ++i)
+            {
+                const unsigned char c = static_cast<unsigned char>(str[i]);
+                if(c >= 0x20 && c != '"' && c != '\\')
+                {
+                    continue;
+                }
+
+                // flush the run of characters that didn't need escaping
+                _buffer.append(str.data() + start, i - start);
+                start = i + 1;
+
+                switch(c)
+                {
+                    case '"':  _buffer += "\\\""; break;
+                    case '\\': _buffer += "\\\\"; break;
+                    case '\b': _buffer += "\\b";  break;
+                    case '\f': _buffer += "\\f";  break;
+                    case '\n': _buffer += "\\n";  break;
+                    case '\r': _buffer += "\\r";  break;
+                    case '\t': _buffer += "\\t";  break;
+                    default:
+                    {
+                        const char escaped[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xf]};
+                        _buffer.append(escaped, sizeof(escaped));
+                        break;
+                    }
+                }
+            }
+
+            _buffer.append(str.data() + start, str.size() - start);
+        }
+
+        void GAJsonWriter::value(std::string_view str)
+        {
+            beforeValue();
+            _buffer += '"';
+            writeEscaped(str);
+            _buffer += '"';
+        }
+
+        void GAJsonWriter::value(const char* str)
+        {
+            value(std::string_view(str ? str : ""));
+        }
+
+        void GAJsonWriter::value(std::string const& str)
+        {
+            value(std::string_view(str));
+        }
+
+        void GAJsonWriter::value(int64_t number)
+        {
+            beforeValue();
+
+            char buf[24];
+            auto result = std::to_chars(buf, buf + sizeof(buf), number);
+            _buffer.append(buf, result.ptr);
+        }
+
+        void GAJsonWriter::value(uint64_t number)
+        {
+            beforeValue();
+
+            char buf[24];
+            auto result = std::to_chars(buf, buf + sizeof(buf), number);
+            _buffer.append(buf, result.ptr);
+        }
+
+        void GAJsonWriter::value(int number)
+        {
+            value(static_cast<int64_t>(number));
+        }
+
+        void GAJsonWriter::value(double number)
+        {
+            if(!std::isfinite(number))
+            {
+                // same as nlohmann::json
+                null();
+                return;
+            }
+
+            beforeValue();
+
+            // use the same shortest round trip formatting as json::dump()
+            char buf[64];
+            char* end = nlohmann::detail::to_chars(buf, buf + sizeof(buf), number);
+            _buffer.append(buf, end);
+        }
+
+        void GAJsonWriter::value(bool flag)
+        {
+            beforeValue();
+            _buffer += flag ? "true" : "false";
+        }
+
+        void GAJsonWriter::null()
+        {
+            beforeValue();
+            _buffer += "null";
+        }
+
+        void GAJsonWriter::fieldIfNotEmpty(std::string_view name, std::string_view str)
+        {
+            if(!str.empty())
+            {
+                field(name, str);
+            }
+        }
+
+        std::string const& GAJsonWriter::str() const
+        {
+            return _buffer;
+        }
+
+        std::string_view GAJsonWriter::view() const
+        {
+            return _buffer;
+        }
+
+        std::size_t GAJsonWriter::size() const
+        {
+            return _buffer.size();
+        }
+
+        std::string GAJsonWriter::release()
+        {
+            std::string out = std::move(_buffer);
+            reset();
+            return out;
+        }
+
+        void GAJsonWriter::discard()
+        {
+            _buffer.clear();
+        }
+    }
+}
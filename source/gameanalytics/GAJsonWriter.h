@@ -0,0 +1,127 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+#include <string_view>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        // Streaming JSON writer that serializes straight into a reusable buffer.
+        // Commas are inserted automatically, keys are expected to be plain ascii.
+        class GAJsonWriter
+        {
+            public:
+
+                // clears the output but keeps the allocated capacity
+                void reset();
+
+                void beginObject();
+                void endObject();
+                void beginArray();
+                void endArray();
+
+                void key(std::string_view name);
+
+                void value(std::string_view str);
+                void value(const char* str);
+                void value(std::string const& str);
+                void value(int64_t number);
+                void value(uint64_t number);
+                void value(int number);
+                void value(double number);
+                void value(bool flag);
+                void null();
+
+                // walks an already built json value (any nlohmann::basic_json), used for user supplied data
+                template<typename BasicJsonType, typename std::enable_if<nlohmann::detail::is_basic_json<BasicJsonType>::value, int>::type = 0>
+                void value(BasicJsonType const& node)
+                {
+                    using value_t = nlohmann::detail::value_t;
+
+                    switch(node.type())
+                    {
+                        case value_t::object:
+                            beginObject();
+                            for(auto it = node.cbegin(); it != node.cend(); ++it)
+                            {
+                                key(it.key());
+                                value(*it);
+                            }
+                            endObject();
+                            break;
+
+                        case value_t::array:
+                            beginArray();
+                            for(auto const& element : node)
+                            {
+                                value(element);
+                            }
+                            endArray();
+                            break;
+
+                        case value_t::string:
+                            value(std::string_view(node.template get_ref<typename BasicJsonType::string_t const&>()));
+                            break;
+
+                        case value_t::boolean:
+                            value(node.template get<bool>());
+                            break;
+
+                        case value_t::number_integer:
+                            value(node.template get<int64_t>());
+                            break;
+
+                        case value_t::number_unsigned:
+                            value(node.template get<uint64_t>());
+                            break;
+
+                        case value_t::number_float:
+                            value(node.template get<double>());
+                            break;
+
+                        default:
+                            null();
+                            break;
+                    }
+                }
+
+                template<typename T>
+                void field(std::string_view name, T const& v)
+                {
+                    key(name);
+                    value(v);
+                }
+
+                void fieldIfNotEmpty(std::string_view name, std::string_view str);
+
+                // splices already serialized members ("key":value,...) into the open object
+                void members(std::string_view serialized);
+
+                std::string const& str() const;
+                std::string_view view() const;
+                std::size_t size() const;
+
+                // moves the output out, the writer has to be reset before it is used again
+                std::string release();
+
+                // drops the output written so far but keeps the open objects and arrays,
+                // so a large document can be handed on in chunks
+                void discard();
+
+            private:
+
+                void beforeValue();
+                void writeEscaped(std::string_view str);
+
+                std::string          _buffer;
+                std::vector<uint8_t> _hasElements;
+                bool                 _afterKey = false;
+        };
+    }
+}
@@ -0,0 +1,286 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GALogFile.h"
+
+#include "GAPayloadEncoder.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace gameanalytics
+{
+    namespace logging
+    {
+        namespace fs = std::filesystem;
+
+        // fast and still shrinks text logs to a fraction
+        constexpr int ROTATED_COMPRESSION_LEVEL = 6;
+
+        GALogFile::~GALogFile()
+        {
+            close();
+        }
+
+        bool GALogFile::open(std::string const& directory, std::string const& name)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if(_file.is_open())
+            {
+                flushLocked();
+                _file.close();
+            }
+
+            _directory = directory;
+            _name      = name;
+            _buffer.clear();
+
+            std::error_code error;
+            if(fs::file_size(path(), error) > 0 && !error)
+            {
+                // keep the log of the last run
+                rotateLocked();
+            }
+            else
+            {
+                _file.open(path(), std::ios::out | std::ios::trunc | std::ios::binary);
+                _fileSize = 0;
+                enforceBudgetLocked();
+            }
+
+            _lastFlush = std::chrono::steady_clock::now();
+            return _file.is_open();
+        }
+
+        void GALogFile::close()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if(_file.is_open())
+            {
+                flushLocked();
+                _file.close();
+            }
+        }
+
+        bool GALogFile::isOpen() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _file.is_open();
+        }
+
+        void GALogFile::setOptions(Options const& options)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _options = options;
+            _options.maxFiles    = (std::max)(_options.maxFiles, 1);
+            _options.maxFileSize = (std::max)(_options.maxFileSize, static_cast<std::size_t>(1));
+            _options.bufferSize  = (std::max)(_options.bufferSize, static_cast<std::size_t>(1));
+        }
+
+        GALogFile::Options GALogFile::getOptions() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _options;
+        }
+
+        void GALogFile::write(std::string_view line, bool flushNow)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if(!_file.is_open())
+            {
+                return;
+            }
+
+            // a buffer larger than a file would be written into a single file anyway
+            const std::size_t limit = (std::min)(_options.bufferSize, _options.maxFileSize);
+
+            if(!_buffer.empty() && _buffer.size() + line.size() + 1 > limit)
+            {
+                flushLocked();
+            }
+
+            _buffer.append(line.data(), line.size());
+            _buffer += '\n';
+
+            if(flushNow || _buffer.size() >= limit)
+            {
+                flushLocked();
+            }
+        }
+
+        void GALogFile::flushIfDue()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if(!_buffer.empty() && std::chrono::steady_clock::now() - _lastFlush >= _options.flushInterval)
+            {
+                flushLocked();
+            }
+        }
+
+        void GALogFile::flush()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            flushLocked();
+        }
+
+        std::string GALogFile::path() const
+        {
+            return _directory + "/" + _name + ".txt";
+        }
+
+        std::string GALogFile::rotatedPath(int index, bool compressed) const
+        {
+            return _directory + "/" + _name + "." + std::to_string(index) + (compressed ? ".txt.gz" : ".txt");
+        }
+
+        void GALogFile::flushLocked()
+        {
+            _lastFlush = std::chrono::steady_clock::now();
+
+            if(!_file.is_open() || _buffer.empty())
+            {
+                return;
+            }
+
+            if(_fileSize > 0 && _fileSize + _buffer.size() > _options.maxFileSize)
+            {
+                rotateLocked();
+                if(!_file.is_open())
+                {
+                    _buffer.clear();
+                    return;
+                }
+            }
+
+            _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+            _file.flush();
+
+            _fileSize += _buffer.size();
+            _buffer.clear();
+        }
+
+        void GALogFile::rotateLocked()
+        {
+            std::error_code error;
+
+            _file.close();
+
+            if(_options.maxFiles > 1)
+            {
+                fs::remove(rotatedPath(_options.maxFiles - 1, false), error);
+                fs::remove(rotatedPath(_options.maxFiles - 1, true), error);
+
+                for(int index = _options.maxFiles - 2; index >= 1; --index)
+                {
+                    for(bool compressed : {false, true})
+                    {
+                        if(fs::exists(rotatedPath(index, compressed), error))
+                        {
+                            fs::rename(rotatedPath(index, compressed), rotatedPath(index + 1, compressed), error);
+                        }
+                    }
+                }
+
+                fs::rename(path(), rotatedPath(1, false), error);
+
+                if(_options.compressRotated && !error)
+                {
+                    compress(rotatedPath(1, false));
+                }
+            }
+
+            _file.open(path(), std::ios::out | std::ios::trunc | std::ios::binary);
+            _fileSize = 0;
+
+            enforceBudgetLocked();
+        }
+
+        void GALogFile::compress(std::string const& source) const
+        {
+            std::string text;
+            {
+                std::ifstream in(source, std::ios::in | std::ios::binary);
+                if(!in.is_open())
+                {
+                    return;
+                }
+                text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            }
+
+            utilities::GAPayloadEncoder encoder(true, {}, ROTATED_COMPRESSION_LEVEL);
+            encoder.write(text);
+            if(!encoder.finish())
+            {
+                return;
+            }
+
+            const std::string target = source + ".gz";
+            {
+                std::ofstream out(target, std::ios::out | std::ios::trunc | std::ios::binary);
+                out.write(reinterpret_cast<const char*>(encoder.payload().data()), static_cast<std::streamsize>(encoder.payload().size()));
+                if(!out)
+                {
+                    std::error_code error;
+                    fs::remove(target, error);
+                    return;
+                }
+            }
+
+            std::error_code error;
+            fs::remove(source, error);
+        }
+
+        void GALogFile::enforceBudgetLocked()
+        {
+            std::error_code error;
+
+            // room the current file may grow into
+            std::size_t used = (std::min)(_options.maxFileSize, _options.diskBudget);
+            bool overBudget  = false;
+
+            // newest first, once a file doesn't fit it and everything older goes
+            for(int index = 1; index < _options.maxFiles; ++index)
+            {
+                for(bool compressed : {false, true})
+                {
+                    const std::string file = rotatedPath(index, compressed);
+
+                    const std::uintmax_t size = fs::file_size(file, error);
+                    if(error)
+                    {
+                        continue;
+                    }
+
+                    if(overBudget || used + size > _options.diskBudget)
+                    {
+                        overBudget = true;
+                        fs::remove(file, error);
+                    }
+                    else
+                    {
+                        used += static_cast<std::size_t>(size);
+                    }
+                }
+            }
+
+            // left over from a larger maxFiles
+            for(int index = _options.maxFiles; ; ++index)
+            {
+                const bool removedText       = fs::remove(rotatedPath(index, false), error);
+                const bool removedCompressed = fs::remove(rotatedPath(index, true), error);
+
+                if(!removedText && !removedCompressed)
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+
+namespace gameanalytics
+{
+    namespace logging
+    {
+        // The SDK log file: lines are collected in a buffer and written when it is full, when
+        // flushInterval has passed or right away for errors. Once the file would grow past
+        // maxFileSize it is rotated, <name>.txt becomes <name>.1.txt and so on up to maxFiles
+        // files in total, optionally gzip compressed (<name>.1.txt.gz). Rotated files are deleted,
+        // oldest first, to keep everything within diskBudget. A file left by the last run is
+        // rotated on open instead of truncated.
+        class GALogFile
+        {
+            public:
+
+                struct Options
+                {
+                    std::size_t               maxFileSize     = 1024 * 1024;
+                    int                       maxFiles        = 5;
+                    std::size_t               diskBudget      = 5 * 1024 * 1024;
+                    bool                      compressRotated = false;
+                    std::size_t               bufferSize      = 64 * 1024;
+                    std::chrono::milliseconds flushInterval{1000};
+                };
+
+                GALogFile() = default;
+                ~GALogFile();
+
+                GALogFile(GALogFile const&) = delete;
+                GALogFile& operator=(GALogFile const&) = delete;
+
+                // opens <directory>/<name>.txt, false if it can't be written
+                bool open(std::string const& directory, std::string const& name);
+                void close();
+                bool isOpen() const;
+
+                // takes effect with the next write
+                void    setOptions(Options const& options);
+                Options getOptions() const;
+
+                // appends line and a newline, flushNow writes the buffer to disk right away
+                void write(std::string_view line, bool flushNow = false);
+
+                // writes the buffer if flushInterval has passed since the last write
+                void flushIfDue();
+                void flush();
+
+                // <name>.txt, then <name>.<n>.txt[.gz] for n = 1 up to maxFiles - 1
+                std::string path() const;
+                std::string rotatedPath(int index, bool compressed) const;
+
+            private:
+
+                void flushLocked();
+                void rotateLocked();
+                void compress(std::string const& source) const;
+                void enforceBudgetLocked();
+
+                mutable std::mutex _mutex;
+                Options            _options;
+
+                std::string        _directory;
+                std::string        _name;
+                std::ofstream      _file;
+                std::size_t        _fileSize = 0;
+                std::string        _buffer;
+
+                std::chrono::steady_clock::time_point _lastFlush = std::chrono::steady_clock::now();
+        };
+    }
+}
@@ -13,8 +13,17 @@
 #define ZF_LOG_BUF_SZ 2048
 #include "zf_log.h"
 
-constexpr const char* LOG_FILE_NAME = "ga_log.txt";
-constexpr int         MAX_LOG_COUNT = 5000;
+static_assert(GA_LOG_LEVEL_ERROR == gameanalytics::LogError && GA_LOG_LEVEL_WARNING == gameanalytics::LogWarning
+    && GA_LOG_LEVEL_INFO == gameanalytics::LogInfo && GA_LOG_LEVEL_DEBUG == gameanalytics::LogDebug
+    && GA_LOG_LEVEL_VERBOSE == gameanalytics::LogVerbose, "GA_LOG_LEVEL values must match EGALoggerMessageType");
+
+constexpr const char* LOG_FILE_NAME = "ga_log";
+
+// the drain thread writes queued messages this often while the sdk logs, producers only wake it
+// early when the queue is half full, after IDLE_ROUNDS empty rounds it waits for the next message
+constexpr std::chrono::milliseconds DRAIN_INTERVAL{50};
+constexpr std::chrono::milliseconds IDLE_INTERVAL{1000};
+constexpr int                       IDLE_ROUNDS = 20;
 
 namespace gameanalytics
 {
@@ -25,9 +34,6 @@ namespace gameanalytics
             infoLogEnabled = false;
             customLogHandler = {};
             logInitialized = false;
-            currentLogCount = 0;
-            maxLogCount = MAX_LOG_COUNT;
-
 
 #if defined(_DEBUG)
             // log debug is in dev mode
@@ -35,10 +41,28 @@ namespace gameanalytics
 #else
             debugEnabled = false;
 #endif
+
+            _entries = std::make_unique<Entry[]>(QUEUE_CAPACITY);
+            for(std::size_t i = 0; i < QUEUE_CAPACITY; ++i)
+            {
+                _entries[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            _drainThread = std::thread(&GALogger::drainLoop, this);
         }
 
         GALogger::~GALogger()
         {
+            {
+                std::lock_guard<std::mutex> lock(_drainMutex);
+                _stopDrain = true;
+            }
+            _drainWake.notify_one();
+
+            if(_drainThread.joinable())
+            {
+                _drainThread.join();
+            }
         }
 
         GALogger& GALogger::getInstance()
@@ -48,7 +72,16 @@ namespace gameanalytics
 
         void GALogger::setCustomLogHandler(LogHandler handler)
         {
-            getInstance().customLogHandler = std::make_unique<LogHandler>(handler);
+            GALogger& logger = getInstance();
+
+            std::lock_guard<std::mutex> lock(logger._mutex);
+            logger.customLogHandler = handler ? std::make_shared<LogHandler>(std::move(handler)) : nullptr;
+        }
+
+        void GALogger::resetCustomLogHandler()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            customLogHandler.reset();
         }
 
         void GALogger::setInfoLog(bool enabled)
@@ -61,6 +94,326 @@ namespace gameanalytics
             getInstance().infoLogVerboseEnabled = enabled;
         }
 
+        void GALogger::setLogFileOptions(GALogFile::Options const& options)
+        {
+            getInstance().logFile.setOptions(options);
+        }
+
+        bool GALogger::flush(std::chrono::milliseconds timeout)
+        {
+            GALogger& logger = getInstance();
+
+            // a custom handler that logs would wait for itself
+            if(std::this_thread::get_id() == logger._drainThread.get_id())
+            {
+                return false;
+            }
+
+            const std::size_t target = logger._enqueuePos.load(std::memory_order_acquire);
+
+            std::unique_lock<std::mutex> lock(logger._drainMutex);
+            ++logger._flushWaiters;
+            logger._drainWake.notify_one();
+
+            const bool flushed = logger._drained.wait_for(lock, timeout, [&logger, target]()
+            {
+                return logger._dequeuePos.load(std::memory_order_acquire) >= target;
+            });
+
+            --logger._flushWaiters;
+            return flushed;
+        }
+
+        // bounded multi producer queue after Dmitry Vyukov: an entry is free for position pos when
+        // its sequence is pos, holds a message when it is pos + 1 and is free again for the next
+        // round at pos + QUEUE_CAPACITY
+        GALogger::Entry* GALogger::acquireEntry()
+        {
+            std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+
+            while(true)
+            {
+                Entry& entry = _entries[pos % QUEUE_CAPACITY];
+
+                const std::size_t sequence = entry.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff  = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+                if(diff == 0)
+                {
+                    if(_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        return &entry;
+                    }
+                }
+                else if(diff < 0)
+                {
+                    // the drain thread has not freed this entry from the last round yet
+                    return nullptr;
+                }
+                else
+                {
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void GALogger::publishEntry(Entry* entry)
+        {
+            const std::size_t pos = entry->sequence.load(std::memory_order_relaxed);
+            entry->sequence.store(pos + 1, std::memory_order_release);
+
+            // no lock here, a wake up the drain thread misses is caught by its wait timeout
+            const std::size_t pending = pos + 1 - _dequeuePos.load(std::memory_order_relaxed);
+            if(pending >= QUEUE_CAPACITY / 2 || _drainIdle.load(std::memory_order_relaxed))
+            {
+                _drainIdle.store(false, std::memory_order_relaxed);
+                _drainWake.notify_one();
+            }
+        }
+
+        static const char* messagePrefix(EGALoggerMessageType type)
+        {
+            switch (type)
+            {
+                case LogError:
+                    return "Error/GameAnalytics : ";
+
+                case LogWarning:
+                    return "Warning/GameAnalytics : ";
+
+                case LogDebug:
+                    return "Debug/GameAnalytics : ";
+
+                case LogInfo:
+                    return "Info/GameAnalytics : ";
+
+                case LogVerbose:
+                default:
+                    return "Verbose/GameAnalytics : ";
+            }
+        }
+
+        void GALogger::formatEntry(Entry const& entry, std::string& out)
+        {
+            // same cut off as formatting into a MAX_MESSAGE_SIZE buffer
+            const std::size_t limit = out.size() + MAX_MESSAGE_SIZE - 1;
+
+            char spec[32];
+            char buffer[MAX_MESSAGE_SIZE];
+
+            const char* fmt = entry.text;
+            std::size_t next = 0;
+
+            while(*fmt && out.size() < limit)
+            {
+                if(*fmt != '%')
+                {
+                    const char* end = std::strchr(fmt, '%');
+                    const std::size_t count = end ? static_cast<std::size_t>(end - fmt) : std::strlen(fmt);
+
+                    out.append(fmt, count);
+                    fmt += count;
+                    continue;
+                }
+
+                if(fmt[1] == '%')
+                {
+                    out += '%';
+                    fmt += 2;
+                    continue;
+                }
+
+                // flags, width, precision and length up to the conversion
+                const char* start = fmt++;
+                while(*fmt && !std::strchr("diouxXfFeEgGaAcspn", *fmt))
+                {
+                    ++fmt;
+                }
+
+                if(!*fmt)
+                {
+                    out.append(start);
+                    break;
+                }
+
+                const std::size_t specLength = static_cast<std::size_t>(++fmt - start);
+                if(specLength >= sizeof(spec) || next >= entry.argumentCount || fmt[-1] == 'n')
+                {
+                    ++next;
+                    continue;
+                }
+
+                std::memcpy(spec, start, specLength);
+                spec[specLength] = '\0';
+
+                Argument const& argument = entry.arguments[next++];
+
+                int written = 0;
+                switch(argument.kind)
+                {
+                    case ArgumentKind::Int:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, static_cast<int>(argument.i));
+                        break;
+
+                    case ArgumentKind::UnsignedInt:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, static_cast<unsigned int>(argument.u));
+                        break;
+
+                    case ArgumentKind::Long:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, static_cast<long>(argument.i));
+                        break;
+
+                    case ArgumentKind::UnsignedLong:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, static_cast<unsigned long>(argument.u));
+                        break;
+
+                    case ArgumentKind::LongLong:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, argument.i);
+                        break;
+
+                    case ArgumentKind::UnsignedLongLong:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, argument.u);
+                        break;
+
+                    case ArgumentKind::Double:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, argument.d);
+                        break;
+
+                    case ArgumentKind::Pointer:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, argument.p);
+                        break;
+
+                    case ArgumentKind::String:
+                        written = std::snprintf(buffer, sizeof(buffer), spec, entry.text + argument.offset);
+                        break;
+                }
+
+                if(written > 0)
+                {
+                    out.append(buffer, (std::min)(static_cast<std::size_t>(written), sizeof(buffer) - 1));
+                }
+            }
+
+            if(out.size() > limit)
+            {
+                out.resize(limit);
+            }
+        }
+
+        bool GALogger::drainEntries()
+        {
+            bool drained = false;
+            std::string message;
+
+            std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            while(true)
+            {
+                Entry& entry = _entries[pos % QUEUE_CAPACITY];
+                if(entry.sequence.load(std::memory_order_acquire) != pos + 1)
+                {
+                    break;
+                }
+
+                const EGALoggerMessageType type = entry.type;
+                message.assign(messagePrefix(type));
+
+                if(entry.formatted)
+                {
+                    message.append(entry.text, entry.length);
+                }
+                else
+                {
+                    formatEntry(entry, message);
+                }
+
+                entry.sequence.store(pos + QUEUE_CAPACITY, std::memory_order_release);
+
+                try
+                {
+                    sendNotificationMessage(message, type);
+                }
+                catch (std::exception const& e)
+                {
+                    std::cerr << "Error/GameAnalytics:" << e.what() << "\n";
+                }
+
+                _dequeuePos.store(++pos, std::memory_order_release);
+                drained = true;
+            }
+
+            const std::size_t dropped = _droppedCount.exchange(0, std::memory_order_relaxed);
+            if(dropped > 0)
+            {
+                message.assign(messagePrefix(LogWarning));
+                message += std::to_string(dropped) + " log messages were dropped, the log queue was full";
+
+                try
+                {
+                    sendNotificationMessage(message, LogWarning);
+                }
+                catch (std::exception const& e)
+                {
+                    std::cerr << "Error/GameAnalytics:" << e.what() << "\n";
+                }
+
+                drained = true;
+            }
+
+            return drained;
+        }
+
+        void GALogger::drainLoop()
+        {
+            int emptyRounds = 0;
+
+            while(true)
+            {
+                const bool drained = drainEntries();
+
+                std::unique_lock<std::mutex> lock(_drainMutex);
+                const bool flushRequested = _flushWaiters > 0;
+                const bool stop           = _stopDrain;
+                lock.unlock();
+
+                if(stop)
+                {
+                    drainEntries();
+                    logFile.close();
+                    _drained.notify_all();
+                    return;
+                }
+
+                if(flushRequested)
+                {
+                    logFile.flush();
+                }
+                else
+                {
+                    logFile.flushIfDue();
+                }
+
+                lock.lock();
+                _drained.notify_all();
+
+                emptyRounds = drained ? 0 : emptyRounds + 1;
+
+                const bool idle = emptyRounds >= IDLE_ROUNDS;
+                _drainIdle.store(idle, std::memory_order_relaxed);
+
+                _drainWake.wait_for(lock, idle ? IDLE_INTERVAL : DRAIN_INTERVAL, [this, idle]()
+                {
+                    const std::size_t pending = _enqueuePos.load(std::memory_order_relaxed) - _dequeuePos.load(std::memory_order_relaxed);
+                    if(_stopDrain)
+                    {
+                        return true;
+                    }
+
+                    return (pending > 0 || _droppedCount.load(std::memory_order_relaxed) > 0)
+                        && (_flushWaiters > 0 || pending >= QUEUE_CAPACITY / 2 || (idle && !_drainIdle.load(std::memory_order_relaxed)));
+                });
+            }
+        }
+
         void GALogger::file_output_callback(const zf_log_message *msg, void *arg)
         {
             try
@@ -73,8 +426,7 @@ namespace gameanalytics
                 (void)arg;
                 *msg->p = '\n';
 
-                getInstance().logFile.write(msg->buf, msg->p - msg->buf + 1);
-                getInstance().logFile.flush();
+                getInstance().logFile.write(std::string_view(msg->buf, msg->p - msg->buf));
             }
             catch (std::exception& e)
             {
@@ -90,31 +442,31 @@ namespace gameanalytics
                 return;
             }
 
-             std::string logFilePath = writablepath + "/" + LOG_FILE_NAME;
-
-            logFile.open(logFilePath, std::ios::out | std::ios::trunc);
-
-            if (!logFile.is_open())
+            if (!logFile.open(writablepath, LOG_FILE_NAME))
             {
-                ZF_LOGW("Failed to open log file %s", logFilePath.c_str());
+                ZF_LOGW("Failed to open log file %s", logFile.path().c_str());
                 return;
             }
 
             //zf_log_set_output_v(ZF_LOG_PUT_STD, 0, file_output_callback);
 
             logInitialized  = true;
-            currentLogCount = 0;
 
-            GALogger::i("Log file added under: %s", logFilePath.c_str());
+            GALogger::i("Log file added under: %s", logFile.path().c_str());
         }
 
 
         void GALogger::sendNotificationMessage(std::string const& message, EGALoggerMessageType type)
         {
-            if(customLogHandler)
+            std::shared_ptr<LogHandler> handler;
             {
-                auto& handler = *customLogHandler;
-                handler(message, type);
+                std::lock_guard<std::mutex> lock(_mutex);
+                handler = customLogHandler;
+            }
+
+            if(handler)
+            {
+                (*handler)(message, type);
                 return;
             }
 
@@ -123,10 +475,8 @@ namespace gameanalytics
                 initializeLog();
             }
             
-            if (logFile.is_open())
-            {
-                logFile << message << '\n';
-            }
+            // errors are written right away, they may be the last thing before a crash
+            logFile.write(message, type == LogError);
 
             switch(type)
             {
@@ -6,8 +6,30 @@
 #pragma once
 
 #include "GACommon.h"
+#include "GALogFile.h"
 #include "GAUtilities.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+// Most verbose level compiled in, set it for the whole build (see GA_LOG_LEVEL in CMakeLists.txt).
+// Messages above it are dropped by GALogger and the GA_LOG_* macros below compile to nothing.
+#define GA_LOG_LEVEL_ERROR      0
+#define GA_LOG_LEVEL_WARNING    1
+#define GA_LOG_LEVEL_INFO       2
+#define GA_LOG_LEVEL_DEBUG      3
+#define GA_LOG_LEVEL_VERBOSE    4
+
+#if !defined(GA_LOG_LEVEL)
+    #define GA_LOG_LEVEL GA_LOG_LEVEL_VERBOSE
+#endif
+
 struct zf_log_message;
 
 namespace gameanalytics
@@ -18,53 +40,182 @@ namespace gameanalytics
         {
             friend class state::GAState;
 
+            public:
+
+                // pending messages before new ones are dropped (see sendMessage)
+                static constexpr std::size_t QUEUE_CAPACITY   = 128;
+                static constexpr std::size_t MAX_MESSAGE_SIZE = 2048;
+                static constexpr std::size_t MAX_ARGUMENTS    = 8;
+
+            private:
+
+            enum class ArgumentKind
+            {
+                Int,
+                UnsignedInt,
+                Long,
+                UnsignedLong,
+                LongLong,
+                UnsignedLongLong,
+                Double,
+                Pointer,
+                String
+            };
+
+            struct Argument
+            {
+                ArgumentKind kind = ArgumentKind::Int;
+                union
+                {
+                    long long          i;
+                    unsigned long long u;
+                    double             d;
+                    const void*        p;
+                    std::size_t        offset;    // of a copied string in Entry::text
+                };
+            };
+
+            // one slot of the bounded multi producer queue, sequence tells whose turn it is.
+            // text holds the format string and copied string arguments, or the formatted message
+            struct Entry
+            {
+                std::atomic<std::size_t> sequence{0};
+                EGALoggerMessageType     type          = LogVerbose;
+                bool                     formatted     = false;
+                std::size_t              length        = 0;
+                std::size_t              argumentCount = 0;
+                Argument                 arguments[MAX_ARGUMENTS];
+                char                     text[MAX_MESSAGE_SIZE];
+            };
+
+            // copies the format string and arguments into a free queue entry, formatting, the prefix,
+            // file, console and custom handler output are done by the drain thread. Messages with
+            // arguments that can't be copied (or don't fit) are formatted here instead
             template<typename ...args_t>
             static void sendMessage(EGALoggerMessageType logType, std::string const& fmt, args_t&&... args)
             {
-                if (logType == LogVerbose && !getInstance().infoLogVerboseEnabled)
+                if(!isEnabled(logType))
                 {
                     return;
                 }
 
-                if(logType == LogInfo && !getInstance().infoLogEnabled)
+                GALogger& logger = getInstance();
+
+                Entry* entry = logger.acquireEntry();
+                if(!entry)
                 {
+                    // queue is full, the drain thread reports how many were dropped
+                    logger._droppedCount.fetch_add(1, std::memory_order_relaxed);
                     return;
                 }
 
-                std::string tag = getInstance().tag;
-                tag += " :";
-                    
-                switch (logType)
+                entry->type          = logType;
+                entry->formatted     = false;
+                entry->argumentCount = 0;
+                entry->length        = fmt.size() + 1;
+
+                // * widths take their own arguments, leave those to snprintf
+                const bool deferred = entry->length <= MAX_MESSAGE_SIZE && fmt.find('*') == std::string::npos
+                    && (captureArgument(*entry, args) && ...);
+
+                if(deferred)
+                {
+                    std::memcpy(entry->text, fmt.c_str(), fmt.size() + 1);
+                }
+                else
                 {
-                    case LogError:
-                        tag = "Error/" + tag;
-                        break;
-                        
-                    case LogWarning:
-                        tag = "Warning/" + tag;
-                        break;
+                    const int length = std::snprintf(entry->text, MAX_MESSAGE_SIZE, fmt.c_str(), std::forward<args_t>(args)...);
+
+                    entry->formatted = true;
+                    entry->length    = length < 0 ? 0 : (std::min)(static_cast<std::size_t>(length), MAX_MESSAGE_SIZE - 1);
+                }
 
-                    case LogDebug:
-                        tag = "Debug/" + tag;
-                        break;
+                logger.publishEntry(entry);
+            }
 
-                    case LogInfo:
-                        tag = "Info/" + tag;
-                        break;
+            // stores one printf argument as the type snprintf would have read, strings are copied
+            // behind the format string in entry.text
+            template<typename T>
+            static bool captureArgument(Entry& entry, T const& value)
+            {
+                using Value = std::decay_t<T>;
 
-                    case LogVerbose:
-                    default:
-                        tag = "Verbose/" + tag;
+                if(entry.argumentCount == MAX_ARGUMENTS)
+                {
+                    return false;
                 }
-                try
+
+                Argument& argument = entry.arguments[entry.argumentCount];
+
+                if constexpr (std::is_same_v<Value, const char*> || std::is_same_v<Value, char*>)
                 {
-                    const std::string msg = tag + ' ' + utilities::printString(fmt, std::forward<args_t>(args)...);
-                    getInstance().sendNotificationMessage(msg, logType);
+                    // T may be a char array for a literal, which can't be null
+                    const char* text = value;
+                    if constexpr (!std::is_array_v<T>)
+                    {
+                        if(!text)
+                        {
+                            text = "(null)";
+                        }
+                    }
+                    const std::size_t size = std::strlen(text) + 1;
+
+                    if(entry.length + size > MAX_MESSAGE_SIZE)
+                    {
+                        return false;
+                    }
+
+                    argument.kind   = ArgumentKind::String;
+                    argument.offset = entry.length;
+                    std::memcpy(entry.text + entry.length, text, size);
+                    entry.length += size;
                 }
-                catch (std::exception const& e)
+                else if constexpr (std::is_enum_v<Value>)
                 {
-                    std::cerr << "Error/GameAnalytics:" << e.what() << "\n";
+                    return captureArgument(entry, static_cast<std::underlying_type_t<Value>>(value));
                 }
+                else if constexpr (std::is_integral_v<Value>)
+                {
+                    // after the default argument promotions
+                    using Promoted = decltype(+value);
+
+                    if constexpr (std::is_same_v<Promoted, int>)                     { argument.kind = ArgumentKind::Int; }
+                    else if constexpr (std::is_same_v<Promoted, unsigned int>)       { argument.kind = ArgumentKind::UnsignedInt; }
+                    else if constexpr (std::is_same_v<Promoted, long>)               { argument.kind = ArgumentKind::Long; }
+                    else if constexpr (std::is_same_v<Promoted, unsigned long>)      { argument.kind = ArgumentKind::UnsignedLong; }
+                    else if constexpr (std::is_same_v<Promoted, long long>)          { argument.kind = ArgumentKind::LongLong; }
+                    else if constexpr (std::is_same_v<Promoted, unsigned long long>) { argument.kind = ArgumentKind::UnsignedLongLong; }
+                    else
+                    {
+                        return false;
+                    }
+
+                    if constexpr (std::is_signed_v<Promoted>)
+                    {
+                        argument.i = value;
+                    }
+                    else
+                    {
+                        argument.u = value;
+                    }
+                }
+                else if constexpr (std::is_same_v<Value, double> || std::is_same_v<Value, float>)
+                {
+                    argument.kind = ArgumentKind::Double;
+                    argument.d    = value;
+                }
+                else if constexpr (std::is_pointer_v<Value>)
+                {
+                    argument.kind = ArgumentKind::Pointer;
+                    argument.p    = value;
+                }
+                else
+                {
+                    return false;
+                }
+
+                ++entry.argumentCount;
+                return true;
             }
 
             public:
@@ -74,6 +225,13 @@ namespace gameanalytics
                 static void setVerboseInfoLog(bool enabled);
                 static void setCustomLogHandler(LogHandler handler);
 
+                // blocks until the messages queued before the call are written or timeout passes,
+                // false on timeout
+                static bool flush(std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+
+                // size, rotation and disk budget of ga_log.txt
+                static void setLogFileOptions(GALogFile::Options const& options);
+
                 // Debug (w/e always shows, d only shows during SDK development, i shows when client has set debugEnabled to YES)
                 template<typename ...args_t>
                 static void w(std::string const& fmt, args_t&&... args)
@@ -105,8 +263,32 @@ namespace gameanalytics
                     sendMessage(LogVerbose, fmt, std::forward<args_t>(args)...);
                 }
 
+                // false when the level is above GA_LOG_LEVEL or switched off (info and verbose)
+                static bool isEnabled(EGALoggerMessageType logType)
+                {
+                    if(static_cast<int>(logType) > GA_LOG_LEVEL)
+                    {
+                        return false;
+                    }
+
+                    if(logType == LogVerbose)
+                    {
+                        return getInstance().infoLogVerboseEnabled;
+                    }
+
+                    if(logType == LogInfo)
+                    {
+                        return getInstance().infoLogEnabled;
+                    }
+
+                    return true;
+                }
+
          private:
 
+            // printf of a deferred entry on the drain thread
+            static void formatEntry(Entry const& entry, std::string& out);
+
             static constexpr const char* tag = "GameAnalytics";
             static GALogger& getInstance();
 
@@ -115,23 +297,81 @@ namespace gameanalytics
             GALogger(const GALogger&) = delete;
             GALogger& operator=(const GALogger&) = delete;
 
+            Entry* acquireEntry();
+            void publishEntry(Entry* entry);
+
+            void drainLoop();
+            bool drainEntries();
+
             void sendNotificationMessage(std::string const& message, EGALoggerMessageType type);
+            void resetCustomLogHandler();
             void initializeLog();
-           
-            std::unique_ptr<LogHandler> customLogHandler;
+
+            std::shared_ptr<LogHandler> customLogHandler;
 
             // Settings
-            bool infoLogEnabled         = false;
-            bool infoLogVerboseEnabled  = false;
+            std::atomic<bool> infoLogEnabled{false};
+            std::atomic<bool> infoLogVerboseEnabled{false};
             bool debugEnabled           = false;
 
             static void file_output_callback(const zf_log_message *msg, void *arg);
-            
+
+            // guards customLogHandler
             std::mutex      _mutex;
             bool            logInitialized;
-            std::fstream    logFile;
-            int             currentLogCount;
-            int             maxLogCount;
+            GALogFile       logFile;
+
+            std::unique_ptr<Entry[]>  _entries;
+            std::atomic<std::size_t>  _enqueuePos{0};
+            std::atomic<std::size_t>  _dequeuePos{0};
+            std::atomic<std::size_t>  _droppedCount{0};
+
+            std::mutex                _drainMutex;
+            std::condition_variable   _drainWake;
+            std::condition_variable   _drained;
+            std::atomic<bool>         _drainIdle{false};
+            int                       _flushWaiters = 0;
+            bool                      _stopDrain = false;
+            std::thread               _drainThread;
         };
     }
 }
+
+// Lazy forms of GALogger::e/w/i/d/v, the arguments are only evaluated when the level is enabled.
+// Use them when building an argument costs something, e.g. a json dump.
+#define GA_LOG_LAZY(type, method, ...) \
+    do { if(::gameanalytics::logging::GALogger::isEnabled(type)) { ::gameanalytics::logging::GALogger::method(__VA_ARGS__); } } while(false)
+
+// keeps the arguments referenced so variables only used for logging don't warn
+#define GA_LOG_REMOVED(method, ...) \
+    do { if(false) { ::gameanalytics::logging::GALogger::method(__VA_ARGS__); } } while(false)
+
+#if GA_LOG_LEVEL >= GA_LOG_LEVEL_ERROR
+    #define GA_LOG_ERROR(...) GA_LOG_LAZY(::gameanalytics::LogError, e, __VA_ARGS__)
+#else
+    #define GA_LOG_ERROR(...) GA_LOG_REMOVED(e, __VA_ARGS__)
+#endif
+
+#if GA_LOG_LEVEL >= GA_LOG_LEVEL_WARNING
+    #define GA_LOG_WARNING(...) GA_LOG_LAZY(::gameanalytics::LogWarning, w, __VA_ARGS__)
+#else
+    #define GA_LOG_WARNING(...) GA_LOG_REMOVED(w, __VA_ARGS__)
+#endif
+
+#if GA_LOG_LEVEL >= GA_LOG_LEVEL_INFO
+    #define GA_LOG_INFO(...) GA_LOG_LAZY(::gameanalytics::LogInfo, i, __VA_ARGS__)
+#else
+    #define GA_LOG_INFO(...) GA_LOG_REMOVED(i, __VA_ARGS__)
+#endif
+
+#if GA_LOG_LEVEL >= GA_LOG_LEVEL_DEBUG
+    #define GA_LOG_DEBUG(...) GA_LOG_LAZY(::gameanalytics::LogDebug, d, __VA_ARGS__)
+#else
+    #define GA_LOG_DEBUG(...) GA_LOG_REMOVED(d, __VA_ARGS__)
+#endif
+
+#if GA_LOG_LEVEL >= GA_LOG_LEVEL_VERBOSE
+    #define GA_LOG_VERBOSE(...) GA_LOG_LAZY(::gameanalytics::LogVerbose, v, __VA_ARGS__)
+#else
+    #define GA_LOG_VERBOSE(...) GA_LOG_REMOVED(v, __VA_ARGS__)
+#endif
@@ -0,0 +1,150 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        // A set of bytes built from a regex style class description such as "A-Za-z0-9_".
+        // Supports ranges, a literal '-' at either end, "\s" for the whitespace of the
+        // classic locale (space, \t, \n, \v, \f, \r) and "\x" for any other literal x.
+        // Meant to be built at compile time and used by the matchers below in place of
+        // std::regex for the fixed patterns of the validators.
+        class CharacterClass
+        {
+            public:
+
+                constexpr CharacterClass() = default;
+
+                constexpr explicit CharacterClass(std::string_view description)
+                {
+                    for(std::size_t i = 0; i < description.size(); ++i)
+                    {
+                        unsigned char first = static_cast<unsigned char>(description[i]);
+
+                        if(first == '\\' && i + 1 < description.size())
+                        {
+                            ++i;
+                            if(description[i] == 's')
+                            {
+                                for(char c : std::string_view(" \t\n\v\f\r"))
+                                {
+                                    add(static_cast<unsigned char>(c));
+                                }
+                                continue;
+                            }
+                            first = static_cast<unsigned char>(description[i]);
+                        }
+
+                        if(i + 2 < description.size() && description[i + 1] == '-')
+                        {
+                            const unsigned char last = static_cast<unsigned char>(description[i + 2]);
+                            for(unsigned c = first; c <= last; ++c)
+                            {
+                                add(static_cast<unsigned char>(c));
+                            }
+                            i += 2;
+                        }
+                        else
+                        {
+                            add(first);
+                        }
+                    }
+                }
+
+                constexpr bool contains(char c) const
+                {
+                    const unsigned char byte = static_cast<unsigned char>(c);
+                    return (_bits[byte / 64] >> (byte % 64)) & 1u;
+                }
+
+                constexpr CharacterClass negated() const
+                {
+                    CharacterClass result;
+                    for(int i = 0; i < 4; ++i)
+                    {
+                        result._bits[i] = ~_bits[i];
+                    }
+                    return result;
+                }
+
+            private:
+
+                constexpr void add(unsigned char c)
+                {
+                    _bits[c / 64] |= std::uint64_t(1) << (c % 64);
+                }
+
+                std::uint64_t _bits[4] = {};
+        };
+
+        // ^[class]{minLength,maxLength}$
+        constexpr bool matchRun(std::string_view string, CharacterClass const& characters, std::size_t minLength, std::size_t maxLength)
+        {
+            if(string.size() < minLength || string.size() > maxLength)
+            {
+                return false;
+            }
+
+            for(char c : string)
+            {
+                if(!characters.contains(c))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // ^[class]{1,maxLength}(separator[class]{1,maxLength}){0,maxRuns-1}$
+        // the separator must not be part of the class
+        constexpr bool matchSeparatedRuns(std::string_view string, CharacterClass const& characters, char separator, std::size_t maxLength, std::size_t maxRuns)
+        {
+            std::size_t runs  = 0;
+            std::size_t start = 0;
+
+            while(true)
+            {
+                std::size_t end = string.find(separator, start);
+                if(end == std::string_view::npos)
+                {
+                    end = string.size();
+                }
+
+                if(++runs > maxRuns || !matchRun(string.substr(start, end - start), characters, 1, maxLength))
+                {
+                    return false;
+                }
+
+                if(end == string.size())
+                {
+                    return true;
+                }
+                start = end + 1;
+            }
+        }
+
+        // ^(first|second|...)$
+        constexpr bool matchAnyOf(std::string_view string, std::initializer_list<std::string_view> alternatives)
+        {
+            for(std::string_view alternative : alternatives)
+            {
+                if(string == alternative)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+}
@@ -0,0 +1,276 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAPayloadEncoder.h"
+#include "GAUtilities.h"
+#include "GALogger.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include <hmac_sha2.h>
+
+#define MINIZ_HEADER_FILE_ONLY
+#include "GA_Zip.cpp"
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        using namespace zip;
+
+        namespace
+        {
+            constexpr std::size_t INITIAL_CAPACITY = 16 * 1024;
+
+            // deflate gets at least this much room per call
+            constexpr std::size_t MIN_OUTPUT_CHUNK = 4 * 1024;
+
+            constexpr std::string_view AUTHORIZATION_PREFIX = "Authorization: ";
+
+            // https://tools.ietf.org/html/rfc1952
+            constexpr uint8_t GZIP_HEADER[10] =
+            {
+                0x1f, 0x8b, 8 /* deflate */, 0,
+                0, 0, 0, 0, /* mtime */
+                0, 0x03     /* Unix OS_CODE */
+            };
+
+            void writeLittleEndian(uint8_t* out, uint32_t value)
+            {
+                out[0] = static_cast<uint8_t>(value);
+                out[1] = static_cast<uint8_t>(value >> 8);
+                out[2] = static_cast<uint8_t>(value >> 16);
+                out[3] = static_cast<uint8_t>(value >> 24);
+            }
+        }
+
+        struct GAPayloadEncoder::State
+        {
+            mz_stream  stream;
+            hmac_sha256_ctx hmac;
+            uint32_t        crc = 0;
+            bool            deflateStarted = false;
+        };
+
+        GAPayloadEncoder::GAPayloadEncoder(bool gzip, std::string_view secretKey, int compressionLevel):
+            _state(std::make_unique<State>()),
+            _gzip(gzip),
+            _sign(!secretKey.empty())
+        {
+            _out.resize(INITIAL_CAPACITY);
+
+            if(_sign)
+            {
+                hmac_sha256_init2(&_state->hmac, reinterpret_cast<const unsigned char*>(secretKey.data()), static_cast<unsigned int>(secretKey.size()));
+            }
+
+            if(_gzip)
+            {
+                std::memset(&_state->stream, 0, sizeof(_state->stream));
+
+                // negative window bits for raw deflate, the gzip framing is written here
+                if(mz_deflateInit2(&_state->stream, compressionLevel, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS, 9, MZ_DEFAULT_STRATEGY) != MZ_OK)
+                {
+                    logging::GALogger::e("GAPayloadEncoder: deflate init failed");
+                    _failed = true;
+                    return;
+                }
+
+                _state->deflateStarted = true;
+                append(GZIP_HEADER, sizeof(GZIP_HEADER));
+            }
+        }
+
+        GAPayloadEncoder::~GAPayloadEncoder()
+        {
+            if(_state->deflateStarted)
+            {
+                mz_deflateEnd(&_state->stream);
+            }
+        }
+
+        void GAPayloadEncoder::ensureCapacity(std::size_t extra)
+        {
+            if(_out.size() - _outSize < extra)
+            {
+                _out.resize(std::max(_out.size() * 2, _outSize + extra));
+            }
+        }
+
+        void GAPayloadEncoder::append(const uint8_t* data, std::size_t size)
+        {
+            ensureCapacity(size);
+            std::memcpy(_out.data() + _outSize, data, size);
+
+            if(_sign)
+            {
+                hmac_sha256_update(&_state->hmac, data, static_cast<unsigned int>(size));
+            }
+
+            _outSize += size;
+        }
+
+        void GAPayloadEncoder::deflateInput(std::string_view data, bool finish)
+        {
+            mz_stream& stream = _state->stream;
+
+            stream.next_in  = reinterpret_cast<const unsigned char*>(data.data());
+            stream.avail_in = static_cast<unsigned int>(data.size());
+
+            while(true)
+            {
+                ensureCapacity(MIN_OUTPUT_CHUNK);
+
+                uint8_t* const start = _out.data() + _outSize;
+                const std::size_t available = _out.size() - _outSize;
+
+                stream.next_out  = start;
+                stream.avail_out = static_cast<unsigned int>(std::min<std::size_t>(available, UINT_MAX));
+
+                const int ret = mz_deflate(&stream, finish ? MZ_FINISH : MZ_NO_FLUSH);
+
+                const std::size_t produced = static_cast<std::size_t>(stream.next_out - start);
+                if(_sign && produced > 0)
+                {
+                    hmac_sha256_update(&_state->hmac, start, static_cast<unsigned int>(produced));
+                }
+                _outSize += produced;
+
+                if(finish)
+                {
+                    if(ret == MZ_STREAM_END)
+                    {
+                        return;
+                    }
+
+                    if(ret != MZ_OK)
+                    {
+                        logging::GALogger::e("Exception during zlib compression: (%d)", ret);
+                        _failed = true;
+                        return;
+                    }
+                }
+                else
+                {
+                    // all input taken and the output buffer wasn't the limit
+                    if(stream.avail_in == 0 && stream.avail_out > 0)
+                    {
+                        return;
+                    }
+
+                    if(ret != MZ_OK && ret != MZ_BUF_ERROR)
+                    {
+                        logging::GALogger::e("Exception during zlib compression: (%d)", ret);
+                        _failed = true;
+                        return;
+                    }
+                }
+            }
+        }
+
+        void GAPayloadEncoder::write(std::string_view data)
+        {
+            if(_failed || _finished || data.empty())
+            {
+                return;
+            }
+
+            _inputSize += data.size();
+
+            if(_gzip)
+            {
+                _state->crc = static_cast<uint32_t>(mz_crc32(_state->crc, reinterpret_cast<const unsigned char*>(data.data()), data.size()));
+                deflateInput(data, false);
+            }
+            else
+            {
+                append(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+            }
+        }
+
+        void GAPayloadEncoder::write(GAJsonWriter& writer)
+        {
+            write(writer.view());
+            writer.discard();
+        }
+
+        bool GAPayloadEncoder::finish()
+        {
+            if(_finished)
+            {
+                return !_failed;
+            }
+
+            _finished = true;
+
+            if(_failed)
+            {
+                return false;
+            }
+
+            if(_gzip)
+            {
+                deflateInput({}, true);
+                if(_failed)
+                {
+                    return false;
+                }
+
+                uint8_t trailer[8];
+                writeLittleEndian(trailer, _state->crc);
+                writeLittleEndian(trailer + 4, static_cast<uint32_t>(_inputSize));
+                append(trailer, sizeof(trailer));
+            }
+
+            _out.resize(_outSize);
+
+            if(_sign)
+            {
+                unsigned char mac[SHA256_DIGEST_SIZE];
+                hmac_sha256_final(&_state->hmac, mac, SHA256_DIGEST_SIZE);
+
+                unsigned char encoded[64] = {};
+                GAUtilities::base64_encode(mac, SHA256_DIGEST_SIZE, encoded);
+
+                _authorization = AUTHORIZATION_PREFIX;
+                _authorization.append(reinterpret_cast<const char*>(encoded));
+            }
+
+            return true;
+        }
+
+        std::vector<uint8_t> const& GAPayloadEncoder::payload() const
+        {
+            return _out;
+        }
+
+        std::vector<uint8_t> GAPayloadEncoder::releasePayload()
+        {
+            std::vector<uint8_t> out = std::move(_out);
+            _out.clear();
+            _outSize = 0;
+            return out;
+        }
+
+        std::string const& GAPayloadEncoder::authorization() const
+        {
+            return _authorization;
+        }
+
+        std::string_view GAPayloadEncoder::signature() const
+        {
+            std::string_view value = _authorization;
+            value.remove_prefix(std::min(AUTHORIZATION_PREFIX.size(), value.size()));
+            return value;
+        }
+
+        std::size_t GAPayloadEncoder::inputSize() const
+        {
+            return _inputSize;
+        }
+    }
+}
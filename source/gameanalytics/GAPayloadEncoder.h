@@ -0,0 +1,74 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+#include "GAJsonWriter.h"
+
+#include <memory>
+#include <string_view>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        // Turns request json into the bytes that are sent in a single pass: the text is gzip
+        // compressed (RFC 1952) straight into a growing output buffer and the HMAC-SHA256
+        // authorization is computed over the compressed bytes as they are produced.
+        // Without a secret key nothing is signed.
+        class GAPayloadEncoder
+        {
+            public:
+
+                static constexpr int DEFAULT_COMPRESSION_LEVEL = 9;
+
+                explicit GAPayloadEncoder(bool gzip, std::string_view secretKey = {}, int compressionLevel = DEFAULT_COMPRESSION_LEVEL);
+                ~GAPayloadEncoder();
+
+                GAPayloadEncoder(GAPayloadEncoder const&) = delete;
+                GAPayloadEncoder& operator=(GAPayloadEncoder const&) = delete;
+
+                void write(std::string_view data);
+
+                // writes what the json writer has buffered and clears it, see GAJsonWriter::discard
+                void write(GAJsonWriter& writer);
+
+                // completes compression and signature, returns false if compression failed
+                bool finish();
+
+                std::vector<uint8_t> const& payload() const;
+                std::vector<uint8_t>        releasePayload();
+
+                // "Authorization: <base64 hmac>", empty without a secret key
+                std::string const& authorization() const;
+
+                // just the base64 hmac of authorization(), the value of the Authorization header
+                std::string_view signature() const;
+
+                // uncompressed bytes written so far
+                std::size_t inputSize() const;
+
+            private:
+
+                struct State;
+
+                void append(const uint8_t* data, std::size_t size);
+                void ensureCapacity(std::size_t extra);
+                void deflateInput(std::string_view data, bool finish);
+
+                std::unique_ptr<State> _state;
+
+                std::vector<uint8_t> _out;
+                std::size_t          _outSize   = 0;
+                std::size_t          _inputSize = 0;
+                std::string          _authorization;
+                bool                 _gzip;
+                bool                 _sign;
+                bool                 _failed    = false;
+                bool                 _finished  = false;
+        };
+    }
+}
@@ -0,0 +1,131 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GARemoteConfigsIndex.h"
+
+#include <algorithm>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        GARemoteConfigsIndex::GARemoteConfigsIndex(json configs):
+            _configs(std::move(configs))
+        {
+            if(!_configs.is_array())
+            {
+                _configs = json::array();
+            }
+
+            _values.reserve(_configs.size());
+
+            for(json const& config : _configs)
+            {
+                if(!config.is_object() || !config.contains("key") || !config.contains("value") || !config["key"].is_string())
+                {
+                    continue;
+                }
+
+                std::string const& key = config["key"].get_ref<std::string const&>();
+
+                // the first one wins, like the linear scan did
+                _values.emplace(std::string_view(key), &config["value"]);
+            }
+        }
+
+        json const* GARemoteConfigsIndex::find(std::string_view key) const
+        {
+            auto itr = _values.find(key);
+            return itr != _values.end() ? itr->second : nullptr;
+        }
+
+        json const& GARemoteConfigsIndex::configs() const
+        {
+            return _configs;
+        }
+
+        std::size_t GARemoteConfigsIndex::size() const
+        {
+            return _values.size();
+        }
+
+        StringVector GARemoteConfigsIndex::changedKeys(GARemoteConfigsIndex const& before, GARemoteConfigsIndex const& after)
+        {
+            StringVector keys;
+
+            for(auto const& [key, value] : after._values)
+            {
+                json const* previous = before.find(key);
+                if(!previous || *previous != *value)
+                {
+                    keys.emplace_back(key);
+                }
+            }
+
+            for(auto const& entry : before._values)
+            {
+                if(!after.find(entry.first))
+                {
+                    keys.emplace_back(entry.first);
+                }
+            }
+
+            std::sort(keys.begin(), keys.end());
+            return keys;
+        }
+
+        namespace
+        {
+            std::atomic<uint64_t> nextPublisherId{1};
+
+            struct CachedIndex
+            {
+                uint64_t                                    publisher = 0;
+                uint64_t                                    version   = 0;
+                std::shared_ptr<const GARemoteConfigsIndex> index;
+            };
+        }
+
+        GARemoteConfigsPublisher::GARemoteConfigsPublisher():
+            _id(nextPublisherId.fetch_add(1, std::memory_order_relaxed)),
+            _index(std::make_shared<const GARemoteConfigsIndex>())
+        {
+        }
+
+        void GARemoteConfigsPublisher::publish(std::shared_ptr<const GARemoteConfigsIndex> index)
+        {
+            if(!index)
+            {
+                index = std::make_shared<const GARemoteConfigsIndex>();
+            }
+
+            std::atomic_store(&_index, std::move(index));
+
+            // readers that see the new version load the new index
+            _version.fetch_add(1, std::memory_order_release);
+        }
+
+        GARemoteConfigsIndex const& GARemoteConfigsPublisher::current() const
+        {
+            thread_local CachedIndex cached;
+
+            const uint64_t version = _version.load(std::memory_order_acquire);
+
+            if(cached.publisher != _id || cached.version != version || !cached.index)
+            {
+                cached.index     = std::atomic_load(&_index);
+                cached.publisher = _id;
+                cached.version   = version;
+            }
+
+            return *cached.index;
+        }
+
+        std::shared_ptr<const GARemoteConfigsIndex> GARemoteConfigsPublisher::load() const
+        {
+            return std::atomic_load(&_index);
+        }
+    }
+}
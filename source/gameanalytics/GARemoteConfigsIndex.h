@@ -0,0 +1,79 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        // The remote configs of one init response as [{"key": ..., "value": ...}], with a hash
+        // index from key to value. Never modified after it is built, so it can be read from
+        // any thread without locking.
+        class GARemoteConfigsIndex
+        {
+            public:
+
+                explicit GARemoteConfigsIndex(json configs = json::array());
+
+                GARemoteConfigsIndex(GARemoteConfigsIndex const&) = delete;
+                GARemoteConfigsIndex& operator=(GARemoteConfigsIndex const&) = delete;
+
+                // nullptr if there is no config with that key
+                json const* find(std::string_view key) const;
+
+                json const& configs() const;
+                std::size_t size() const;
+
+                // keys added, removed or given another value between two indexes, sorted
+                static StringVector changedKeys(GARemoteConfigsIndex const& before, GARemoteConfigsIndex const& after);
+
+            private:
+
+                json _configs;
+
+                // the keys point into _configs
+                std::unordered_map<std::string_view, json const*> _values;
+        };
+
+        // Hands out the current GARemoteConfigsIndex, RCU style: the GA thread publishes a new
+        // index with an atomic shared_ptr store and bumps a version. Readers keep the index they
+        // saw last in a thread local, so once a thread has seen the latest version a read is one
+        // atomic load, without locks or reference counting. Old indexes are freed when the last
+        // thread holding one moves on.
+        class GARemoteConfigsPublisher
+        {
+            public:
+
+                GARemoteConfigsPublisher();
+
+                GARemoteConfigsPublisher(GARemoteConfigsPublisher const&) = delete;
+                GARemoteConfigsPublisher& operator=(GARemoteConfigsPublisher const&) = delete;
+
+                void publish(std::shared_ptr<const GARemoteConfigsIndex> index);
+
+                // valid until the calling thread calls current() again
+                GARemoteConfigsIndex const& current() const;
+
+                // for holding on to an index longer
+                std::shared_ptr<const GARemoteConfigsIndex> load() const;
+
+            private:
+
+                // tells publishers apart in the thread local cache
+                const uint64_t _id;
+
+                std::shared_ptr<const GARemoteConfigsIndex> _index;
+                std::atomic<uint64_t>                       _version{0};
+        };
+    }
+}
@@ -0,0 +1,271 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GARemoteConfigsRegistry.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        namespace
+        {
+            bool parseInteger(json const& value, int64_t& out)
+            {
+                if(value.is_number_integer())
+                {
+                    out = value.get<int64_t>();
+                    return true;
+                }
+
+                if(!value.is_string())
+                {
+                    return false;
+                }
+
+                std::string const& text = value.get_ref<std::string const&>();
+                if(text.empty())
+                {
+                    return false;
+                }
+
+                char* end = nullptr;
+                errno = 0;
+                const long long parsed = std::strtoll(text.c_str(), &end, 10);
+                if(errno != 0 || end != text.c_str() + text.size())
+                {
+                    return false;
+                }
+
+                out = static_cast<int64_t>(parsed);
+                return true;
+            }
+
+            bool parseFloatingPoint(json const& value, double& out)
+            {
+                if(value.is_number())
+                {
+                    out = value.get<double>();
+                    return true;
+                }
+
+                if(!value.is_string())
+                {
+                    return false;
+                }
+
+                std::string const& text = value.get_ref<std::string const&>();
+                if(text.empty())
+                {
+                    return false;
+                }
+
+                char* end = nullptr;
+                errno = 0;
+                const double parsed = std::strtod(text.c_str(), &end);
+                if(errno != 0 || end != text.c_str() + text.size())
+                {
+                    return false;
+                }
+
+                out = parsed;
+                return true;
+            }
+        }
+
+        bool parseRemoteConfigValue(json const& value, int64_t& out)
+        {
+            return parseInteger(value, out);
+        }
+
+        bool parseRemoteConfigValue(json const& value, int& out)
+        {
+            int64_t parsed = 0;
+            if(!parseInteger(value, parsed) || parsed < std::numeric_limits<int>::min() || parsed > std::numeric_limits<int>::max())
+            {
+                return false;
+            }
+
+            out = static_cast<int>(parsed);
+            return true;
+        }
+
+        bool parseRemoteConfigValue(json const& value, double& out)
+        {
+            return parseFloatingPoint(value, out);
+        }
+
+        bool parseRemoteConfigValue(json const& value, float& out)
+        {
+            double parsed = 0.0;
+            if(!parseFloatingPoint(value, parsed))
+            {
+                return false;
+            }
+
+            out = static_cast<float>(parsed);
+            return true;
+        }
+
+        bool parseRemoteConfigValue(json const& value, bool& out)
+        {
+            if(value.is_boolean())
+            {
+                out = value.get<bool>();
+                return true;
+            }
+
+            if(value.is_number_integer() && (value == 0 || value == 1))
+            {
+                out = value == 1;
+                return true;
+            }
+
+            if(value.is_string())
+            {
+                std::string const& text = value.get_ref<std::string const&>();
+                if(text == "true" || text == "1")
+                {
+                    out = true;
+                    return true;
+                }
+                if(text == "false" || text == "0")
+                {
+                    out = false;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // like getRemoteConfigsValueAsString, only string values are read
+        bool parseRemoteConfigValue(json const& value, std::string& out)
+        {
+            if(!value.is_string())
+            {
+                return false;
+            }
+
+            out = value.get<std::string>();
+            return true;
+        }
+
+        void GARemoteConfigsRegistry::addListener(StringVector const& keys, std::shared_ptr<IRemoteConfigsKeyListener> const& listener)
+        {
+            if(!listener)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto itr = std::find_if(_subscriptions.begin(), _subscriptions.end(), [&](Subscription const& s) { return s.listener == listener; });
+            if(itr == _subscriptions.end())
+            {
+                _subscriptions.push_back({{}, listener});
+                itr = _subscriptions.end() - 1;
+            }
+
+            // adding the same listener again replaces its keys
+            itr->keys = std::unordered_set<std::string>(keys.begin(), keys.end());
+        }
+
+        void GARemoteConfigsRegistry::removeListener(std::shared_ptr<IRemoteConfigsKeyListener> const& listener)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _subscriptions.erase(
+                std::remove_if(_subscriptions.begin(), _subscriptions.end(), [&](Subscription const& s) { return s.listener == listener; }),
+                _subscriptions.end()
+            );
+        }
+
+        void GARemoteConfigsRegistry::update(GARemoteConfigsIndex const& index, StringVector const& changedKeys)
+        {
+            std::vector<std::pair<std::shared_ptr<IRemoteConfigsKeyListener>, StringVector>> notifications;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                for(std::string const& key : changedKeys)
+                {
+                    auto itr = _bindings.find(key);
+                    if(itr == _bindings.end())
+                    {
+                        continue;
+                    }
+
+                    pruneExpired(itr->second);
+                    if(itr->second.empty())
+                    {
+                        _bindings.erase(itr);
+                        continue;
+                    }
+
+                    json const* value = index.find(key);
+                    for(Binding const& binding : itr->second)
+                    {
+                        binding.store(value);
+                    }
+                }
+
+                for(Subscription const& subscription : _subscriptions)
+                {
+                    StringVector keys;
+                    for(std::string const& key : changedKeys)
+                    {
+                        if(subscription.keys.empty() || subscription.keys.count(key))
+                        {
+                            keys.push_back(key);
+                        }
+                    }
+
+                    if(!keys.empty())
+                    {
+                        notifications.emplace_back(subscription.listener, std::move(keys));
+                    }
+                }
+            }
+
+            // outside the lock, listeners may bind handles or change their subscription
+            for(auto const& [listener, keys] : notifications)
+            {
+                listener->onRemoteConfigsChanged(keys);
+            }
+        }
+
+        std::size_t GARemoteConfigsRegistry::boundCount() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            std::size_t count = 0;
+            for(auto const& entry : _bindings)
+            {
+                count += std::count_if(entry.second.begin(), entry.second.end(), [](Binding const& b) { return !b.handle.expired(); });
+            }
+            return count;
+        }
+
+        void GARemoteConfigsRegistry::store(RemoteConfigState<std::string>& state, std::string value)
+        {
+            if(*std::atomic_load(&state.value) != value)
+            {
+                std::atomic_store(&state.value, std::make_shared<const std::string>(std::move(value)));
+                state.version.fetch_add(1, std::memory_order_release);
+            }
+        }
+
+        void GARemoteConfigsRegistry::pruneExpired(std::vector<Binding>& bindings)
+        {
+            bindings.erase(
+                std::remove_if(bindings.begin(), bindings.end(), [](Binding const& b) { return b.handle.expired(); }),
+                bindings.end()
+            );
+        }
+    }
+}
@@ -0,0 +1,120 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+#include "GARemoteConfigsIndex.h"
+#include "GameAnalytics/GARemoteConfig.h"
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace gameanalytics
+{
+    namespace state
+    {
+        // Read a config value into out. Strings are parsed, e.g. "25" for an int or "true" for a bool,
+        // since that is how the configs usually arrive. False if the value can't be read as that type
+        bool parseRemoteConfigValue(json const& value, bool& out);
+        bool parseRemoteConfigValue(json const& value, int& out);
+        bool parseRemoteConfigValue(json const& value, int64_t& out);
+        bool parseRemoteConfigValue(json const& value, float& out);
+        bool parseRemoteConfigValue(json const& value, double& out);
+        bool parseRemoteConfigValue(json const& value, std::string& out);
+
+        // The RemoteConfig handles bound to keys and the listeners subscribed to keys. After each
+        // update it stores the parsed values of the changed keys in their handles and tells the
+        // listeners which of their keys changed.
+        class GARemoteConfigsRegistry
+        {
+            public:
+
+                GARemoteConfigsRegistry() = default;
+
+                GARemoteConfigsRegistry(GARemoteConfigsRegistry const&) = delete;
+                GARemoteConfigsRegistry& operator=(GARemoteConfigsRegistry const&) = delete;
+
+                // a handle with the current value of key in configs, kept up to date by update()
+                template<typename T>
+                RemoteConfig<T> bind(std::string const& key, T const& defaultValue, GARemoteConfigsPublisher const& configs)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    auto state = std::make_shared<RemoteConfigState<T>>(parse(configs.current().find(key), defaultValue));
+
+                    std::weak_ptr<RemoteConfigState<T>> weak = state;
+
+                    Binding binding;
+                    binding.handle = weak;
+                    binding.store  = [weak, defaultValue](json const* value)
+                    {
+                        if(std::shared_ptr<RemoteConfigState<T>> current = weak.lock())
+                        {
+                            store(*current, parse(value, defaultValue));
+                        }
+                    };
+
+                    std::vector<Binding>& bindings = _bindings[key];
+                    pruneExpired(bindings);
+                    bindings.push_back(std::move(binding));
+
+                    return RemoteConfig<T>(key, std::move(state));
+                }
+
+                // an empty keys list subscribes to every key
+                void addListener(StringVector const& keys, std::shared_ptr<IRemoteConfigsKeyListener> const& listener);
+                void removeListener(std::shared_ptr<IRemoteConfigsKeyListener> const& listener);
+
+                // call after index is published, with the keys that changed since the previous one
+                void update(GARemoteConfigsIndex const& index, StringVector const& changedKeys);
+
+                // handles that are still held somewhere
+                std::size_t boundCount() const;
+
+            private:
+
+                struct Binding
+                {
+                    std::weak_ptr<void>              handle;
+                    std::function<void(json const*)> store;
+                };
+
+                struct Subscription
+                {
+                    std::unordered_set<std::string>            keys;
+                    std::shared_ptr<IRemoteConfigsKeyListener> listener;
+                };
+
+                template<typename T>
+                static T parse(json const* value, T const& defaultValue)
+                {
+                    T parsed{};
+                    return value && parseRemoteConfigValue(*value, parsed) ? parsed : defaultValue;
+                }
+
+                // the version only goes up when the value is different
+                template<typename T>
+                static void store(RemoteConfigState<T>& state, T value)
+                {
+                    if(state.value.load(std::memory_order_relaxed) != value)
+                    {
+                        state.value.store(value, std::memory_order_release);
+                        state.version.fetch_add(1, std::memory_order_release);
+                    }
+                }
+
+                static void store(RemoteConfigState<std::string>& state, std::string value);
+
+                static void pruneExpired(std::vector<Binding>& bindings);
+
+                mutable std::mutex                                    _mutex;
+                std::unordered_map<std::string, std::vector<Binding>> _bindings;
+                std::vector<Subscription>                             _subscriptions;
+        };
+    }
+}
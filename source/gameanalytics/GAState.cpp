@@ -13,6 +13,8 @@
 #include "GALogger.h"
 #include "GADevice.h"
 #include "GAThreading.h"
+#include "GAPattern.h"
+#include "GAJsonWriter.h"
 #include <utility>
 #include <algorithm>
 #include <array>
@@ -27,19 +29,47 @@ namespace gameanalytics
     namespace state
     {
         GAState GAState::instance;
+
+        thread_local PlayerState* GAState::_activePlayer = nullptr;
         
         GAState& GAState::getInstance()
         {
             return instance;
         }
 
+        bool PlayerState::sessionIsStarted() const
+        {
+            return sessionStart != 0;
+        }
+
+        int64_t PlayerState::sessionLength() const
+        {
+            return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - startTimepoint).count();
+        }
+
+        GAState::PlayerScope::PlayerScope(PlayerState& player):
+            _previous(_activePlayer)
+        {
+            _activePlayer = &player;
+        }
+
+        GAState::PlayerScope::~PlayerScope()
+        {
+            _activePlayer = _previous;
+        }
+
+        PlayerState* GAState::getActivePlayer()
+        {
+            return _activePlayer;
+        }
+
         GAState::GAState()
         {
         }
 
         GAState::~GAState()
         {
-            _gaLogger.customLogHandler.reset();
+            _gaLogger.resetCustomLogHandler();
 
             _gaThread.queueBlock(
                 [this]()
@@ -65,11 +95,19 @@ namespace gameanalytics
 
         std::string GAState::getUserId()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->userId;
+            }
             return getInstance()._identifier;
         }
 
         std::string GAState::getExternalUserId()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->externalUserId;
+            }
             return getInstance()._externalUserId;
         }
 
@@ -80,16 +118,28 @@ namespace gameanalytics
 
         int64_t GAState::getSessionStart()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->sessionStart;
+            }
             return getInstance()._sessionStart;
         }
 
         int64_t GAState::getSessionNum()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->sessionNum;
+            }
             return getInstance()._sessionNum;
         }
 
         int64_t GAState::getTransactionNum()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->transactionNum;
+            }
             return getInstance()._transactionNum;
         }
     
@@ -100,21 +150,37 @@ namespace gameanalytics
 
         std::string GAState::getSessionId()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->sessionId;
+            }
             return getInstance()._sessionId;
         }
 
         std::string GAState::getCurrentCustomDimension01()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->dimensions[0];
+            }
             return getInstance()._currentCustomDimension01;
         }
 
         std::string GAState::getCurrentCustomDimension02()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->dimensions[1];
+            }
             return getInstance()._currentCustomDimension02;
         }
 
         std::string GAState::getCurrentCustomDimension03()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->dimensions[2];
+            }
             return getInstance()._currentCustomDimension03;
         }
 
@@ -123,6 +189,11 @@ namespace gameanalytics
             out.merge_patch(getInstance()._currentGlobalCustomEventFields);
         }
 
+        std::shared_ptr<const std::string> GAState::getGlobalCustomEventFieldsMembers()
+        {
+            return getInstance()._currentGlobalCustomEventFieldsMembers;
+        }
+
         void GAState::setAvailableCustomDimensions01(const StringVector& availableCustomDimensions)
         {
             // Validate
@@ -130,12 +201,12 @@ namespace gameanalytics
             {
                 return;
             }
-            getInstance()._availableCustomDimensions01 = availableCustomDimensions;
+            getInstance()._availableCustomDimensions01.assign(availableCustomDimensions);
 
             // validate current dimension values
             getInstance().validateAndFixCurrentDimensions();
 
-            logging::GALogger::i("Set available custom01 dimension values: (%s)", utilities::printArray(availableCustomDimensions).c_str());
+            GA_LOG_INFO("Set available custom01 dimension values: (%s)", utilities::printArray(availableCustomDimensions).c_str());
         }
 
         void GAState::setAvailableCustomDimensions02(const StringVector& availableCustomDimensions)
@@ -145,12 +216,12 @@ namespace gameanalytics
             {
                 return;
             }
-            getInstance()._availableCustomDimensions02 = availableCustomDimensions;
+            getInstance()._availableCustomDimensions02.assign(availableCustomDimensions);
 
             // validate current dimension values
             getInstance().validateAndFixCurrentDimensions();
 
-            logging::GALogger::i("Set available custom02 dimension values: (%s)", utilities::printArray(availableCustomDimensions).c_str());
+            GA_LOG_INFO("Set available custom02 dimension values: (%s)", utilities::printArray(availableCustomDimensions).c_str());
         }
 
         void GAState::setAvailableCustomDimensions03(const StringVector& availableCustomDimensions)
@@ -160,12 +231,12 @@ namespace gameanalytics
             {
                 return;
             }
-            getInstance()._availableCustomDimensions03 = availableCustomDimensions;
+            getInstance()._availableCustomDimensions03.assign(availableCustomDimensions);
 
             // validate current dimension values
             getInstance().validateAndFixCurrentDimensions();
 
-            logging::GALogger::i("Set available custom03 dimension values: (%s)", utilities::printArray(availableCustomDimensions).c_str());
+            GA_LOG_INFO("Set available custom03 dimension values: (%s)", utilities::printArray(availableCustomDimensions).c_str());
         }
 
         void GAState::setAvailableResourceCurrencies(const StringVector& availableResourceCurrencies)
@@ -174,9 +245,9 @@ namespace gameanalytics
             if (!validators::GAValidator::validateResourceCurrencies(availableResourceCurrencies)) {
                 return;
             }
-            getInstance()._availableResourceCurrencies = availableResourceCurrencies;
+            getInstance()._availableResourceCurrencies.assign(availableResourceCurrencies);
 
-            logging::GALogger::i("Set available resource currencies: (%s)", utilities::printArray(availableResourceCurrencies).c_str());
+            GA_LOG_INFO("Set available resource currencies: (%s)", utilities::printArray(availableResourceCurrencies).c_str());
         }
 
         void GAState::setAvailableResourceItemTypes(const StringVector& availableResourceItemTypes)
@@ -185,9 +256,9 @@ namespace gameanalytics
             if (!validators::GAValidator::validateResourceItemTypes(availableResourceItemTypes)) {
                 return;
             }
-            getInstance()._availableResourceItemTypes = availableResourceItemTypes;
+            getInstance()._availableResourceItemTypes.assign(availableResourceItemTypes);
 
-            logging::GALogger::i("Set available resource item types: (%s)", utilities::printArray(availableResourceItemTypes).c_str());
+            GA_LOG_INFO("Set available resource item types: (%s)", utilities::printArray(availableResourceItemTypes).c_str());
         }
 
         void GAState::setBuild(std::string const& build)
@@ -228,6 +299,7 @@ namespace gameanalytics
             {
                 store::GAStore::setState("dimension01", dimension.c_str());
             }
+            events::GAEvents::invalidateSessionSnapshot();
             logging::GALogger::i("Set custom01 dimension value: %s", dimension.c_str());
         }
 
@@ -238,6 +310,7 @@ namespace gameanalytics
             {
                 store::GAStore::setState("dimension02", dimension.c_str());
             }
+            events::GAEvents::invalidateSessionSnapshot();
             logging::GALogger::i("Set custom02 dimension value: %s", dimension.c_str());
         }
 
@@ -248,6 +321,7 @@ namespace gameanalytics
             {
                 store::GAStore::setState("dimension03", dimension.c_str());
             }
+            events::GAEvents::invalidateSessionSnapshot();
             logging::GALogger::i("Set custom03 dimension value: %s", dimension.c_str());
         }
 
@@ -255,7 +329,24 @@ namespace gameanalytics
         {
             try
             {
-                getInstance()._currentGlobalCustomEventFields = json::parse(customFields);
+                GAState& state = getInstance();
+
+                json validated;
+                state.validateAndCleanCustomFields(json::parse(customFields), validated);
+
+                std::string members;
+                if(validated.is_object() && !validated.empty())
+                {
+                    utilities::GAJsonWriter writer;
+                    writer.value(validated);
+
+                    // without the braces, so the members can be spliced into custom_fields
+                    members = writer.str().substr(1, writer.size() - 2);
+                }
+
+                state._currentGlobalCustomEventFields        = std::move(validated);
+                state._currentGlobalCustomEventFieldsMembers = std::make_shared<const std::string>(std::move(members));
+                events::GAEvents::invalidateSessionSnapshot();
                 logging::GALogger::i("Set global custom event fields: %s", customFields.c_str());
             }
             catch(std::exception& e)
@@ -266,16 +357,32 @@ namespace gameanalytics
 
         void GAState::incrementSessionNum()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                player->sessionNum++;
+                return;
+            }
             getInstance()._sessionNum++;
         }
 
         void GAState::incrementTransactionNum()
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                player->transactionNum++;
+                return;
+            }
             getInstance()._transactionNum++;
         }
 
         void GAState::incrementProgressionTries(std::string const& progression)
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                player->progressionTries.incrementTries(progression);
+                return;
+            }
+
             int tries = getInstance()._progressionTries.incrementTries(progression);
 
             // Persist
@@ -287,11 +394,21 @@ namespace gameanalytics
 
         int GAState::getProgressionTries(std::string const& progression)
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                return player->progressionTries.getTries(progression);
+            }
             return getInstance()._progressionTries.getTries(progression);
         }
 
         void GAState::clearProgressionTries(std::string const& progression)
         {
+            if(PlayerState* player = getActivePlayer())
+            {
+                player->progressionTries.remove(progression);
+                return;
+            }
+
             getInstance()._progressionTries.remove(progression);
 
             // Delete
@@ -299,30 +416,29 @@ namespace gameanalytics
             store::GAStore::executeQuerySync("DELETE FROM ga_progression WHERE progression = ?;", parms);
         }
 
-        bool GAState::hasAvailableCustomDimensions01(std::string const& dimension1)
+        bool GAState::hasAvailableCustomDimensions01(std::string_view dimension1)
         {
-            return utilities::GAUtilities::stringVectorContainsString(getInstance()._availableCustomDimensions01, dimension1);
+            return getInstance()._availableCustomDimensions01.contains(dimension1);
         }
 
-        bool GAState::hasAvailableCustomDimensions02(std::string const& dimension2)
+        bool GAState::hasAvailableCustomDimensions02(std::string_view dimension2)
         {
-            return utilities::GAUtilities::stringVectorContainsString(
-                getInstance()._availableCustomDimensions02, dimension2);
+            return getInstance()._availableCustomDimensions02.contains(dimension2);
         }
 
-        bool GAState::hasAvailableCustomDimensions03(std::string const& dimension3)
+        bool GAState::hasAvailableCustomDimensions03(std::string_view dimension3)
         {
-            return utilities::GAUtilities::stringVectorContainsString(getInstance()._availableCustomDimensions03, dimension3);
+            return getInstance()._availableCustomDimensions03.contains(dimension3);
         }
 
-        bool GAState::hasAvailableResourceCurrency(std::string const& currency)
+        bool GAState::hasAvailableResourceCurrency(std::string_view currency)
         {
-            return utilities::GAUtilities::stringVectorContainsString(getInstance()._availableResourceCurrencies, currency);
+            return getInstance()._availableResourceCurrencies.contains(currency);
         }
 
-        bool GAState::hasAvailableResourceItemType(std::string const& itemType)
+        bool GAState::hasAvailableResourceItemType(std::string_view itemType)
         {
-            return utilities::GAUtilities::stringVectorContainsString(getInstance()._availableResourceItemTypes, itemType);
+            return getInstance()._availableResourceItemTypes.contains(itemType);
         }
 
         void GAState::setKeys(std::string const& gameKey, std::string const& gameSecret)
@@ -385,7 +501,11 @@ namespace gameanalytics
                 logging::GALogger::i("Ending session.");
                 if (GAState::isEnabled() && GAState::sessionIsStarted())
                 {
+                    // keep the recovery data fresh in case we are killed while suspended
+                    events::GAEvents::writeSessionHeartbeat();
+
                     getInstance().updateTotalSessionTime();
+                    events::GAEvents::flushAggregatedDesignEvents();
                     events::GAEvents::addHealthEvent();
                     events::GAEvents::addSessionEndEvent();
                     getInstance()._sessionStart = 0;
@@ -400,52 +520,72 @@ namespace gameanalytics
         }
 
         void GAState::getEventAnnotations(json& out)
+        {
+            events::EventAnnotations annotations;
+            getEventAnnotations(annotations);
+
+            try
+            {
+                annotations.toJson(out);
+            }
+            catch (json::exception const& e)
+            {
+                logging::GALogger::e("getEventAnnotations - json error: %s", e.what());
+            }
+        }
+
+        void GAState::getEventAnnotations(events::EventAnnotations& out)
         {
             try
             {
                 // ---- REQUIRED ---- //
 
-                // collector event API version
-                out["v"] = 2;
-                out["event_uuid"] = utilities::GAUtilities::generateUUID();
+                out.eventUuid = utilities::GAUtilities::generateUUID();
                 
                 // User identifier
-                out["user_id"] = getUserId();
+                out.userId = getUserId();
                 
                 // remote configs configurations
                 if(getInstance()._trackingRemoteConfigsJson.is_array() && !getInstance()._trackingRemoteConfigsJson.empty())
                 {
-                    out["configurations_v3"] = getInstance().getRemoteConfigAnnotations();
+                    out.configurations = getInstance().getRemoteConfigAnnotations();
                 }
 
-                out["sdk_version"] = device::GADevice::getRelevantSdkVersion();
-                out["client_ts"] = utilities::GAUtilities::timeIntervalSince1970();
-                out["os_version"] = device::GADevice::getOSVersion();
-                out["manufacturer"] = device::GADevice::getDeviceManufacturer();
-                out["device"] = device::GADevice::getDeviceModel();
-                out["platform"] = device::GADevice::getBuildPlatform();
-                out["session_id"] = getInstance()._sessionId;
-                out["session_num"] = getInstance()._sessionNum;
-                out["connection_type"] = device::GADevice::getConnectionType();
+                out.sdkVersion      = device::GADevice::getRelevantSdkVersion();
+                out.clientTs        = utilities::GAUtilities::timeIntervalSince1970();
+                out.osVersion       = device::GADevice::getOSVersion();
+                out.manufacturer    = device::GADevice::getDeviceManufacturer();
+                out.device          = device::GADevice::getDeviceModel();
+                out.platform        = device::GADevice::getBuildPlatform();
+                out.sessionId       = getSessionId();
+                out.sessionNum      = getSessionNum();
+                out.connectionType  = device::GADevice::getConnectionType();
 
                 // playtime metrics
-                out["current_session_length"] = getInstance().calculateSessionLength();
-                out["lifetime_session_length"] = getInstance().getTotalSessionLength();
+                if(PlayerState* player = getActivePlayer())
+                {
+                    out.currentSessionLength  = player->sessionLength();
+                    out.lifetimeSessionLength = player->totalSessionLength + out.currentSessionLength;
+                }
+                else
+                {
+                    out.currentSessionLength  = getInstance().calculateSessionLength();
+                    out.lifetimeSessionLength = getInstance().getTotalSessionLength();
+                }
 
                 // ---- OPTIONAL ---- //
 
                 // A/B testing
-                utilities::addIfNotEmpty(out, "ab_id", getInstance()._abId);
-                utilities::addIfNotEmpty(out, "ab_variant_id", getInstance()._abVariantId);
-                
-                utilities::addIfNotEmpty(out, "user_id_ext", getInstance()._externalUserId);
+                out.abId            = getInstance()._abId;
+                out.abVariantId     = getInstance()._abVariantId;
+                out.externalUserId  = getExternalUserId();
 
-                utilities::addIfNotEmpty(out, "build", getInstance()._build);
-                utilities::addIfNotEmpty(out, "engine_version", device::GADevice::getGameEngineVersion());
+                out.build           = getInstance()._build;
+                out.engineVersion   = device::GADevice::getGameEngineVersion();
 
 #if USE_UWP
-                utilities::addIfNotEmpty(out, "uwp_aid", device::GADevice::getAdvertisingId());
-                utilities::addIfNotEmpty(out, "uwp_id", device::GADevice::getDeviceId());
+                out.uwpAid          = device::GADevice::getAdvertisingId();
+                out.uwpId           = device::GADevice::getDeviceId();
 #endif
             }
             catch (json::exception const& e)
@@ -572,8 +712,7 @@ namespace gameanalytics
                     }
                 }
                 
-                std::string s = state_dict.dump();
-                _gaLogger.d("state_dict: %s", s.c_str());
+                GA_LOG_DEBUG("state_dict: %s", state_dict.dump().c_str());
 
                 // insert into GAState instance
                 std::string defaultId = utilities::getOptionalValue<std::string>(state_dict, "default_user_id");
@@ -687,130 +826,37 @@ namespace gameanalytics
                 // make sure the current custom dimensions are valid
                 GAState::validateAndFixCurrentDimensions();
 
-                // call the init call
-                http::GAHTTPApi& httpApi = http::GAHTTPApi::getInstance();
-
-                json initResponseDict;
-                http::EGAHTTPApiResponse initResponse = httpApi.requestInitReturningDict(initResponseDict, _configsHash);
+                // with the config of an earlier session the session starts right away and the init
+                // call refreshes it in the background, otherwise (first launch, or the sdk was
+                // disabled last time) wait for the init call
+                const bool startFromCache = _sdkConfigCached.is_object() && !_sdkConfigCached.empty() &&
+                    utilities::getOptionalValue<bool>(_sdkConfigCached, "enabled", true);
 
-                // init is ok
-                if ((initResponse == http::Ok || initResponse == http::Created) && !initResponseDict.empty())
+                if (startFromCache)
                 {
-                    // set the time offset - how many seconds the local time is different from servertime
-                    int64_t timeOffsetSeconds = 0;
-                    int64_t server_ts = utilities::getOptionalValue<int64_t>(initResponseDict, "server_ts", -1ll);
-                    if (server_ts > 0)
-                    {
-                        timeOffsetSeconds = calculateServerTimeOffset(server_ts);
-                    }
+                    logging::GALogger::i("Starting session with cached init values, refreshing them in the background.");
 
-                    // insert timeOffset in received init config (so it can be used when offline)
-                    initResponseDict["time_offset"] = timeOffsetSeconds;
+                    std::lock_guard<std::recursive_mutex> lg(_mtx);
 
-                    if (initResponse != http::Created)
+                    if (_sdkConfig.empty())
                     {
-                        json& currentSdkConfig = GAState::getSdkConfig();
-
-                        // use cached if not Created
-                        if (currentSdkConfig.contains("configs") && currentSdkConfig["configs"].is_array())
-                        {
-                            initResponseDict["configs"].merge_patch(currentSdkConfig["configs"]);
-                        }
-                        if (currentSdkConfig.contains("configs_hash") && currentSdkConfig["configs_hash"].is_string())
-                        {
-                            initResponseDict["configs_hash"] = currentSdkConfig["configs_hash"];
-                        }
-                        if (currentSdkConfig.contains("ab_id") && currentSdkConfig["ab_id"].is_string())
-                        {
-                            initResponseDict["ab_id"] = currentSdkConfig["ab_id"];
-                        }
-                        if (currentSdkConfig.contains("ab_variant_id") && currentSdkConfig["ab_variant_id"].is_string())
-                        {
-                            initResponseDict["ab_variant_id"] = currentSdkConfig["ab_variant_id"];
-                        }
+                        _sdkConfig = _sdkConfigCached;
                     }
-
-                    _configsHash = utilities::getOptionalValue<std::string>(initResponseDict, "configs_hash");
-                    _abId        = utilities::getOptionalValue<std::string>(initResponseDict, "ab_id");
-                    _abVariantId = utilities::getOptionalValue<std::string>(initResponseDict, "ab_variant_id");
-
-                    // insert new config in sql lite cross session storage
-                    store::GAStore::setState("sdk_config_cached", initResponseDict.dump());
-
-                    // set new config and cache in memory
-                    _sdkConfigCached.merge_patch(initResponseDict);
-                    _sdkConfig.merge_patch(initResponseDict);
-
                     _initAuthorized = true;
-                }
-                else if (initResponse == http::Unauthorized) 
-                {
-                    logging::GALogger::w("Initialize SDK failed - Unauthorized");
-                    _initAuthorized = false;
+
+                    applySdkConfig();
                 }
                 else
                 {
-                    // log the status if no connection
-                    if (initResponse == http::NoResponse || initResponse == http::RequestTimeout)
-                    {
-                        logging::GALogger::i("Init call (session start) failed - no response. Could be offline or timeout.");
-                    }
-                    else if (initResponse == http::BadResponse || initResponse == http::JsonEncodeFailed || initResponse == http::JsonDecodeFailed)
-                    {
-                        logging::GALogger::i("Init call (session start) failed - bad response. Could be bad response from proxy or GA servers.");
-                    }
-                    else if (initResponse == http::BadRequest || initResponse == http::UnknownResponseCode)
-                    {
-                        logging::GALogger::i("Init call (session start) failed - bad request or unknown response.");
-                    }
-
-                    // init call failed (perhaps offline)
-                    if (_sdkConfig.empty())
-                    {
-                        if (!_sdkConfigCached.empty())
-                        {
-                            logging::GALogger::i("Init call (session start) failed - using cached init values.");
-
-                            // set last cross session stored config init values
-                            _sdkConfig = _sdkConfigCached;
-                        }
-                        else
-                        {
-                            logging::GALogger::i("Init call (session start) failed - using default init values.");
+                    json initResponseDict;
+                    http::EGAHTTPApiResponse initResponse = http::GAHTTPApi::getInstance().requestInitReturningDict(initResponseDict, _configsHash);
 
-                            // set default init values
-                           _sdkConfig = _sdkConfigDefault;
-                        }
-                    }
-                    else
-                    {
-                        logging::GALogger::i("Init call (session start) failed - using cached init values.");
-                    }
-                    _initAuthorized = true;
-                }
+                    std::lock_guard<std::recursive_mutex> lg(_mtx);
 
-                json& currentSdkConfig = GAState::getSdkConfig();
-                {
-                    if (!utilities::getOptionalValue<bool>(currentSdkConfig, "enabled", true))
-                    {
-                        _enabled = false;
-                    }
-                    else if (!_initAuthorized)
-                    {
-                        _enabled = false;
-                    }
-                    else
-                    {
-                        _enabled = true;
-                    }
+                    applyInitResponse(initResponse, initResponseDict);
+                    applySdkConfig();
                 }
 
-                // set offset in state (memory) from current config (config could be from cache etc.)
-                _clientServerTimeOffset = utilities::getOptionalValue(currentSdkConfig, "time_offset", 0ll);
-
-                // populate configurations
-                populateConfigurations(currentSdkConfig);
-
                 // if SDK is disabled in config
                 if (!GAState::isEnabled())
                 {
@@ -837,8 +883,15 @@ namespace gameanalytics
                 // to acurrately measure time
                 _startTimepoint = std::chrono::high_resolution_clock::now();
 
+                events::GAEvents::invalidateSessionSnapshot();
+
                 // Add session start event
                 events::GAEvents::addSessionStartEvent();
+
+                if (startFromCache)
+                {
+                    refreshInitConfig();
+                }
             }
             catch (json::exception& e)
             {
@@ -850,6 +903,172 @@ namespace gameanalytics
             }
         }
 
+        void GAState::refreshInitConfig()
+        {
+            if (_initRequestPending)
+            {
+                return;
+            }
+            _initRequestPending = true;
+
+            http::GAHTTPApi::getInstance().requestInitAsync(_configsHash,
+                [](http::EGAHTTPApiResponse initResponse, json initResponseDict)
+                {
+                    GAState& state = getInstance();
+                    state._initRequestPending = false;
+
+                    try
+                    {
+                        // the new time offset, configs and ab ids become visible together
+                        std::lock_guard<std::recursive_mutex> lg(state._mtx);
+
+                        state.applyInitResponse(initResponse, initResponseDict);
+                        state.applySdkConfig();
+
+                        // the session row carries the ab ids and configurations
+                        events::GAEvents::invalidateSessionSnapshot();
+                    }
+                    catch (json::exception& e)
+                    {
+                        logging::GALogger::e("refreshInitConfig - Failed to parse json: %s", e.what());
+                    }
+                    catch (std::exception& e)
+                    {
+                        logging::GALogger::e("refreshInitConfig - Exception thrown: %s", e.what());
+                    }
+
+                    if (!GAState::isEnabled())
+                    {
+                        logging::GALogger::w("SDK disabled by init call, stopping the event queue.");
+                        events::GAEvents::stopEventQueue();
+                    }
+                });
+        }
+
+        void GAState::applyInitResponse(http::EGAHTTPApiResponse initResponse, json& initResponseDict)
+        {
+            // init is ok
+            if ((initResponse == http::Ok || initResponse == http::Created) && !initResponseDict.empty())
+            {
+                // set the time offset - how many seconds the local time is different from servertime
+                int64_t timeOffsetSeconds = 0;
+                int64_t server_ts = utilities::getOptionalValue<int64_t>(initResponseDict, "server_ts", -1ll);
+                if (server_ts > 0)
+                {
+                    timeOffsetSeconds = calculateServerTimeOffset(server_ts);
+                }
+
+                // insert timeOffset in received init config (so it can be used when offline)
+                initResponseDict["time_offset"] = timeOffsetSeconds;
+
+                if (initResponse != http::Created)
+                {
+                    json& currentSdkConfig = GAState::getSdkConfig();
+
+                    // use cached if not Created
+                    if (currentSdkConfig.contains("configs") && currentSdkConfig["configs"].is_array())
+                    {
+                        initResponseDict["configs"].merge_patch(currentSdkConfig["configs"]);
+                    }
+                    if (currentSdkConfig.contains("configs_hash") && currentSdkConfig["configs_hash"].is_string())
+                    {
+                        initResponseDict["configs_hash"] = currentSdkConfig["configs_hash"];
+                    }
+                    if (currentSdkConfig.contains("ab_id") && currentSdkConfig["ab_id"].is_string())
+                    {
+                        initResponseDict["ab_id"] = currentSdkConfig["ab_id"];
+                    }
+                    if (currentSdkConfig.contains("ab_variant_id") && currentSdkConfig["ab_variant_id"].is_string())
+                    {
+                        initResponseDict["ab_variant_id"] = currentSdkConfig["ab_variant_id"];
+                    }
+                }
+
+                _configsHash = utilities::getOptionalValue<std::string>(initResponseDict, "configs_hash");
+                _abId        = utilities::getOptionalValue<std::string>(initResponseDict, "ab_id");
+                _abVariantId = utilities::getOptionalValue<std::string>(initResponseDict, "ab_variant_id");
+
+                // insert new config in sql lite cross session storage
+                store::GAStore::setState("sdk_config_cached", initResponseDict.dump());
+
+                // set new config and cache in memory
+                _sdkConfigCached.merge_patch(initResponseDict);
+                _sdkConfig.merge_patch(initResponseDict);
+
+                _initAuthorized = true;
+            }
+            else if (initResponse == http::Unauthorized) 
+            {
+                logging::GALogger::w("Initialize SDK failed - Unauthorized");
+                _initAuthorized = false;
+            }
+            else
+            {
+                // log the status if no connection
+                if (initResponse == http::NoResponse || initResponse == http::RequestTimeout)
+                {
+                    logging::GALogger::i("Init call (session start) failed - no response. Could be offline or timeout.");
+                }
+                else if (initResponse == http::BadResponse || initResponse == http::JsonEncodeFailed || initResponse == http::JsonDecodeFailed)
+                {
+                    logging::GALogger::i("Init call (session start) failed - bad response. Could be bad response from proxy or GA servers.");
+                }
+                else if (initResponse == http::BadRequest || initResponse == http::UnknownResponseCode)
+                {
+                    logging::GALogger::i("Init call (session start) failed - bad request or unknown response.");
+                }
+
+                // init call failed (perhaps offline)
+                if (_sdkConfig.empty())
+                {
+                    if (!_sdkConfigCached.empty())
+                    {
+                        logging::GALogger::i("Init call (session start) failed - using cached init values.");
+
+                        // set last cross session stored config init values
+                        _sdkConfig = _sdkConfigCached;
+                    }
+                    else
+                    {
+                        logging::GALogger::i("Init call (session start) failed - using default init values.");
+
+                        // set default init values
+                       _sdkConfig = _sdkConfigDefault;
+                    }
+                }
+                else
+                {
+                    logging::GALogger::i("Init call (session start) failed - using cached init values.");
+                }
+                _initAuthorized = true;
+            }
+        }
+
+        void GAState::applySdkConfig()
+        {
+            json& currentSdkConfig = GAState::getSdkConfig();
+            {
+                if (!utilities::getOptionalValue<bool>(currentSdkConfig, "enabled", true))
+                {
+                    _enabled = false;
+                }
+                else if (!_initAuthorized)
+                {
+                    _enabled = false;
+                }
+                else
+                {
+                    _enabled = true;
+                }
+            }
+
+            // set offset in state (memory) from current config (config could be from cache etc.)
+            _clientServerTimeOffset = utilities::getOptionalValue(currentSdkConfig, "time_offset", 0ll);
+
+            // populate configurations
+            populateConfigurations(currentSdkConfig);
+        }
+
         void GAState::validateAndFixCurrentDimensions()
         {
             // validate that there are no current dimension01 not in list
@@ -903,17 +1122,27 @@ namespace gameanalytics
             }
         }
 
-        std::string GAState::getRemoteConfigsContentAsString()
+        void GAState::addRemoteConfigsListener(StringVector const& keys, const std::shared_ptr<IRemoteConfigsKeyListener>& listener)
         {
-            std::lock_guard<std::recursive_mutex> lg(getInstance()._mtx);
+            getInstance()._remoteConfigHandles.addListener(keys, listener);
+        }
 
+        void GAState::removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsKeyListener>& listener)
+        {
+            getInstance()._remoteConfigHandles.removeListener(listener);
+        }
+
+        std::string GAState::getRemoteConfigsContentAsString()
+        {
             json contents;
 
-            for(auto& obj : getInstance()._gameRemoteConfigsJson)
+            const std::shared_ptr<const GARemoteConfigsIndex> index = getInstance()._remoteConfigs.load();
+
+            for(auto const& obj : index->configs())
             {
-                if(obj.contains("key") && obj.contains("value"))
+                if(obj.contains("key") && obj.contains("value") && obj["key"].is_string())
                 {
-                    std::string key = utilities::getOptionalValue<std::string>(obj, "key", "");
+                    std::string const& key = obj["key"].get_ref<std::string const&>();
                     if(!key.empty())
                     {
                         contents[key] = obj["value"];
@@ -924,14 +1153,14 @@ namespace gameanalytics
             return contents.dump(JSON_PRINT_INDENT);
         }
 
-        void GAState::buildRemoteConfigsJsons(const json& remoteCfgs)
+        StringVector GAState::buildRemoteConfigsJsons(const json& remoteCfgs)
         {
-            _gameRemoteConfigsJson = json::array();
+            json gameRemoteConfigs = json::array();
             _trackingRemoteConfigsJson = json::array();
 
             for (const auto& configuration : remoteCfgs)
             {
-                _gameRemoteConfigsJson.push_back({
+                gameRemoteConfigs.push_back({
                         {"key", configuration["key"]},
                         {"value", configuration["value"]}
                 });
@@ -943,9 +1172,17 @@ namespace gameanalytics
                 });
             }
 
-            logging::GALogger::d("Remote configs: %s", _gameRemoteConfigsJson.dump(JSON_PRINT_INDENT).c_str());
-            logging::GALogger::d("Remote configs for tracking: %s", _trackingRemoteConfigsJson.dump(JSON_PRINT_INDENT).c_str());
-            logging::GALogger::i("Remote configs ready with %zu configurations", _gameRemoteConfigsJson.size());
+            GA_LOG_DEBUG("Remote configs: %s", gameRemoteConfigs.dump(JSON_PRINT_INDENT).c_str());
+            GA_LOG_DEBUG("Remote configs for tracking: %s", _trackingRemoteConfigsJson.dump(JSON_PRINT_INDENT).c_str());
+            logging::GALogger::i("Remote configs ready with %zu configurations", gameRemoteConfigs.size());
+
+            auto index = std::make_shared<const GARemoteConfigsIndex>(std::move(gameRemoteConfigs));
+            StringVector changedKeys = GARemoteConfigsIndex::changedKeys(*_remoteConfigs.load(), *index);
+
+            // readers pick up the new index with their next lookup
+            _remoteConfigs.publish(std::move(index));
+
+            return changedKeys;
         }
 
         void GAState::populateConfigurations(json& sdkConfig)
@@ -972,20 +1209,37 @@ namespace gameanalytics
                             if (!key.empty() && configuration.contains("value") && client_ts_adjusted > start_ts && client_ts_adjusted < end_ts)
                             {
                                 _tempRemoteConfigsJson[key] = configuration;
-                                logging::GALogger::d("configuration added: %s", configuration.dump(JSON_PRINT_INDENT).c_str());
+                                GA_LOG_DEBUG("configuration added: %s", configuration.dump(JSON_PRINT_INDENT).c_str());
                             }
                         }
                     }
                 }
 
-                buildRemoteConfigsJsons(_tempRemoteConfigsJson);
+                const StringVector changedKeys = buildRemoteConfigsJsons(_tempRemoteConfigsJson);
+
+                // sampling rules are an sdk setting delivered through remote configs
+                if (_tempRemoteConfigsJson.contains(events::GAEventSampler::RemoteConfigKey))
+                {
+                    json const& value = _tempRemoteConfigsJson[events::GAEventSampler::RemoteConfigKey]["value"];
+                    events::GAEvents::setEventSamplingRules(value.is_string() ? utilities::parseFields(value.get<std::string>()) : value, events::GAEventSampler::ERuleSource::Remote);
+                }
+                else
+                {
+                    events::GAEvents::clearEventSamplingRules(events::GAEventSampler::ERuleSource::Remote);
+                }
 
                 _remoteConfigsIsReady = true;
-                
-                std::string const configStr = _gameRemoteConfigsJson.dump();
-                for (auto& listener : _remoteConfigsListeners)
+
+                // handles and key listeners only hear about the keys that changed
+                _remoteConfigHandles.update(*_remoteConfigs.load(), changedKeys);
+
+                if (!_remoteConfigsListeners.empty())
                 {
-                    listener->onRemoteConfigsUpdated(configStr);
+                    std::string const configStr = _remoteConfigs.load()->configs().dump();
+                    for (auto& listener : _remoteConfigsListeners)
+                    {
+                        listener->onRemoteConfigsUpdated(configStr);
+                    }
                 }
             }
             catch (json::exception& e)
@@ -1011,11 +1265,12 @@ namespace gameanalytics
             });
         }
 
-        void GAState::validateAndCleanCustomFields(const json& fields, json& out)
+        template<typename JsonType>
+        void GAState::validateAndCleanCustomFields(const JsonType& fields, JsonType& out)
         {
             try
             {
-                json result;
+                JsonType result;
 
                 if (fields.is_object() && fields.size() > 0)
                 {
@@ -1023,9 +1278,10 @@ namespace gameanalytics
 
                     for (auto itr = fields.begin(); itr != fields.end(); ++itr)
                     {
-                        std::string key = itr.key();
+                        std::string const& key = itr.key();
+                        const JsonType& value  = itr.value();
 
-                        if(fields[key].is_null())
+                        if(value.is_null())
                         {
                             std::string msg = "validateAndCleanCustomFields: entry with key=" + key + ", value = null has been omitted because its key or value is null";
 
@@ -1034,13 +1290,10 @@ namespace gameanalytics
                         }
                         else if(count < MAX_CUSTOM_FIELDS_COUNT)
                         {
-                            char pattern[MAX_CUSTOM_FIELDS_KEY_LENGTH + 1] = "";
-                            snprintf(pattern, std::size(pattern), "^[a-zA-Z0-9_]{1,%d}$", MAX_CUSTOM_FIELDS_KEY_LENGTH);
+                            constexpr utilities::CharacterClass KEY_CHARACTERS("a-zA-Z0-9_");
 
-                            if(utilities::GAUtilities::stringMatch(key, pattern))
+                            if(utilities::matchRun(key, KEY_CHARACTERS, 1, MAX_CUSTOM_FIELDS_KEY_LENGTH))
                             {
-                                const json& value = fields[key];
-
                                 if(value.is_number() || value.is_boolean())
                                 {
                                     result[key] = value;
@@ -1048,9 +1301,9 @@ namespace gameanalytics
                                 }
                                 else if(value.is_string())
                                 {
-                                    std::string valueAsString = value.get<std::string>();
+                                    const std::size_t length = value.template get_ref<typename JsonType::string_t const&>().length();
 
-                                    if(valueAsString.length() <= MAX_CUSTOM_FIELDS_VALUE_STRING_LENGTH && valueAsString.length() > 0)
+                                    if(length <= MAX_CUSTOM_FIELDS_VALUE_STRING_LENGTH && length > 0)
                                     {
                                         result[key] = value;
                                         ++count;
@@ -1059,8 +1312,8 @@ namespace gameanalytics
                                     {
                                         constexpr const char* fmt = "validateAndCleanCustomFields: entry with key=%s, value=%s has been omitted because its value is an empty string or exceeds the max number of characters (%d)";
 
-                                        const std::string value = fields[key].get<std::string>();
-                                        LogAndAddErrorEvent(EGAErrorSeverity::Warning, fmt, key.c_str(), value.c_str(), MAX_CUSTOM_FIELDS_VALUE_STRING_LENGTH);
+                                        const std::string valueString = value.template get<std::string>();
+                                        LogAndAddErrorEvent(EGAErrorSeverity::Warning, fmt, key.c_str(), valueString.c_str(), MAX_CUSTOM_FIELDS_VALUE_STRING_LENGTH);
                                     }
                                 }
                                 else
@@ -1073,8 +1326,9 @@ namespace gameanalytics
                             {
                                 constexpr const char* fmt = "validateAndCleanCustomFields: entry with key=%s, value=%s has been omitted because its key contains illegal character, is empty or exceeds the max number of characters (%d)";
                             
-                                const std::string value = fields[key].get<std::string>();
-                                LogAndAddErrorEvent(EGAErrorSeverity::Warning, fmt, key.c_str(), value.c_str(), MAX_CUSTOM_FIELDS_KEY_LENGTH);
+                                // the value can be anything here
+                                const std::string valueString = value.is_string() ? value.template get<std::string>() : value.dump();
+                                LogAndAddErrorEvent(EGAErrorSeverity::Warning, fmt, key.c_str(), valueString.c_str(), MAX_CUSTOM_FIELDS_KEY_LENGTH);
                             }
                         }
                         else
@@ -1171,36 +1425,82 @@ namespace gameanalytics
 
         std::string GAState::getAbId()
         {
+            std::lock_guard<std::recursive_mutex> lg(getInstance()._mtx);
             return getInstance()._abId;
         }
 
         std::string GAState::getAbVariantId()
         {
+            std::lock_guard<std::recursive_mutex> lg(getInstance()._mtx);
             return getInstance()._abVariantId;
         }
 
         json GAState::getValidatedCustomFields()
         {
-            json cleanedFields, d;
-            getGlobalCustomEventFields(d);
-            getInstance().validateAndCleanCustomFields(d, cleanedFields);
+            return getInstance()._currentGlobalCustomEventFields;
+        }
+
+        json GAState::getValidatedCustomFields(const json& withEventFields)
+        {
+            json cleanedFields;
+            getValidatedCustomFields(withEventFields, cleanedFields);
 
             return cleanedFields;
         }
 
-        json GAState::getValidatedCustomFields(const json& withEventFields)
+        template<typename JsonType>
+        void GAState::getValidatedCustomFields(const json& withEventFields, JsonType& out)
         {
-            json cleanedFields, d;
-            getGlobalCustomEventFields(d);
+            GAState& state = getInstance();
 
-            if(!withEventFields.empty())
-                d.merge_patch(withEventFields);
-            
-            getInstance().validateAndCleanCustomFields(d, cleanedFields);
+            out = JsonType(state._currentGlobalCustomEventFields);
 
-            return cleanedFields;
+            if(withEventFields.empty())
+            {
+                return;
+            }
+
+            if(!withEventFields.is_object())
+            {
+                // replaces the global fields, and isn't a valid set of fields itself
+                out = JsonType();
+                return;
+            }
+
+            json eventFields;
+            state.validateAndCleanCustomFields(withEventFields, eventFields);
+
+            // event fields override the global ones, an invalid or null one removes it
+            for(auto itr = withEventFields.begin(); itr != withEventFields.end(); ++itr)
+            {
+                if(eventFields.is_object() && eventFields.contains(itr.key()))
+                {
+                    out[itr.key()] = JsonType(eventFields[itr.key()]);
+                }
+                else if(out.is_object())
+                {
+                    out.erase(itr.key());
+                }
+            }
+
+            if(out.is_object() && out.size() > static_cast<std::size_t>(MAX_CUSTOM_FIELDS_COUNT))
+            {
+                auto itr = out.begin();
+                std::advance(itr, MAX_CUSTOM_FIELDS_COUNT);
+
+                while(itr != out.end())
+                {
+                    constexpr const char* fmt = "validateAndCleanCustomFields: entry with key=%s has been omitted because it exceeds the max number of custom fields (%d)";
+                    state.LogAndAddErrorEvent(EGAErrorSeverity::Warning, fmt, std::string(itr.key()).c_str(), MAX_CUSTOM_FIELDS_COUNT);
+
+                    itr = out.erase(itr);
+                }
+            }
         }
 
+        template void GAState::getValidatedCustomFields<json>(const json&, json&);
+        template void GAState::getValidatedCustomFields<utilities::ArenaJson>(const json&, utilities::ArenaJson&);
+
         json GAState::getRemoteConfigAnnotations()
         {
             return _trackingRemoteConfigsJson;
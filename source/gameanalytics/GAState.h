@@ -20,6 +20,9 @@
 #include "GAEvents.h"
 #include "GAHTTPApi.h"
 #include "GADevice.h"
+#include "GARemoteConfigsIndex.h"
+#include "GARemoteConfigsRegistry.h"
+#include "GAStringSet.h"
 
 namespace gameanalytics
 {
@@ -71,6 +74,29 @@ namespace gameanalytics
                 std::unordered_map<std::string, int> _tries;
         };
 
+        // The state of one player reported through a GAContext, kept in memory only. Only
+        // touched on the GA thread.
+        struct PlayerState
+        {
+            std::string userId;
+            std::string externalUserId;
+
+            std::string sessionId;
+            int64_t     sessionStart       = 0;
+            int64_t     sessionNum         = 0;
+            int64_t     transactionNum     = 0;
+            int64_t     totalSessionLength = 0;
+            std::chrono::high_resolution_clock::time_point startTimepoint;
+
+            std::array<std::string, 3> dimensions;
+            ProgressionTries           progressionTries;
+
+            bool sessionIsStarted() const;
+
+            // seconds since the session started
+            int64_t sessionLength() const;
+        };
+
         class GAState
         {
             friend class threading::GAThreading;
@@ -96,6 +122,7 @@ namespace gameanalytics
                 static std::string getCurrentCustomDimension02();
                 static std::string getCurrentCustomDimension03();
                 static void getGlobalCustomEventFields(json& out);
+                static std::shared_ptr<const std::string> getGlobalCustomEventFieldsMembers();
                 static std::string getGameKey();
                 static std::string getGameSecret();
                 static void setAvailableCustomDimensions01(const StringVector& dimensions);
@@ -114,15 +141,37 @@ namespace gameanalytics
                 static void incrementProgressionTries(std::string const& progression);
                 static int getProgressionTries(std::string const& progression);
                 static void clearProgressionTries(std::string const& progression);
-                static bool hasAvailableCustomDimensions01(std::string const& dimension1);
-                static bool hasAvailableCustomDimensions02(std::string const& dimension2);
-                static bool hasAvailableCustomDimensions03(std::string const& dimension3);
-                static bool hasAvailableResourceCurrency(std::string const& currency);
-                static bool hasAvailableResourceItemType(std::string const& itemType);
+                static bool hasAvailableCustomDimensions01(std::string_view dimension1);
+                static bool hasAvailableCustomDimensions02(std::string_view dimension2);
+                static bool hasAvailableCustomDimensions03(std::string_view dimension3);
+                static bool hasAvailableResourceCurrency(std::string_view currency);
+                static bool hasAvailableResourceItemType(std::string_view itemType);
                 static void setKeys(std::string const& gameKey, std::string const& gameSecret);
                 static void endSessionAndStopQueue(bool endThread);
                 static void resumeSessionAndStartQueue();
                 static void getEventAnnotations(json& out);
+                static void getEventAnnotations(events::EventAnnotations& out);
+
+                // While open on the GA thread, events are built for the player: user ids, session,
+                // custom dimensions, transaction number and progression tries come from it, and none
+                // of them are persisted. Everything else (config, store, queue) stays shared.
+                class PlayerScope
+                {
+                    public:
+
+                        explicit PlayerScope(PlayerState& player);
+                        ~PlayerScope();
+
+                        PlayerScope(PlayerScope const&) = delete;
+                        PlayerScope& operator=(PlayerScope const&) = delete;
+
+                    private:
+
+                        PlayerState* _previous;
+                };
+
+                // nullptr outside a PlayerScope
+                static PlayerState* getActivePlayer();
                 static void getSdkErrorEventAnnotations(json& out);
                 static void getInitAnnotations(json& out);
                 static void internalInitialize();
@@ -137,6 +186,8 @@ namespace gameanalytics
                 static bool isRemoteConfigsReady();
                 static void addRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener);
                 static void removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsListener>& listener);
+                static void addRemoteConfigsListener(StringVector const& keys, const std::shared_ptr<IRemoteConfigsKeyListener>& listener);
+                static void removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsKeyListener>& listener);
                 static std::string getRemoteConfigsContentAsString();
                 static std::string getAbId();
                 static std::string getAbVariantId();
@@ -146,22 +197,36 @@ namespace gameanalytics
                 static json getValidatedCustomFields();
                 static json getValidatedCustomFields(const json& withEventFields);
 
+                // builds the cleaned fields in the caller's json type, e.g. utilities::ArenaJson for event records.
+                // Only the event fields are validated, the global fields were validated when they were set
+                template<typename JsonType>
+                static void getValidatedCustomFields(const json& withEventFields, JsonType& out);
+
+                // safe to call from any thread, reads the published index without locking
                 template<typename T>
-                inline static T getRemoteConfigsValue(std::string const& key, T const& defaultValue)
+                inline static T getRemoteConfigsValue(std::string_view key, T const& defaultValue)
                 {
-                    std::lock_guard<std::recursive_mutex> lg(getInstance()._mtx);
-                    
-                    for(auto& config : getInstance()._gameRemoteConfigsJson)
+                    json const* value = getInstance()._remoteConfigs.current().find(key);
+                    if(!value)
+                    {
+                        return defaultValue;
+                    }
+
+                    try
+                    {
+                        return value->get<T>();
+                    }
+                    catch(json::exception const&)
                     {
-                        std::string configKey = utilities::getOptionalValue<std::string>(config, "key", "");
-                        if(configKey == key)
-                        {
-                            T value = utilities::getOptionalValue<T>(config, "value", defaultValue);
-                            return value;
-                        }
+                        return defaultValue;
                     }
-                    
-                    return defaultValue;
+                }
+
+                // a handle holding the parsed value of key, updated when new configs arrive
+                template<typename T>
+                inline static RemoteConfig<T> getRemoteConfig(std::string const& key, T const& defaultValue)
+                {
+                    return getInstance()._remoteConfigHandles.bind(key, defaultValue, getInstance()._remoteConfigs);
                 }
 
                 template<typename T = std::chrono::seconds>
@@ -182,6 +247,8 @@ namespace gameanalytics
         private:
             
             static GAState instance;
+
+            static thread_local PlayerState* _activePlayer;
             
             GAState();
             ~GAState();
@@ -203,6 +270,12 @@ namespace gameanalytics
             void  cacheIdentifier();
             void  ensurePersistedStates();
             void  startNewSession();
+            // sends the init call in the background and applies its result on the GA thread
+            void  refreshInitConfig();
+            // merges a successful init response into the config, falls back to cached or default values otherwise
+            void  applyInitResponse(http::EGAHTTPApiResponse initResponse, json& initResponseDict);
+            // enabled flag, time offset and remote configs from the current config
+            void  applySdkConfig();
             void  validateAndFixCurrentDimensions();
             std::string getBuild();
 
@@ -210,7 +283,8 @@ namespace gameanalytics
 
             int64_t calculateServerTimeOffset(int64_t serverTs);
 
-            void validateAndCleanCustomFields(const json& fields, json& out);
+            template<typename JsonType>
+            void validateAndCleanCustomFields(const JsonType& fields, JsonType& out);
 
             void setConfigsHash(std::string const& configsHash);
             void setAbId(std::string const& abId);
@@ -218,7 +292,8 @@ namespace gameanalytics
 
             void addErrorEvent(EGAErrorSeverity severity, std::string const& message);
 
-            void buildRemoteConfigsJsons(const json& remoteCfgs);
+            // returns the keys that changed since the previous configs
+            StringVector buildRemoteConfigsJsons(const json& remoteCfgs);
             
             events::GAEvents        _gaEvents;
             device::GADevice        _gaDevice;
@@ -247,20 +322,25 @@ namespace gameanalytics
             std::string _currentCustomDimension02;
             std::string _currentCustomDimension03;
 
+            // validated once in setGlobalCustomEventFields, the members are also kept serialized
+            // ("key":value,...) for events that bring no fields of their own
             json _currentGlobalCustomEventFields;
+            std::shared_ptr<const std::string> _currentGlobalCustomEventFieldsMembers = std::make_shared<const std::string>();
 
             std::string _gameKey;
             std::string _gameSecret;
 
-            StringVector _availableCustomDimensions01;
-            StringVector _availableCustomDimensions02;
-            StringVector _availableCustomDimensions03;
-            StringVector _availableResourceCurrencies;
-            StringVector _availableResourceItemTypes;
+            // checked on every resource event and custom dimension change
+            utilities::GAStringSet _availableCustomDimensions01;
+            utilities::GAStringSet _availableCustomDimensions02;
+            utilities::GAStringSet _availableCustomDimensions03;
+            utilities::GAStringSet _availableResourceCurrencies;
+            utilities::GAStringSet _availableResourceItemTypes;
 
             std::string _build;
 
             bool _initAuthorized = false;
+            bool _initRequestPending = false;
             bool _enabled = false;
 
             int64_t _clientServerTimeOffset = 0;
@@ -282,7 +362,9 @@ namespace gameanalytics
 
             bool _enableIdTracking = true;
             
-            json _gameRemoteConfigsJson;
+            // rebuilt by buildRemoteConfigsJsons, read from any thread
+            GARemoteConfigsPublisher _remoteConfigs;
+            GARemoteConfigsRegistry  _remoteConfigHandles;
             json _trackingRemoteConfigsJson;
             
             bool _remoteConfigsIsReady;
@@ -0,0 +1,50 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAStringSet.h"
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        GAStringSet::GAStringSet(StringVector const& values)
+        {
+            assign(values);
+        }
+
+        void GAStringSet::assign(StringVector const& values)
+        {
+            _index.clear();
+            _values = values;
+
+            // _values isn't resized again, so the views stay valid
+            _index.reserve(_values.size());
+            for(std::string const& value : _values)
+            {
+                _index.emplace(value);
+            }
+        }
+
+        bool GAStringSet::contains(std::string_view value) const
+        {
+            return _index.find(value) != _index.end();
+        }
+
+        StringVector const& GAStringSet::values() const
+        {
+            return _values;
+        }
+
+        std::size_t GAStringSet::size() const
+        {
+            return _values.size();
+        }
+
+        bool GAStringSet::empty() const
+        {
+            return _values.empty();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <string_view>
+#include <unordered_set>
+
+namespace gameanalytics
+{
+    namespace utilities
+    {
+        // A configured list of strings, e.g. the available resource item types, with a hash index
+        // for membership checks. The index points into the owned strings, so a set can't be copied
+        // or moved, only given new values.
+        class GAStringSet
+        {
+            public:
+
+                GAStringSet() = default;
+                explicit GAStringSet(StringVector const& values);
+
+                GAStringSet(GAStringSet const&) = delete;
+                GAStringSet& operator=(GAStringSet const&) = delete;
+
+                void assign(StringVector const& values);
+
+                bool contains(std::string_view value) const;
+
+                // in the order they were configured
+                StringVector const& values() const;
+                std::size_t size() const;
+                bool empty() const;
+
+            private:
+
+                // std::hash<std::string_view> itself counts as slow in libstdc++, which then
+                // compares against every value of sets up to 20 long instead of hashing
+                struct Hash
+                {
+                    std::size_t operator()(std::string_view value) const
+                    {
+                        return std::hash<std::string_view>()(value);
+                    }
+                };
+
+                StringVector                               _values;
+                std::unordered_set<std::string_view, Hash> _index;
+        };
+    }
+}
@@ -5,6 +5,7 @@
 
 #include "GAUtilities.h"
 #include "GALogger.h"
+#include "GAPayloadEncoder.h"
 #include <string.h>
 #include <stdio.h>
 #include <sstream>
@@ -106,104 +107,6 @@ namespace gameanalytics
             return std::make_pair(function, line);
         }
 
-        // Compress a STL string using zlib with given compression level and return the binary data.
-        // Note: the zlib header is supressed
-        static std::vector<char> deflate_string(const char* str, int compressionlevel = Z_BEST_COMPRESSION)
-        {
-            // z_stream is zlib's control structure
-            z_stream zs;
-            memset(&zs, 0, sizeof(zs));
-
-            /* windowsize is negative to suppress Zlib header */
-            if (Z_OK != deflateInit2(&zs, compressionlevel, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS, 9, MZ_DEFAULT_STRATEGY))
-            {
-                throw(std::runtime_error("deflateInit failed while compressing."));
-            }
-
-            zs.next_in = (Bytef*)str;
-            //zs.next_in = reinterpret_cast<Bytef*>(str.data());
-
-            // set the z_stream's input
-            zs.avail_in = static_cast<unsigned int>(strlen(str));
-            int ret;
-            
-            constexpr size_t BUFFER_SIZE = 32768;
-            static char outbuffer[BUFFER_SIZE];
-            std::vector<char> outstring;
-
-            // retrieve the compressed bytes blockwise
-            do
-            {
-                zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-                zs.avail_out = sizeof(outbuffer);
-
-                ret = deflate(&zs, Z_FINISH);
-
-                if (outstring.size() < zs.total_out)
-                {
-                    size_t s = zs.total_out - outstring.size();
-                    // append the block to the output string
-                    for(size_t i = 0; i < s; ++i)
-                    {
-                        outstring.push_back(outbuffer[i]);
-                    }
-                }
-            } while (ret == Z_OK);
-
-            deflateEnd(&zs);
-
-            if (ret != Z_STREAM_END)
-            {
-                // an error occurred that was not EOF
-                logging::GALogger::e("Exception during zlib compression: (%d) %s", ret, zs.msg);
-                outstring.clear();
-            }
-
-            return outstring;
-        }
-
-        // TODO(nikolaj): explain template?
-        template <typename T>
-        T swap_endian(T u)
-        {
-            static_assert (CHAR_BIT == 8, "CHAR_BIT != 8");
-
-            union
-            {
-                T u;
-                unsigned char u8[sizeof(T)];
-            } source, dest;
-
-            source.u = u;
-
-            for (size_t k = 0; k < sizeof(T); k++)
-                dest.u8[k] = source.u8[sizeof(T) - k - 1];
-
-            return dest.u;
-        }
-
-        uint32 htonl2(uint32 v)
-        {
-            uint32 result = 0;
-            result |= (v & 0xFF000000) >> 24;
-            result |= (v & 0x00FF0000) >> 8;
-            result |= (v & 0x0000FF00) << 8;
-            result |= (v & 0x000000FF) << 24;
-
-            return result;
-        }
-
-        uint32 to_little_endian(uint32 v)
-        {
-            // convert to big endian
-            v = htonl2(v);
-
-            // and to little endian, because gzip wants it so.
-            v = swap_endian(v);
-
-            return v;
-        }
-
         constexpr char nb_base64_chars[] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
         "abcdefghijklmnopqrstuvwxyz"
@@ -278,53 +181,6 @@ namespace gameanalytics
             *buf++ = '\0';
         }
 
-        // gzip compresses a string
-        static std::vector<uint8> compress_string_gzip(const char* str, int compressionlevel = Z_BEST_COMPRESSION)
-        {
-            // https://tools.ietf.org/html/rfc1952
-            std::vector<char> deflated = deflate_string(str, compressionlevel);
-
-            constexpr char gzip_header[10] =
-            { '\037', '\213', Z_DEFLATED, 0,
-                0, 0, 0, 0, /* mtime */
-                0, 0x03 /* Unix OS_CODE */
-            };
-
-            // Note: apparently, the crc is never validated on ther server side. So I'm not sure, if I have to convert it to little endian.
-            uint32_t crc = to_little_endian(crc32(0, (unsigned char*)str, strlen(str)));
-            uint32 size  = to_little_endian(static_cast<unsigned int>(strlen(str)));
-
-            size_t totalSize = sizeof(gzip_header);
-            totalSize += deflated.size();
-            totalSize += 8;
-
-            std::unique_ptr<char[]> resultArray = std::make_unique<char[]>(totalSize);
-            
-            size_t current = 0;
-            for(size_t i = 0; i < sizeof(gzip_header); ++i)
-            {
-                resultArray[i] = gzip_header[i];
-            }
-            current += sizeof(gzip_header);
-            for(size_t i = 0; i < deflated.size(); ++i)
-            {
-                resultArray[i + current] = deflated[i];
-            }
-            current += deflated.size();
-            strncpy(resultArray.get() + current, (const char*)&crc, 4);
-            current += 4;
-            strncpy(resultArray.get() + current, (const char*)&size, 4);
-
-            std::vector<uint8_t> result;
-
-            for(size_t i = 0; i < totalSize; ++i)
-            {
-                result.push_back(resultArray[i]);
-            }
-
-            return result;
-        }
-
         std::string GAUtilities::generateUUID()
         {
             xg::Guid guid = xg::newGuid();
@@ -392,9 +248,16 @@ namespace gameanalytics
             }
         }
 
-        std::vector<uint8_t> GAUtilities::gzipCompress(const char* data)
+        std::vector<uint8_t> GAUtilities::gzipCompress(std::string_view data)
         {
-            return compress_string_gzip(data);
+            GAPayloadEncoder encoder(true);
+            encoder.write(data);
+            if(!encoder.finish())
+            {
+                return {};
+            }
+
+            return encoder.releasePayload();
         }
 
         // TODO(nikolaj): explain function
@@ -125,7 +125,7 @@ namespace gameanalytics
             static std::string generateUUID();
             static void hmacWithKey(const char* key, const std::vector<uint8_t>& data, std::vector<uint8_t>& out);
             static bool stringMatch(std::string const& string, std::string const& pattern);
-            static std::vector<uint8_t> gzipCompress(const char* data);
+            static std::vector<uint8_t> gzipCompress(std::string_view data);
 
             // added for C++ port
             static bool isStringNullOrEmpty(const char* s);
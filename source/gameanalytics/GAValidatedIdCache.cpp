@@ -0,0 +1,122 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GAValidatedIdCache.h"
+
+namespace gameanalytics
+{
+    namespace validators
+    {
+        // valid event parts never contain it, so an invalid tuple can't spell a cached key
+        constexpr char PART_SEPARATOR = '\x1f';
+
+        double GAValidatedIdCache::Stats::hitRate() const
+        {
+            const uint64_t lookups = hits + misses;
+            return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0;
+        }
+
+        GAValidatedIdCache::GAValidatedIdCache(std::size_t capacity):
+            _capacity(capacity)
+        {
+        }
+
+        bool GAValidatedIdCache::contains(EKind kind, std::initializer_list<std::string_view> parts)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if(_capacity == 0)
+            {
+                return false;
+            }
+
+            buildKey(kind, parts);
+
+            auto itr = _index.find(_key);
+            if(itr == _index.end())
+            {
+                ++_misses;
+                return false;
+            }
+
+            ++_hits;
+            _entries.splice(_entries.begin(), _entries, itr->second);
+            return true;
+        }
+
+        void GAValidatedIdCache::insert(EKind kind, std::initializer_list<std::string_view> parts)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if(_capacity == 0)
+            {
+                return;
+            }
+
+            buildKey(kind, parts);
+
+            if(_index.find(_key) != _index.end())
+            {
+                return;
+            }
+
+            _entries.push_front(_key);
+            _index.emplace(_entries.front(), _entries.begin());
+
+            evictLocked();
+        }
+
+        void GAValidatedIdCache::setCapacity(std::size_t capacity)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _capacity = capacity;
+            evictLocked();
+        }
+
+        void GAValidatedIdCache::clear()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _index.clear();
+            _entries.clear();
+            _hits   = 0;
+            _misses = 0;
+        }
+
+        GAValidatedIdCache::Stats GAValidatedIdCache::getStats() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            Stats stats;
+            stats.hits     = _hits;
+            stats.misses   = _misses;
+            stats.size     = _entries.size();
+            stats.capacity = _capacity;
+            return stats;
+        }
+
+        void GAValidatedIdCache::buildKey(EKind kind, std::initializer_list<std::string_view> parts)
+        {
+            _key.clear();
+            _key += static_cast<char>(kind);
+
+            for(std::string_view part : parts)
+            {
+                _key += PART_SEPARATOR;
+                _key.append(part.data(), part.size());
+            }
+        }
+
+        void GAValidatedIdCache::evictLocked()
+        {
+            while(_entries.size() > _capacity)
+            {
+                _index.erase(_entries.back());
+                _entries.pop_back();
+            }
+        }
+    }
+}
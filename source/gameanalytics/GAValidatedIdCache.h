@@ -0,0 +1,78 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace gameanalytics
+{
+    namespace validators
+    {
+        // Bounded LRU set of event id tuples that already passed validation, so the ids a game
+        // sends over and over are checked once. Only successes go in, a miss means the caller
+        // runs the full validation as before. Lookups reuse one key buffer and don't allocate.
+        class GAValidatedIdCache
+        {
+            public:
+
+                static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+                enum class EKind : char
+                {
+                    Design      = 'd',
+                    Progression = 'p',
+                    Business    = 'b'
+                };
+
+                struct Stats
+                {
+                    uint64_t    hits     = 0;
+                    uint64_t    misses   = 0;
+                    std::size_t size     = 0;
+                    std::size_t capacity = 0;
+
+                    double hitRate() const;
+                };
+
+                explicit GAValidatedIdCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+                GAValidatedIdCache(GAValidatedIdCache const&) = delete;
+                GAValidatedIdCache& operator=(GAValidatedIdCache const&) = delete;
+
+                // true if the tuple was validated before, counts a hit or a miss
+                bool contains(EKind kind, std::initializer_list<std::string_view> parts);
+                void insert(EKind kind, std::initializer_list<std::string_view> parts);
+
+                // 0 turns the cache off, shrinking drops the least recently used entries
+                void  setCapacity(std::size_t capacity);
+                void  clear();
+                Stats getStats() const;
+
+            private:
+
+                void buildKey(EKind kind, std::initializer_list<std::string_view> parts);
+                void evictLocked();
+
+                mutable std::mutex _mutex;
+                std::size_t        _capacity;
+
+                // most recently used first, the index points into the list's strings
+                std::list<std::string>                                                  _entries;
+                std::unordered_map<std::string_view, std::list<std::string>::iterator> _index;
+                std::string                                                             _key;
+
+                uint64_t _hits   = 0;
+                uint64_t _misses = 0;
+        };
+    }
+}
@@ -9,6 +9,7 @@
 #include "GAState.h"
 #include "GALogger.h"
 #include "GAHTTPApi.h"
+#include "GAPattern.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -18,6 +19,61 @@ namespace gameanalytics
 {
     namespace validators
     {
+        namespace
+        {
+            // [A-z] also takes the six characters between Z and a, as the regex did
+            constexpr utilities::CharacterClass KEY_CHARACTERS("A-z0-9");
+            constexpr utilities::CharacterClass CURRENCY_CHARACTERS("A-Z");
+            constexpr utilities::CharacterClass RESOURCE_CURRENCY_CHARACTERS("A-Za-z");
+            constexpr utilities::CharacterClass EVENT_PART_CHARACTERS("-A-Za-z0-9_.()!?\\s");
+            constexpr utilities::CharacterClass EVENT_ID_LENGTH_CHARACTERS = utilities::CharacterClass(":").negated();
+            constexpr utilities::CharacterClass VERSION_DIGITS("0-9");
+
+            constexpr std::size_t MAX_EVENT_PART_LENGTH = 64;
+            constexpr std::size_t MAX_EVENT_ID_PARTS    = 5;
+
+            GAValidatedIdCache& validatedIds()
+            {
+                static GAValidatedIdCache cache;
+                return cache;
+            }
+
+            // ^(engine) [0-9]{0,5}(\.[0-9]{0,5}){0,2}(suffix){0,1}$
+            bool matchVersion(std::string_view version, std::initializer_list<std::string_view> engines, std::initializer_list<std::string_view> suffixes)
+            {
+                const std::size_t space = version.find(' ');
+                if(space == std::string_view::npos || !utilities::matchAnyOf(version.substr(0, space), engines))
+                {
+                    return false;
+                }
+
+                constexpr std::size_t MAX_DIGITS = 5;
+                constexpr int MAX_DOTS = 2;
+
+                std::string_view const number = version.substr(space + 1);
+                std::size_t i = 0;
+
+                auto skipDigits = [&]()
+                {
+                    const std::size_t start = i;
+                    while(i < number.size() && i - start < MAX_DIGITS && VERSION_DIGITS.contains(number[i]))
+                    {
+                        ++i;
+                    }
+                };
+
+                skipDigits();
+                for(int dots = 0; dots < MAX_DOTS && i < number.size() && number[i] == '.'; ++dots)
+                {
+                    ++i;
+                    skipDigits();
+                }
+
+                std::string_view const suffix = number.substr(i);
+                return suffix.empty() || utilities::matchAnyOf(suffix, suffixes);
+            }
+        }
+
         void GAValidator::validateBusinessEvent(
             std::string const& currency,
             std::int64_t amount,
@@ -68,6 +124,12 @@ namespace gameanalytics
                 return;
             }
 
+            if (validatedIds().contains(GAValidatedIdCache::EKind::Business, {itemType, itemId}))
+            {
+                out.result = true;
+                return;
+            }
+
             // validate itemType length
             if (!GAValidator::validateEventPartLength(itemType, false))
             {
@@ -123,6 +185,7 @@ namespace gameanalytics
                 return;
             }
 
+            validatedIds().insert(GAValidatedIdCache::EKind::Business, {itemType, itemId});
             out.result = true;
         }
 
@@ -335,9 +398,21 @@ namespace gameanalytics
                 return;
             }
 
+            if (validatedIds().contains(GAValidatedIdCache::EKind::Progression, {progression01, progression02, progression03}))
+            {
+                out.result = true;
+                return;
+            }
+
 			bool isProgression01Valid = validateProgressionString(progression01, out, 0);
 			bool isProgression02Valid = validateProgressionString(progression02, out, 1);
 			bool isProgression03Valid = validateProgressionString(progression03, out, 2);
+
+            // only when nothing was logged, a hit skips the warnings too
+            if (isProgression01Valid && isProgression02Valid && isProgression03Valid)
+            {
+                validatedIds().insert(GAValidatedIdCache::EKind::Progression, {progression01, progression02, progression03});
+            }
 			
 			out.result = isProgression01Valid || (isProgression01Valid && isProgression02Valid) || (isProgression01Valid && isProgression02Valid && isProgression03Valid);
 
@@ -346,6 +421,12 @@ namespace gameanalytics
 
         void GAValidator::validateDesignEvent(std::string const& eventId, ValidationResult& out)
         {
+            if (validatedIds().contains(GAValidatedIdCache::EKind::Design, {eventId}))
+            {
+                out.result = true;
+                return;
+            }
+
             if (!GAValidator::validateEventIdLength(eventId))
             {
                 logging::GALogger::w("Validation fail - design event - eventId: Cannot be (null) or empty. Only 5 event parts allowed seperated by :. Each part need to be 64 characters or less. String: %s", eventId.c_str());
@@ -366,6 +447,8 @@ namespace gameanalytics
                 out.reason = eventId;
                 return;
             }
+            validatedIds().insert(GAValidatedIdCache::EKind::Design, {eventId});
+
             // value: allow 0, negative and nil (not required)
             out.result = true;
         }
@@ -434,9 +517,9 @@ namespace gameanalytics
         // event params
         bool GAValidator::validateKeys(std::string const& gameKey, std::string const& gameSecret)
         {
-            if (utilities::GAUtilities::stringMatch(gameKey, "^[A-z0-9]{32}$"))
+            if (utilities::matchRun(gameKey, KEY_CHARACTERS, 32, 32))
             {
-                if (utilities::GAUtilities::stringMatch(gameSecret, "^[A-z0-9]{40}$"))
+                if (utilities::matchRun(gameSecret, KEY_CHARACTERS, 40, 40))
                 {
                     return true;
                 }
@@ -450,7 +533,7 @@ namespace gameanalytics
             {
                 return false;
             }
-            if (!utilities::GAUtilities::stringMatch(currency, "^[A-Z]{3}$"))
+            if (!utilities::matchRun(currency, CURRENCY_CHARACTERS, 3, 3))
             {
                 return false;
             }
@@ -477,7 +560,7 @@ namespace gameanalytics
 
         bool GAValidator::validateEventPartCharacters(std::string const& eventPart)
         {
-            if (!utilities::GAUtilities::stringMatch(eventPart, "^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}$"))
+            if (!utilities::matchRun(eventPart, EVENT_PART_CHARACTERS, 1, MAX_EVENT_PART_LENGTH))
             {
                 return false;
             }
@@ -491,7 +574,7 @@ namespace gameanalytics
                 return false;
             }
 
-            if (!utilities::GAUtilities::stringMatch(eventId, "^[^:]{1,64}(?::[^:]{1,64}){0,4}$"))
+            if (!utilities::matchSeparatedRuns(eventId, EVENT_ID_LENGTH_CHARACTERS, ':', MAX_EVENT_PART_LENGTH, MAX_EVENT_ID_PARTS))
             {
                 return false;
             }
@@ -505,7 +588,7 @@ namespace gameanalytics
                 return false;
             }
 
-            if (!utilities::GAUtilities::stringMatch(eventId, "^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}(:[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}){0,4}$"))
+            if (!utilities::matchSeparatedRuns(eventId, EVENT_PART_CHARACTERS, ':', MAX_EVENT_PART_LENGTH, MAX_EVENT_ID_PARTS))
             {
                 return false;
             }
@@ -544,7 +627,7 @@ namespace gameanalytics
         bool GAValidator::validateSdkWrapperVersion(std::string const& wrapperVersion)
         {
             // todo add beta/alpha version validation
-            if (!utilities::GAUtilities::stringMatch(wrapperVersion, "^(unity|unreal|corona|cocos2d|lumberyard|air|gamemaker|defold|godot) [0-9]{0,5}(\\.[0-9]{0,5}){0,2}(-alpha|-beta|a|b){0,1}$"))
+            if (!matchVersion(wrapperVersion, {"unity", "unreal", "corona", "cocos2d", "lumberyard", "air", "gamemaker", "defold", "godot"}, {"-alpha", "-beta", "a", "b"}))
             {
                 return false;
             }
@@ -562,7 +645,7 @@ namespace gameanalytics
 
         bool GAValidator::validateEngineVersion(std::string const& engineVersion)
         {
-            if (!utilities::GAUtilities::stringMatch(engineVersion, "^(unity|unreal|corona|cocos2d|lumberyard|gamemaker|defold|godot) [0-9]{0,5}(\\.[0-9]{0,5}){0,2}$"))
+            if (!matchVersion(engineVersion, {"unity", "unreal", "corona", "cocos2d", "lumberyard", "gamemaker", "defold", "godot"}, {}))
             {
                 return false;
             }
@@ -571,12 +654,12 @@ namespace gameanalytics
 
         bool GAValidator::validateStore(std::string const& store)
         {
-            return utilities::GAUtilities::stringMatch(store, "^(apple|google_play)$");
+            return utilities::matchAnyOf(store, {"apple", "google_play"});
         }
 
         bool GAValidator::validateConnectionType(std::string const& connectionType)
         {
-            return utilities::GAUtilities::stringMatch(connectionType, "^(wwan|wifi|lan|offline)$");
+            return utilities::matchAnyOf(connectionType, {"wwan", "wifi", "lan", "offline"});
         }
 
         // dimensions
@@ -598,10 +681,10 @@ namespace gameanalytics
                 return false;
             }
 
-            // validate each string for regex
+            // validate the characters of each string
             for (std::string const& resourceCurrency : resourceCurrencies)
             {
-                if (!utilities::GAUtilities::stringMatch(resourceCurrency, "^[A-Za-z]+$"))
+                if (!utilities::matchRun(resourceCurrency, RESOURCE_CURRENCY_CHARACTERS, 1, MAX_CURRENCY_LEN))
                 {
                     logging::GALogger::w("resource currencies validation failed: a resource currency can only be A-Z, a-z. String was: %s", resourceCurrency.c_str());
                     return false;
@@ -772,5 +855,15 @@ namespace gameanalytics
                 }
             }
         }
+
+        void GAValidator::setValidatedIdCacheCapacity(std::size_t capacity)
+        {
+            validatedIds().setCapacity(capacity);
+        }
+
+        GAValidatedIdCache::Stats GAValidator::getValidatedIdCacheStats()
+        {
+            return validatedIds().getStats();
+        }
     }
 }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "GAHTTPApi.h"
+#include "GAValidatedIdCache.h"
 
 namespace gameanalytics
 {
@@ -117,6 +118,10 @@ namespace gameanalytics
             static bool validateClientTs(int64_t clientTs);
 
             static bool validateUserId(std::string const& uId);
+
+            // event id tuples that passed validation before skip the id checks (see GAValidatedIdCache)
+            static void setValidatedIdCacheCapacity(std::size_t capacity);
+            static GAValidatedIdCache::Stats getValidatedIdCacheStats();
         };
     }
 }
@@ -197,6 +197,29 @@ namespace gameanalytics
         logging::GALogger::setCustomLogHandler(logHandler);
     }
 
+    void GameAnalytics::configureLogFile(int64_t maxFileSize, int maxFiles, int64_t diskBudget, bool compressRotatedFiles)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        if(maxFileSize <= 0 || maxFiles <= 0 || diskBudget < maxFileSize)
+        {
+            logging::GALogger::w("Log file limits must be positive and the disk budget at least one file, got %lld bytes, %d files, %lld bytes",
+                static_cast<long long>(maxFileSize), maxFiles, static_cast<long long>(diskBudget));
+            return;
+        }
+
+        logging::GALogFile::Options options;
+        options.maxFileSize     = static_cast<std::size_t>(maxFileSize);
+        options.maxFiles        = maxFiles;
+        options.diskBudget      = static_cast<std::size_t>(diskBudget);
+        options.compressRotated = compressRotatedFiles;
+
+        logging::GALogger::setLogFileOptions(options);
+    }
+
     void GameAnalytics::disableDeviceInfo()
     {
         if(_endThread)
@@ -756,6 +779,32 @@ namespace gameanalytics
         });
     }
 
+    void GameAnalytics::configureEventSampling(std::string const& rules)
+    {
+        if (_endThread)
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([rules]()
+        {
+            if (rules.empty())
+            {
+                events::GAEvents::clearEventSamplingRules(events::GAEventSampler::ERuleSource::Local);
+                return;
+            }
+
+            json rulesJson = utilities::parseFields(rules);
+            if (!rulesJson.is_object())
+            {
+                logging::GALogger::w("configureEventSampling: rules are not a valid json object");
+                return;
+            }
+
+            events::GAEvents::setEventSamplingRules(rulesJson, events::GAEventSampler::ERuleSource::Local);
+        });
+    }
+
     std::string GameAnalytics::getRemoteConfigsValueAsString(std::string const& key, std::string const& defaultValue)
     {
         return state::GAState::getRemoteConfigsValue<std::string>(key, defaultValue);
@@ -772,6 +821,19 @@ namespace gameanalytics
         return jsonString;
     }
 
+    template<typename T>
+    RemoteConfig<T> GameAnalytics::getRemoteConfig(std::string const& key, T const& defaultValue)
+    {
+        return state::GAState::getRemoteConfig<T>(key, defaultValue);
+    }
+
+    template RemoteConfig<bool>        GameAnalytics::getRemoteConfig(std::string const&, bool const&);
+    template RemoteConfig<int>         GameAnalytics::getRemoteConfig(std::string const&, int const&);
+    template RemoteConfig<int64_t>     GameAnalytics::getRemoteConfig(std::string const&, int64_t const&);
+    template RemoteConfig<float>       GameAnalytics::getRemoteConfig(std::string const&, float const&);
+    template RemoteConfig<double>      GameAnalytics::getRemoteConfig(std::string const&, double const&);
+    template RemoteConfig<std::string> GameAnalytics::getRemoteConfig(std::string const&, std::string const&);
+
     bool GameAnalytics::isRemoteConfigsReady()
     {
         return state::GAState::isRemoteConfigsReady();
@@ -787,6 +849,16 @@ namespace gameanalytics
         state::GAState::removeRemoteConfigsListener(listener);
     }
 
+    void GameAnalytics::addRemoteConfigsListener(StringVector const& keys, const std::shared_ptr<IRemoteConfigsKeyListener>& listener)
+    {
+        state::GAState::addRemoteConfigsListener(keys, listener);
+    }
+
+    void GameAnalytics::removeRemoteConfigsListener(const std::shared_ptr<IRemoteConfigsKeyListener>& listener)
+    {
+        state::GAState::removeRemoteConfigsListener(listener);
+    }
+
     std::string GameAnalytics::getRemoteConfigsContentAsString()
     {
         return state::GAState::getRemoteConfigsContentAsString();
@@ -819,6 +891,11 @@ namespace gameanalytics
             return;
         }
 
+        if(state::GAState::useManualSessionHandling())
+        {
+            http::GAHTTPApi::getInstance().resetCancellation();
+        }
+
         threading::GAThreading::performTaskOnGAThread([]()
         {
             if(state::GAState::useManualSessionHandling())
@@ -855,6 +932,9 @@ namespace gameanalytics
             return;
         }
 
+        // on the calling thread, so it is ordered with the deadline set by onSuspend
+        http::GAHTTPApi::getInstance().resetCancellation();
+
         threading::GAThreading::performTaskOnGAThread([]()
         {
             if(!state::GAState::useManualSessionHandling())
@@ -864,7 +944,7 @@ namespace gameanalytics
         });
     }
 
-    void GameAnalytics::onSuspend()
+    void GameAnalytics::onSuspend(std::chrono::milliseconds timeout)
     {
         if(_endThread)
         {
@@ -873,6 +953,8 @@ namespace gameanalytics
 
         try
         {
+            http::GAHTTPApi::getInstance().cancelRequestsAt(std::chrono::steady_clock::now() + timeout);
+
             threading::GAThreading::performTaskOnGAThread([]()
             {
                 state::GAState::endSessionAndStopQueue(false);
@@ -883,15 +965,23 @@ namespace gameanalytics
         }
     }
 
-    void GameAnalytics::onQuit()
+    void GameAnalytics::onQuit(std::chrono::milliseconds timeout)
     {
         if(_endThread)
         {
             return;
         }
 
+        // after the deadline the running request is aborted and its events go back to the store,
+        // the grace period covers that and the database work after it
+        constexpr std::chrono::milliseconds SHUTDOWN_GRACE{1000};
+        constexpr std::chrono::milliseconds POLL_INTERVAL{10};
+
         try
         {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            http::GAHTTPApi::getInstance().cancelRequestsAt(deadline);
+
             threading::GAThreading::performTaskOnGAThread([]()
             {
                 _endThread = true;
@@ -900,8 +990,17 @@ namespace gameanalytics
 
             while (!threading::GAThreading::isThreadFinished())
             {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (std::chrono::steady_clock::now() >= deadline + SHUTDOWN_GRACE)
+                {
+                    logging::GALogger::w("onQuit: SDK did not shut down within %lld ms", static_cast<long long>((timeout + SHUTDOWN_GRACE).count()));
+                    break;
+                }
+
+                std::this_thread::sleep_for(POLL_INTERVAL);
             }
+
+            // the process may exit right after, write out what was logged during shutdown
+            logging::GALogger::flush(SHUTDOWN_GRACE);
         }
         catch (const std::exception& e)
         {
@@ -969,6 +1068,105 @@ namespace gameanalytics
         }
     }
 
+    void GameAnalytics::configureSessionHeartbeatInterval(int seconds)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        if(seconds <= 0)
+        {
+            logging::GALogger::w("Session heartbeat interval must be positive, got %d", seconds);
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([seconds]()
+        {
+            events::GAEvents::setSessionHeartbeatInterval(std::chrono::seconds(seconds));
+        });
+    }
+
+    void GameAnalytics::configureGzipCompressionLevel(int level)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        if(level != GZIP_LEVEL_ADAPTIVE && (level < 0 || level > http::GACompressionPolicy::MAX_LEVEL))
+        {
+            logging::GALogger::w("Gzip compression level must be between 0 and 9 or GZIP_LEVEL_ADAPTIVE, got %d", level);
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([level]()
+        {
+            http::GAHTTPApi::getInstance().getCompressionPolicy().setLevel(level == GZIP_LEVEL_ADAPTIVE ? http::GACompressionPolicy::ADAPTIVE : level);
+        });
+    }
+
+    void GameAnalytics::configureHttpTimeouts(int connectTimeout, int totalTimeout, int lowSpeedLimit, int lowSpeedTime)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        if(connectTimeout < 0 || totalTimeout < 0 || lowSpeedLimit < 0 || lowSpeedTime < 0)
+        {
+            logging::GALogger::w("Http timeouts must not be negative, got %d, %d, %d, %d", connectTimeout, totalTimeout, lowSpeedLimit, lowSpeedTime);
+            return;
+        }
+
+        GAHttpClient::Timeouts timeouts;
+        timeouts.connect       = std::chrono::seconds(connectTimeout);
+        timeouts.total         = std::chrono::seconds(totalTimeout);
+        timeouts.lowSpeedLimit = lowSpeedLimit;
+        timeouts.lowSpeedTime  = std::chrono::seconds(lowSpeedTime);
+
+        threading::GAThreading::performTaskOnGAThread([timeouts]()
+        {
+            http::GAHTTPApi::getInstance().setTimeouts(timeouts);
+        });
+    }
+
+    void GameAnalytics::configureConnectionWarmUp(bool enabled, int refreshInterval)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        if(refreshInterval <= 0)
+        {
+            logging::GALogger::w("Connection warm-up interval must be positive, got %d", refreshInterval);
+            return;
+        }
+
+        // read by initializeClient on the calling thread of initialize, not on the GA thread
+        http::GAHTTPApi::getInstance().setConnectionWarmUp(enabled, std::chrono::seconds(refreshInterval));
+    }
+
+    void GameAnalytics::enableDesignEventAggregation(bool value, int windowInSeconds, std::vector<double> const& histogramBounds)
+    {
+        if(_endThread)
+        {
+            return;
+        }
+
+        if(windowInSeconds <= 0)
+        {
+            logging::GALogger::w("Design event aggregation window must be positive, got %d", windowInSeconds);
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([value, windowInSeconds, histogramBounds]()
+        {
+            events::GAEvents::configureDesignEventAggregation(value, std::chrono::seconds(windowInSeconds), histogramBounds);
+        });
+    }
+
     void GameAnalytics::enableMemoryHistogram(bool value)
     {
         GAHealth* healthTracker = device::GADevice::getHealthTracker();
@@ -1021,4 +1219,369 @@ namespace gameanalytics
         return state::GAState::getInstance().getLastSessionLength();
     }
 
+    // ----------------------- PLAYER CONTEXTS ---------------------- //
+
+    PlayerHandle GameAnalytics::createContext(std::string const& userId, int64_t sessionNum, int64_t transactionNum)
+    {
+        if(userId.empty())
+        {
+            logging::GALogger::w("createContext: user id cannot be empty");
+            return nullptr;
+        }
+
+        return PlayerHandle(new GAContext(userId, sessionNum, transactionNum));
+    }
+
+    namespace
+    {
+        // like GameAnalytics::isSdkReady, with the session of the player instead of the default one
+        bool isPlayerReady(state::PlayerState const& player, bool needsSession, const char* message)
+        {
+            if (!store::GAStore::getTableReady())
+            {
+                logging::GALogger::w("%s; Datastore not initialized", message);
+                return false;
+            }
+            if (!state::GAState::isInitialized())
+            {
+                logging::GALogger::w("%s; SDK is not initialized", message);
+                return false;
+            }
+            if (!state::GAState::isEnabled())
+            {
+                logging::GALogger::w("%s; SDK is disabled", message);
+                return false;
+            }
+            if (needsSession && !player.sessionIsStarted())
+            {
+                logging::GALogger::w("%s; Session of player %s has not started yet", message, player.userId.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        void endPlayerSession(state::PlayerState& player)
+        {
+            if (!player.sessionIsStarted())
+            {
+                return;
+            }
+
+            state::GAState::PlayerScope scope(player);
+
+            events::GAEvents::addSessionEndEvent();
+
+            player.totalSessionLength += player.sessionLength();
+            player.sessionStart = 0;
+        }
+    }
+
+    GAContext::GAContext(std::string const& userId, int64_t sessionNum, int64_t transactionNum):
+        _userId(userId),
+        _player(std::make_shared<state::PlayerState>())
+    {
+        _player->userId         = userId;
+        _player->sessionNum     = sessionNum;
+        _player->transactionNum = transactionNum;
+    }
+
+    GAContext::~GAContext()
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([player = _player]()
+        {
+            if (state::GAState::isInitialized() && state::GAState::isEnabled())
+            {
+                endPlayerSession(*player);
+            }
+        });
+    }
+
+    std::string const& GAContext::getUserId() const
+    {
+        return _userId;
+    }
+
+    void GAContext::setExternalUserId(std::string const& externalUserId)
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([player = _player, externalUserId]()
+        {
+            player->externalUserId = externalUserId;
+        });
+    }
+
+    void GAContext::setCustomDimension01(std::string const& dimension01)
+    {
+        setCustomDimension(0, dimension01);
+    }
+
+    void GAContext::setCustomDimension02(std::string const& dimension02)
+    {
+        setCustomDimension(1, dimension02);
+    }
+
+    void GAContext::setCustomDimension03(std::string const& dimension03)
+    {
+        setCustomDimension(2, dimension03);
+    }
+
+    void GAContext::setCustomDimension(int index, std::string const& dimension_)
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        std::string dimension = utilities::trimString(dimension_, maxDimensionSize);
+
+        threading::GAThreading::performTaskOnGAThread([player = _player, index, dimension]()
+        {
+            using validators::GAValidator;
+
+            const bool valid = index == 0 ? GAValidator::validateDimension01(dimension) :
+                               index == 1 ? GAValidator::validateDimension02(dimension) :
+                                            GAValidator::validateDimension03(dimension);
+            if (!valid)
+            {
+                logging::GALogger::w("Could not set custom0%d dimension value of player %s to '%s'. Value not found in available custom0%d dimension values",
+                    index + 1, player->userId.c_str(), dimension.c_str(), index + 1);
+                return;
+            }
+
+            player->dimensions[index] = dimension;
+        });
+    }
+
+    void GAContext::startSession()
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([player = _player]()
+        {
+            if (!isPlayerReady(*player, false, "Could not start player session"))
+            {
+                return;
+            }
+
+            endPlayerSession(*player);
+
+            player->sessionId      = utilities::toLowerCase(utilities::GAUtilities::generateUUID());
+            player->sessionStart   = state::GAState::getClientTsAdjusted();
+            player->startTimepoint = std::chrono::high_resolution_clock::now();
+
+            state::GAState::PlayerScope scope(*player);
+            events::GAEvents::addSessionStartEvent();
+        });
+    }
+
+    void GAContext::endSession()
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([player = _player]()
+        {
+            if (!isPlayerReady(*player, false, "Could not end player session"))
+            {
+                return;
+            }
+
+            endPlayerSession(*player);
+        });
+    }
+
+    void GAContext::addBusinessEvent(std::string const& currency, int amount, std::string const& itemType, std::string const& itemId, std::string const& cartType, std::string const& fields, bool mergeFields)
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([=, player = _player]()
+        {
+            if (!isPlayerReady(*player, true, "Could not add business event"))
+            {
+                return;
+            }
+
+            try
+            {
+                state::GAState::PlayerScope scope(*player);
+
+                json fieldsJson = utilities::parseFields(fields);
+                events::GAEvents::addBusinessEvent(currency, amount, itemType, itemId, cartType, fieldsJson, mergeFields);
+            }
+            catch(std::exception const& e)
+            {
+                logging::GALogger::e("addBusinessEvent - Exception thrown: %s", e.what());
+            }
+        });
+    }
+
+    void GAContext::addResourceEvent(EGAResourceFlowType flowType, std::string const& currency, float amount, std::string const& itemType, std::string const& itemId, std::string const& fields, bool mergeFields)
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([=, player = _player]()
+        {
+            if (!isPlayerReady(*player, true, "Could not add resource event"))
+            {
+                return;
+            }
+
+            try
+            {
+                state::GAState::PlayerScope scope(*player);
+
+                json fieldsJson = utilities::parseFields(fields);
+                events::GAEvents::addResourceEvent(flowType, currency, amount, itemType, itemId, fieldsJson, mergeFields);
+            }
+            catch(std::exception const& e)
+            {
+                logging::GALogger::e("addResourceEvent - Exception thrown: %s", e.what());
+            }
+        });
+    }
+
+    void GAContext::addProgressionEvent(EGAProgressionStatus progressionStatus, std::string const& progression01, std::string const& progression02, std::string const& progression03, std::string const& fields, bool mergeFields)
+    {
+        addProgressionEvent(progressionStatus, 0, false, progression01, progression02, progression03, fields, mergeFields);
+    }
+
+    void GAContext::addProgressionEvent(EGAProgressionStatus progressionStatus, int score, std::string const& progression01, std::string const& progression02, std::string const& progression03, std::string const& fields, bool mergeFields)
+    {
+        addProgressionEvent(progressionStatus, score, true, progression01, progression02, progression03, fields, mergeFields);
+    }
+
+    void GAContext::addProgressionEvent(EGAProgressionStatus progressionStatus, int score, bool sendScore, std::string const& progression01, std::string const& progression02, std::string const& progression03, std::string const& fields, bool mergeFields)
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        if(fields.size() > maxFieldsSize)
+        {
+            logging::GALogger::w("Custom fields length exceeded, maximum allowed is %d, fields' size was %d", maxFieldsSize, fields.size());
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([=, player = _player]()
+        {
+            if (!isPlayerReady(*player, true, "Could not add progression event"))
+            {
+                return;
+            }
+
+            try
+            {
+                state::GAState::PlayerScope scope(*player);
+
+                json fieldsJson = utilities::parseFields(fields);
+                events::GAEvents::addProgressionEvent(progressionStatus, progression01, progression02, progression03, score, sendScore, fieldsJson, mergeFields);
+            }
+            catch(std::exception const& e)
+            {
+                logging::GALogger::e("addProgressionEvent - Exception thrown: %s", e.what());
+            }
+        });
+    }
+
+    void GAContext::addDesignEvent(std::string const& eventId, std::string const& fields, bool mergeFields)
+    {
+        addDesignEvent(eventId, 0.0, false, fields, mergeFields);
+    }
+
+    void GAContext::addDesignEvent(std::string const& eventId, double value, std::string const& fields, bool mergeFields)
+    {
+        addDesignEvent(eventId, value, true, fields, mergeFields);
+    }
+
+    void GAContext::addDesignEvent(std::string const& eventId, double value, bool sendValue, std::string const& fields, bool mergeFields)
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        if(fields.size() > maxFieldsSize)
+        {
+            logging::GALogger::w("Custom fields length exceeded, maximum allowed is %d, fields size was %d", maxFieldsSize, fields.size());
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([=, player = _player]()
+        {
+            if (!isPlayerReady(*player, true, "Could not add design event"))
+            {
+                return;
+            }
+
+            try
+            {
+                state::GAState::PlayerScope scope(*player);
+
+                json fieldsJson = utilities::parseFields(fields);
+                events::GAEvents::addDesignEvent(eventId, value, sendValue, fieldsJson, mergeFields);
+            }
+            catch(std::exception const& e)
+            {
+                logging::GALogger::e("addDesignEvent - Exception thrown: %s", e.what());
+            }
+        });
+    }
+
+    void GAContext::addErrorEvent(EGAErrorSeverity severity, std::string const& message_, std::string const& fields, bool mergeFields)
+    {
+        if(GameAnalytics::isThreadEnding())
+        {
+            return;
+        }
+
+        const std::string message = utilities::trimString(message_, maxErrMsgSize);
+
+        if(fields.size() > maxFieldsSize)
+        {
+            logging::GALogger::w("Custom fields length exceeded, maximum allowed is %d, fields' size was %d", maxFieldsSize, fields.size());
+            return;
+        }
+
+        threading::GAThreading::performTaskOnGAThread([=, player = _player]()
+        {
+            if (!isPlayerReady(*player, true, "Could not add error event"))
+            {
+                return;
+            }
+
+            try
+            {
+                state::GAState::PlayerScope scope(*player);
+
+                json fieldsJson = utilities::parseFields(fields);
+                events::GAEvents::addErrorEvent(severity, message, "", -1, fieldsJson, mergeFields);
+            }
+            catch(std::exception const& e)
+            {
+                logging::GALogger::e("addErrorEvent - Exception thrown: %s", e.what());
+            }
+        });
+    }
+
 } // namespace gameanalytics
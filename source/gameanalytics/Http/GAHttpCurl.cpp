@@ -7,6 +7,9 @@
 #include <openssl/ssl.h>
 #include <openssl/crypto.h>
 
+#include <algorithm>
+#include <memory>
+
 namespace gameanalytics
 {
     size_t writefunc(void *ptr, size_t size, size_t nmemb, GAHttpClient::Response *s)
@@ -16,11 +19,74 @@ namespace gameanalytics
             return 0;
         }
 
-        const size_t new_len = s->packet.size() + size * nmemb + 1;
-        s->packet.reserve(new_len);
-        s->packet.insert(s->packet.end(), reinterpret_cast<char*>(ptr), reinterpret_cast<char*>(ptr) + size * nmemb);
+        const size_t chunk = size * nmemb;
+        std::vector<uint8_t>& packet = s->packet;
+
+        // grow geometrically, reserving just enough on every chunk makes large bodies quadratic
+        if(packet.capacity() - packet.size() < chunk)
+        {
+            packet.reserve(std::max(packet.capacity() * 2, packet.size() + chunk));
+        }
+
+        packet.insert(packet.end(), static_cast<uint8_t*>(ptr), static_cast<uint8_t*>(ptr) + chunk);
+
+        return chunk;
+    }
+
+    namespace
+    {
+        // called by curl about once per second and on every transfer progress
+        int progressfunc(void* userData, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+        {
+            const GAHttpClient::CancellationToken* token = static_cast<const GAHttpClient::CancellationToken*>(userData);
+            return token && token->isCancelled() ? 1 : 0;
+        }
 
-        return size*nmemb;
+        // legacy sendRequest arguments as structured headers, auth is "Authorization: <value>"
+        std::size_t makeHeaders(std::string const& auth, bool useGzip, GAHttpClient::Header (&headers)[3])
+        {
+            std::string_view authorization = auth;
+            const std::size_t separator = authorization.find(':');
+            if(separator != std::string_view::npos)
+            {
+                authorization.remove_prefix(separator + 1);
+                authorization.remove_prefix(std::min(authorization.find_first_not_of(' '), authorization.size()));
+            }
+
+            std::size_t count = 0;
+            if(!authorization.empty())
+            {
+                headers[count++] = {"Authorization", authorization};
+            }
+            headers[count++] = {"Content-Type", "application/json"};
+            if(useGzip)
+            {
+                headers[count++] = {"Content-Encoding", "gzip"};
+            }
+            return count;
+        }
+    }
+
+    struct GAHttpClientCurl::Transfer
+    {
+        CURL*                   curl = nullptr;
+        curl_slist*             header = nullptr;
+        std::vector<uint8_t>    payload;    // must outlive the transfer, curl doesn't copy post fields
+        Response                response;
+        Callback                callback;
+
+        ~Transfer()
+        {
+            curl_slist_free_all(header);
+        }
+    };
+
+    GAHttpClientCurl::GAHttpClientCurl() = default;
+
+    GAHttpClientCurl::~GAHttpClientCurl()
+    {
+        stopMulti();
+        destroyHandles();
     }
 
     void GAHttpClientCurl::initialize()
@@ -30,68 +96,444 @@ namespace gameanalytics
 
         curl_global_init(CURL_GLOBAL_DEFAULT);
         logging::GALogger::d("Using CURL version: %s", curl_version());
+
+        if(!_share)
+        {
+            _share = curl_share_init();
+            if(_share)
+            {
+                curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, &GAHttpClientCurl::lockShare);
+                curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, &GAHttpClientCurl::unlockShare);
+                curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+
+                curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+                curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+                if(curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT) != CURLSHE_OK)
+                {
+                    // older libcurl, connections are still reused by each pooled handle
+                    logging::GALogger::d("CURL connection cache can't be shared");
+                }
+            }
+        }
     }
 
     void GAHttpClientCurl::cleanup()
     {
+        stopMulti();
+        destroyHandles();
         curl_global_cleanup();
     }
 
+    void GAHttpClientCurl::destroyHandles()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_poolMutex);
+            for(CURL* curl : _pool)
+            {
+                curl_easy_cleanup(curl);
+            }
+
+            _pool.clear();
+        }
+
+        if(_share)
+        {
+            curl_share_cleanup(_share);
+            _share = nullptr;
+        }
+    }
+
+    void GAHttpClientCurl::lockShare(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* userData)
+    {
+        GAHttpClientCurl* client = static_cast<GAHttpClientCurl*>(userData);
+        if(client && data >= 0 && data < CURL_LOCK_DATA_LAST)
+        {
+            client->_shareLocks[data].lock();
+        }
+    }
+
+    void GAHttpClientCurl::unlockShare(CURL* /*handle*/, curl_lock_data data, void* userData)
+    {
+        GAHttpClientCurl* client = static_cast<GAHttpClientCurl*>(userData);
+        if(client && data >= 0 && data < CURL_LOCK_DATA_LAST)
+        {
+            client->_shareLocks[data].unlock();
+        }
+    }
+
+    std::size_t GAHttpClientCurl::idleHandleCount() const
+    {
+        std::lock_guard<std::mutex> lock(_poolMutex);
+        return _pool.size();
+    }
+
+    CURL* GAHttpClientCurl::acquireHandle()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_poolMutex);
+            if(!_pool.empty())
+            {
+                CURL* curl = _pool.back();
+                _pool.pop_back();
+                return curl;
+            }
+        }
+
+        return curl_easy_init();
+    }
+
+    void GAHttpClientCurl::releaseHandle(CURL* curl)
+    {
+        if(!curl)
+        {
+            return;
+        }
+
+        // drops the options of the last request but keeps its live connection and caches
+        curl_easy_reset(curl);
+
+        {
+            std::lock_guard<std::mutex> lock(_poolMutex);
+            if(_pool.size() < MAX_POOLED_HANDLES)
+            {
+                _pool.push_back(curl);
+                return;
+            }
+        }
+
+        curl_easy_cleanup(curl);
+    }
+
     GAHttpClient::Response GAHttpClientCurl::sendRequest(std::string const& url, std::string const& auth, std::vector<uint8_t> const& payloadData, bool useGzip, void* userData)
     {
-        CURL* curl = curl_easy_init();
-        if (!curl)
+        Header headers[3];
+        const std::size_t headerCount = makeHeaders(auth, useGzip, headers);
+
+        Request request;
+        request.url      = url;
+        request.headers  = {headers, headerCount};
+        request.payload  = payloadData;
+        request.userData = userData;
+
+        Response response;
+        send(request, response);
+        return response;
+    }
+
+    void GAHttpClientCurl::send(Request const& request, Response& response)
+    {
+        response.code = -1;
+        response.packet.clear();
+
+        if(request.cancellation && request.cancellation->isCancelled())
         {
-            return {};
+            return;
         }
 
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        // handle goes back to the pool and the header list is freed on every path
+        struct HandleReturner
+        {
+            GAHttpClientCurl* client;
+            void operator()(CURL* handle) const { client->releaseHandle(handle); }
+        };
 
-        GAHttpClient::Response response = {};
+        std::unique_ptr<CURL, HandleReturner> curl(acquireHandle(), HandleReturner{this});
+        if (!curl)
+        {
+            return;
+        }
 
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writefunc);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+        curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, writefunc);
+        curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &response);
 
-        createRequest(curl, url, auth, payloadData, useGzip);
+        std::unique_ptr<curl_slist, decltype(&curl_slist_free_all)> header(createRequest(curl.get(), request), &curl_slist_free_all);
 
-        CURLcode res = curl_easy_perform(curl);
+        CURLcode res = curl_easy_perform(curl.get());
         if (res != CURLE_OK)
         {
             logging::GALogger::d("CURL request failed: %s", curl_easy_strerror(res));
-            return {};
+            response.packet.clear();
+            return;
         }
 
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.code);
-        curl_easy_cleanup(curl);
+        curl_easy_getinfo(curl.get(), CURLINFO_RESPONSE_CODE, &response.code);
+    }
 
-        return response;
+    void GAHttpClientCurl::sendRequestAsync(std::string const& url, std::string const& auth, std::vector<uint8_t> payloadData, bool useGzip, void* /*userData*/, Callback callback)
+    {
+        std::unique_ptr<Transfer> transfer = std::make_unique<Transfer>();
+        transfer->curl = acquireHandle();
+        if(!transfer->curl)
+        {
+            if(callback)
+            {
+                callback({});
+            }
+            return;
+        }
+
+        transfer->payload  = std::move(payloadData);
+        transfer->callback = std::move(callback);
+
+        curl_easy_setopt(transfer->curl, CURLOPT_WRITEFUNCTION, writefunc);
+        curl_easy_setopt(transfer->curl, CURLOPT_WRITEDATA, &transfer->response);
+        curl_easy_setopt(transfer->curl, CURLOPT_PRIVATE, transfer.get());
+
+        Header headers[3];
+        const std::size_t headerCount = makeHeaders(auth, useGzip, headers);
+
+        Request request;
+        request.url     = url;
+        request.headers = {headers, headerCount};
+        request.payload = transfer->payload;
+
+        transfer->header = createRequest(transfer->curl, request);
+
+        submit(std::move(transfer));
     }
 
-    void GAHttpClientCurl::createRequest(CURL *curl, std::string const& url, std::string const& auth, const std::vector<uint8_t>& payloadData, bool gzip)
+    void GAHttpClientCurl::warmUp(std::string const& url, std::chrono::seconds dnsTtl)
     {
-        if(!curl)
+        _dnsCacheTimeout = static_cast<long>(dnsTtl.count());
+
+        std::unique_ptr<Transfer> transfer = std::make_unique<Transfer>();
+        transfer->curl = acquireHandle();
+        if(!transfer->curl)
         {
             return;
         }
 
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        struct curl_slist *header = NULL;
+        transfer->callback = [url](Response response)
+        {
+            logging::GALogger::d("Connection warm-up to %s: %s", url.c_str(), response.code < 0 ? "failed" : "done");
+        };
+
+        curl_easy_setopt(transfer->curl, CURLOPT_WRITEFUNCTION, writefunc);
+        curl_easy_setopt(transfer->curl, CURLOPT_WRITEDATA, &transfer->response);
+        curl_easy_setopt(transfer->curl, CURLOPT_PRIVATE, transfer.get());
+
+        Request request;
+        request.url = url;
+
+        transfer->header = createRequest(transfer->curl, request);
+
+        // only the connection is wanted, whatever the server answers
+        curl_easy_setopt(transfer->curl, CURLOPT_NOBODY, 1L);
+
+        submit(std::move(transfer));
+    }
+
+    void GAHttpClientCurl::submit(std::unique_ptr<Transfer> transfer)
+    {
+        CURLcode result = CURLE_FAILED_INIT;
+
+        {
+            std::lock_guard<std::mutex> lock(_multiMutex);
+
+            if(!_multi)
+            {
+                _multi = curl_multi_init();
+                if(_multi)
+                {
+                    _stopMulti   = false;
+                    _multiThread = std::thread(&GAHttpClientCurl::runMulti, this);
+                }
+            }
 
-        if (gzip)
+            if(_multi && !_stopMulti)
+            {
+                _queuedTransfers.push_back(std::move(transfer));
+                curl_multi_wakeup(_multi);
+                return;
+            }
+
+            // submitted while shutting down, e.g. from the callback of an aborted transfer
+            if(_multi)
+            {
+                result = CURLE_ABORTED_BY_CALLBACK;
+            }
+        }
+
+        finishTransfer(std::move(transfer), result);
+    }
+
+    void GAHttpClientCurl::runMulti()
+    {
+        std::vector<std::unique_ptr<Transfer>> running;
+        std::vector<std::unique_ptr<Transfer>> queued;
+
+        while(true)
         {
-            header = curl_slist_append(header, "Content-Encoding: gzip");
+            {
+                std::lock_guard<std::mutex> lock(_multiMutex);
+                if(_stopMulti)
+                {
+                    break;
+                }
+
+                queued.swap(_queuedTransfers);
+            }
+
+            for(std::unique_ptr<Transfer>& transfer : queued)
+            {
+                if(curl_multi_add_handle(_multi, transfer->curl) == CURLM_OK)
+                {
+                    running.push_back(std::move(transfer));
+                }
+                else
+                {
+                    finishTransfer(std::move(transfer), CURLE_FAILED_INIT);
+                }
+            }
+            queued.clear();
+
+            int stillRunning = 0;
+            curl_multi_perform(_multi, &stillRunning);
+
+            int messagesLeft = 0;
+            while(CURLMsg* msg = curl_multi_info_read(_multi, &messagesLeft))
+            {
+                if(msg->msg != CURLMSG_DONE)
+                {
+                    continue;
+                }
+
+                CURL* curl = msg->easy_handle;
+                const CURLcode result = msg->data.result;
+
+                curl_multi_remove_handle(_multi, curl);
+
+                auto it = std::find_if(running.begin(), running.end(), [curl](std::unique_ptr<Transfer> const& t) { return t->curl == curl; });
+                if(it != running.end())
+                {
+                    std::unique_ptr<Transfer> transfer = std::move(*it);
+                    running.erase(it);
+
+                    finishTransfer(std::move(transfer), result);
+                }
+            }
+
+            // sleeps until a socket is ready or sendRequestAsync wakes us up
+            curl_multi_poll(_multi, nullptr, 0, 1000, nullptr);
         }
 
-        header = curl_slist_append(header, auth.c_str());
+        // shutting down, everything still in flight or queued completes as failed
+        for(std::unique_ptr<Transfer>& transfer : running)
+        {
+            curl_multi_remove_handle(_multi, transfer->curl);
+            finishTransfer(std::move(transfer), CURLE_ABORTED_BY_CALLBACK);
+        }
 
-        // always JSON
-        header = curl_slist_append(header, "Content-Type: application/json");
+        {
+            std::lock_guard<std::mutex> lock(_multiMutex);
+            queued.swap(_queuedTransfers);
+        }
+
+        // callbacks run without the lock, they may submit again
+        for(std::unique_ptr<Transfer>& transfer : queued)
+        {
+            finishTransfer(std::move(transfer), CURLE_ABORTED_BY_CALLBACK);
+        }
+    }
+
+    void GAHttpClientCurl::stopMulti()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_multiMutex);
+            if(!_multi)
+            {
+                return;
+            }
+
+            _stopMulti = true;
+            curl_multi_wakeup(_multi);
+        }
+
+        if(_multiThread.joinable())
+        {
+            _multiThread.join();
+        }
+
+        std::lock_guard<std::mutex> lock(_multiMutex);
+        curl_multi_cleanup(_multi);
+        _multi = nullptr;
+    }
+
+    void GAHttpClientCurl::finishTransfer(std::unique_ptr<Transfer> transfer, CURLcode result)
+    {
+        Response response;
+
+        if(result == CURLE_OK)
+        {
+            curl_easy_getinfo(transfer->curl, CURLINFO_RESPONSE_CODE, &transfer->response.code);
+            response = std::move(transfer->response);
+        }
+        else
+        {
+            logging::GALogger::d("CURL request failed: %s", curl_easy_strerror(result));
+        }
+
+        Callback callback = std::move(transfer->callback);
+
+        releaseHandle(transfer->curl);
+        transfer.reset();
+
+        if(callback)
+        {
+            callback(std::move(response));
+        }
+    }
+
+    curl_slist* GAHttpClientCurl::createRequest(CURL *curl, Request const& request)
+    {
+        if(!curl)
+        {
+            return nullptr;
+        }
+
+        if(_share)
+        {
+            curl_easy_setopt(curl, CURLOPT_SHARE, _share);
+        }
+
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, _dnsCacheTimeout.load());
+
+        // curl copies the url and the header lines, both need to be null terminated
+        std::string line(request.url);
+        curl_easy_setopt(curl, CURLOPT_URL, line.c_str());
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+
+        struct curl_slist *header = NULL;
+        for(Header const& h : request.headers)
+        {
+            line.assign(h.name).append(": ").append(h.value);
+            header = curl_slist_append(header, line.c_str());
+        }
 
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payloadData.data());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.payload.data);
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, payloadData.size());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(request.payload.size));
+
+        Timeouts const& timeouts = request.timeouts;
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(timeouts.connect.count()));
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeouts.total.count()));
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, timeouts.lowSpeedLimit);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, static_cast<long>(timeouts.lowSpeedTime.count()));
+
+        // no SIGALRM for resolver timeouts, requests run on the SDK threads
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+        if(request.cancellation)
+        {
+            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, progressfunc);
+            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, const_cast<CancellationToken*>(request.cancellation));
+            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        }
+
+        return header;
     }
 }
 
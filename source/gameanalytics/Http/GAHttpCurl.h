@@ -20,24 +20,88 @@
 
 #include <curl/curl.h>
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace gameanalytics
 {
+    // Easy handles are pooled and share DNS, TLS session and connection caches through a CURLSH,
+    // so consecutive requests to the collector reuse the same keep-alive connection.
+    // Async requests are driven by a curl multi handle on a thread of their own, started on first use;
+    // their callbacks run on that thread.
     class GAHttpClientCurl: public GAHttpClient
     {
-        virtual void initialize() override;
-        
-        virtual void cleanup() override;
+        public:
+
+            // idle handles kept around, requests beyond that get a temporary handle
+            static constexpr std::size_t MAX_POOLED_HANDLES = 4;
+
+            GAHttpClientCurl();
+            virtual ~GAHttpClientCurl();
+
+            virtual void initialize() override;
+
+            virtual void cleanup() override;
+
+            virtual Response sendRequest(
+                    std::string const& url,
+                    std::string const& auth,
+                    std::vector<uint8_t> const& payloadData,
+                    bool useGzip,
+                    void* userData) override;
+
+            virtual void send(Request const& request, Response& response) override;
+
+            virtual void sendRequestAsync(
+                    std::string const& url,
+                    std::string const& auth,
+                    std::vector<uint8_t> payloadData,
+                    bool useGzip,
+                    void* userData,
+                    Callback callback) override;
 
-        virtual Response sendRequest(
-                std::string const& url,
-                std::string const& auth, 
-                std::vector<uint8_t> const& payloadData, 
-                bool useGzip,
-                void* userData) override;
+            // HEAD request to url on the multi thread, leaving the resolved address in the shared
+            // DNS cache and the connection and TLS session in the shared caches
+            virtual void warmUp(std::string const& url, std::chrono::seconds dnsTtl) override;
+
+            // handles waiting in the pool for the next request
+            std::size_t idleHandleCount() const;
 
         private:
 
-        void createRequest(CURL *curl, std::string const& url, std::string const& auth, const std::vector<uint8_t>& payloadData, bool gzip);
+            struct Transfer;
+
+            CURL* acquireHandle();
+            void  releaseHandle(CURL* curl);
+            void  destroyHandles();
+
+            // hands a prepared transfer to the multi thread, which starts it on first use
+            void submit(std::unique_ptr<Transfer> transfer);
+            void runMulti();
+            void stopMulti();
+            void finishTransfer(std::unique_ptr<Transfer> transfer, CURLcode result);
+
+            curl_slist* createRequest(CURL *curl, Request const& request);
+
+            static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData);
+            static void unlockShare(CURL* handle, curl_lock_data data, void* userData);
+
+            CURLSH*             _share = nullptr;
+            std::atomic<long>   _dnsCacheTimeout{60};   // seconds, the curl default
+            std::array<std::mutex, CURL_LOCK_DATA_LAST> _shareLocks;
+
+            mutable std::mutex  _poolMutex;
+            std::vector<CURL*>  _pool;
+
+            std::mutex          _multiMutex;
+            CURLM*              _multi = nullptr;
+            std::thread         _multiThread;
+            bool                _stopMulti = false;
+            std::vector<std::unique_ptr<Transfer>> _queuedTransfers;
     };
 }
 
@@ -0,0 +1,141 @@
+//
+// GA-SDK-CPP
+// Tests for the per-thread event arena
+//
+
+#include <gtest/gtest.h>
+
+#include "GAArena.h"
+#include "GAEventRecords.h"
+
+namespace
+{
+
+using gameanalytics::utilities::GAArena;
+using gameanalytics::utilities::ArenaString;
+using gameanalytics::utilities::ArenaJson;
+namespace events = gameanalytics::events;
+
+TEST(GAArena, AllocatesAlignedMemory)
+{
+    GAArena arena(1024);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(sizeof(double), alignof(double));
+
+    EXPECT_TRUE(arena.owns(a));
+    EXPECT_TRUE(arena.owns(b));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % alignof(double), 0u);
+    EXPECT_EQ(arena.bytesUsed(), 3 + sizeof(double));
+
+    int onStack = 0;
+    EXPECT_FALSE(arena.owns(&onStack));
+}
+
+TEST(GAArena, GrowsForLargeAllocations)
+{
+    GAArena arena(256);
+
+    void* big = arena.allocate(4096, 16);
+    EXPECT_TRUE(arena.owns(big));
+    EXPECT_GE(arena.capacity(), 4096u);
+}
+
+TEST(GAArena, ResetReusesBlocks)
+{
+    GAArena arena(1024);
+
+    void* first = arena.allocate(100, 8);
+    arena.reset();
+
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_EQ(arena.allocate(100, 8), first);
+}
+
+TEST(GAArena, ResetReleasesSpikes)
+{
+    GAArena arena(1024);
+
+    arena.allocate(GAArena::MAX_RETAINED_BYTES * 2, 8);
+    arena.reset();
+
+    EXPECT_LE(arena.capacity(), GAArena::MAX_RETAINED_BYTES);
+}
+
+TEST(GAArena, ScopeActivatesThreadArena)
+{
+    GAArena& arena = *GAArena::threadArena();
+    EXPECT_FALSE(arena.isActive());
+
+    {
+        GAArena::Scope outer;
+        EXPECT_TRUE(arena.isActive());
+
+        {
+            GAArena::Scope inner;
+            arena.allocate(64, 8);
+        }
+
+        // closing a nested scope keeps the outer allocations alive
+        EXPECT_TRUE(arena.isActive());
+        EXPECT_EQ(arena.bytesUsed(), 64u);
+    }
+
+    EXPECT_FALSE(arena.isActive());
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+}
+
+TEST(GAArena, AllocatorUsesHeapOutsideScope)
+{
+    ArenaString str(100, 'x');
+    EXPECT_FALSE(GAArena::threadArena()->owns(str.data()));
+}
+
+TEST(GAArena, AllocatorUsesArenaInsideScope)
+{
+    GAArena::Scope scope;
+
+    ArenaString str(100, 'x');
+    EXPECT_TRUE(GAArena::threadArena()->owns(str.data()));
+
+    // growing inside the arena leaves the old buffer behind
+    str.append(1000, 'y');
+    EXPECT_TRUE(GAArena::threadArena()->owns(str.data()));
+    EXPECT_EQ(str.size(), 1100u);
+}
+
+TEST(GAArena, ArenaJsonBehavesLikeJson)
+{
+    GAArena::Scope scope;
+
+    ArenaJson fields = ArenaJson::object();
+    fields["level"] = 3;
+    fields["name"]  = "boss";
+    fields["hits"]  = ArenaJson::array({1, 2, 3});
+
+    EXPECT_EQ(fields.dump(), R"({"hits":[1,2,3],"level":3,"name":"boss"})");
+}
+
+TEST(GAArena, RecordSerializesInsideScope)
+{
+    gameanalytics::utilities::GAJsonWriter writer;
+
+    {
+        GAArena::Scope scope;
+
+        events::DesignEventRecord record;
+        record.id       = "Kill:Sword:Robot";
+        record.hasValue = true;
+        record.value    = 2.5;
+        record.dimensions[0] = "ninja";
+        record.customFields["tier"] = 3;
+
+        writer.beginObject();
+        record.write(writer);
+        writer.endObject();
+    }
+
+    EXPECT_EQ(writer.str(), R"({"category":"design","event_id":"Kill:Sword:Robot","value":2.5,"custom_01":"ninja","custom_fields":{"tier":3}})");
+}
+
+} // namespace
@@ -0,0 +1,107 @@
+//
+// GA-SDK-CPP
+// Tests for the gzip level selection of request payloads
+//
+
+#include <gtest/gtest.h>
+
+#include "GACompressionPolicy.h"
+
+namespace
+{
+
+using gameanalytics::http::GACompressionPolicy;
+using Seconds = std::chrono::duration<double>;
+
+constexpr std::size_t BATCH_SIZE = 256 * 1024;
+
+TEST(GACompressionPolicy, DefaultsToBestCompression)
+{
+    GACompressionPolicy policy;
+    EXPECT_EQ(policy.getLevel(), GACompressionPolicy::DEFAULT_LEVEL);
+    EXPECT_EQ(policy.chooseLevel(10), 9);
+    EXPECT_EQ(policy.chooseLevel(BATCH_SIZE), 9);
+}
+
+TEST(GACompressionPolicy, FixedLevel)
+{
+    GACompressionPolicy policy;
+
+    ASSERT_TRUE(policy.setLevel(3));
+    EXPECT_EQ(policy.chooseLevel(BATCH_SIZE), 3);
+
+    // fixed levels ignore measurements
+    policy.recordUpload(BATCH_SIZE, Seconds(0.001));
+    EXPECT_EQ(policy.chooseLevel(BATCH_SIZE), 3);
+
+    ASSERT_TRUE(policy.setLevel(0));
+    EXPECT_EQ(policy.chooseLevel(BATCH_SIZE), 0);
+}
+
+TEST(GACompressionPolicy, RejectsInvalidLevels)
+{
+    GACompressionPolicy policy;
+
+    EXPECT_FALSE(policy.setLevel(10));
+    EXPECT_FALSE(policy.setLevel(-2));
+    EXPECT_EQ(policy.getLevel(), GACompressionPolicy::DEFAULT_LEVEL);
+
+    EXPECT_TRUE(policy.setLevel(GACompressionPolicy::ADAPTIVE));
+    EXPECT_EQ(policy.getLevel(), GACompressionPolicy::ADAPTIVE);
+}
+
+TEST(GACompressionPolicy, AdaptiveSkipsTinyPayloads)
+{
+    GACompressionPolicy policy;
+    policy.setLevel(GACompressionPolicy::ADAPTIVE);
+
+    EXPECT_EQ(policy.chooseLevel(GACompressionPolicy::MIN_ADAPTIVE_SIZE - 1), 0);
+    EXPECT_GT(policy.chooseLevel(GACompressionPolicy::MIN_ADAPTIVE_SIZE), 0);
+}
+
+TEST(GACompressionPolicy, AdaptiveFollowsBandwidth)
+{
+    GACompressionPolicy slowLink;
+    slowLink.setLevel(GACompressionPolicy::ADAPTIVE);
+    slowLink.recordUpload(BATCH_SIZE, Seconds(BATCH_SIZE / (32.0 * 1024)));
+
+    GACompressionPolicy fastLink;
+    fastLink.setLevel(GACompressionPolicy::ADAPTIVE);
+    fastLink.recordUpload(BATCH_SIZE, Seconds(BATCH_SIZE / (100.0 * 1024 * 1024)));
+
+    // every saved byte counts on a slow link, on a fast one the cheapest level wins
+    EXPECT_GT(slowLink.chooseLevel(BATCH_SIZE), fastLink.chooseLevel(BATCH_SIZE));
+    EXPECT_EQ(fastLink.chooseLevel(BATCH_SIZE), 1);
+}
+
+TEST(GACompressionPolicy, AdaptiveFollowsDeviceSpeed)
+{
+    const Seconds uploadTime(BATCH_SIZE / (1024.0 * 1024));
+
+    GACompressionPolicy fastDevice;
+    fastDevice.setLevel(GACompressionPolicy::ADAPTIVE);
+    fastDevice.recordUpload(BATCH_SIZE, uploadTime);
+    fastDevice.recordCompression(9, BATCH_SIZE, BATCH_SIZE / 14, Seconds(BATCH_SIZE / 100.0e6));
+
+    // same link, a CPU deflating 20x slower
+    GACompressionPolicy slowDevice;
+    slowDevice.setLevel(GACompressionPolicy::ADAPTIVE);
+    slowDevice.recordUpload(BATCH_SIZE, uploadTime);
+    slowDevice.recordCompression(9, BATCH_SIZE, BATCH_SIZE / 14, Seconds(BATCH_SIZE / 5.0e6));
+
+    EXPECT_LT(slowDevice.chooseLevel(BATCH_SIZE), fastDevice.chooseLevel(BATCH_SIZE));
+}
+
+TEST(GACompressionPolicy, IgnoresSmallUploadSamples)
+{
+    GACompressionPolicy policy;
+    const double before = policy.getUploadBandwidth();
+
+    policy.recordUpload(GACompressionPolicy::MIN_BANDWIDTH_SAMPLE - 1, Seconds(10.0));
+    EXPECT_DOUBLE_EQ(policy.getUploadBandwidth(), before);
+
+    policy.recordUpload(GACompressionPolicy::MIN_BANDWIDTH_SAMPLE * 4, Seconds(1.0));
+    EXPECT_DOUBLE_EQ(policy.getUploadBandwidth(), GACompressionPolicy::MIN_BANDWIDTH_SAMPLE * 4.0);
+}
+
+} // namespace
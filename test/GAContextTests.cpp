@@ -0,0 +1,115 @@
+//
+// GA-SDK-CPP
+// Tests for player contexts sharing the event pipeline
+//
+
+#include <gtest/gtest.h>
+
+#include "helpers/GATestSession.h"
+
+#include "GameAnalytics/GameAnalytics.h"
+#include "GAState.h"
+
+namespace
+{
+
+using namespace gameanalytics;
+
+// the events of a player, by category
+struct PlayerEvents
+{
+    std::string sessionId;
+    json        sessionStart;
+    json        sessionEnd;
+    std::vector<json> other;
+};
+
+PlayerEvents collect(json const& events)
+{
+    PlayerEvents result;
+    for(json const& event : events)
+    {
+        const std::string category = event.value("category", "");
+        if(category == "user")
+        {
+            result.sessionStart = event;
+            result.sessionId    = event.value("session_id", "");
+        }
+        else if(category == "session_end")
+        {
+            result.sessionEnd = event;
+        }
+        else
+        {
+            result.other.push_back(event);
+        }
+    }
+    return result;
+}
+
+TEST(GAContext, PlayersGetTheirOwnUserAndSession)
+{
+    GATestSession session;
+
+    const std::string defaultSessionId = GATestSession::onGAThread([]() { return state::GAState::getSessionId(); });
+
+    EXPECT_EQ(GameAnalytics::createContext(""), nullptr);
+
+    PlayerHandle alice = GameAnalytics::createContext("context-test-alice", 2);
+    PlayerHandle bob   = GameAnalytics::createContext("context-test-bob");
+    ASSERT_NE(alice, nullptr);
+    ASSERT_NE(bob, nullptr);
+    EXPECT_EQ(alice->getUserId(), "context-test-alice");
+
+    // events before the session has started are dropped
+    alice->addDesignEvent("Context:Early");
+
+    alice->startSession();
+    bob->startSession();
+
+    alice->addDesignEvent("Context:Alice", 1.0);
+    bob->addDesignEvent("Context:Bob");
+    bob->addProgressionEvent(EGAProgressionStatus::Start, "world_01");
+
+    // destroying a context ends its session
+    alice.reset();
+    bob->endSession();
+
+    // wait for the tasks queued by the contexts
+    GATestSession::onGAThread([]() { return 0; });
+
+    const PlayerEvents aliceEvents = collect(GATestSession::storedEventsOfUser("context-test-alice"));
+    const PlayerEvents bobEvents   = collect(GATestSession::storedEventsOfUser("context-test-bob"));
+    session.track(aliceEvents.sessionId);
+    session.track(bobEvents.sessionId);
+
+    ASSERT_FALSE(aliceEvents.sessionId.empty());
+    ASSERT_FALSE(bobEvents.sessionId.empty());
+    EXPECT_NE(aliceEvents.sessionId, bobEvents.sessionId);
+    EXPECT_NE(aliceEvents.sessionId, defaultSessionId);
+    EXPECT_NE(bobEvents.sessionId, defaultSessionId);
+
+    // the session number continues from the one given to createContext
+    EXPECT_EQ(aliceEvents.sessionStart.value("session_num", 0), 3);
+    EXPECT_EQ(bobEvents.sessionStart.value("session_num", 0), 1);
+
+    ASSERT_EQ(aliceEvents.other.size(), 1u);
+    EXPECT_EQ(aliceEvents.other[0].value("event_id", ""), "Context:Alice");
+    EXPECT_EQ(aliceEvents.other[0].value("session_id", ""), aliceEvents.sessionId);
+
+    ASSERT_EQ(bobEvents.other.size(), 2u);
+    for(json const& event : bobEvents.other)
+    {
+        EXPECT_EQ(event.value("session_id", ""), bobEvents.sessionId);
+    }
+
+    ASSERT_TRUE(aliceEvents.sessionEnd.is_object());
+    EXPECT_EQ(aliceEvents.sessionEnd.value("session_id", ""), aliceEvents.sessionId);
+    ASSERT_TRUE(bobEvents.sessionEnd.is_object());
+    EXPECT_EQ(bobEvents.sessionEnd.value("session_id", ""), bobEvents.sessionId);
+
+    // the default session is still the one running
+    EXPECT_EQ(GATestSession::onGAThread([]() { return state::GAState::getSessionId(); }), defaultSessionId);
+}
+
+} // namespace
@@ -0,0 +1,167 @@
+//
+// GA-SDK-CPP
+// Tests for the design event aggregation window
+//
+
+#include <gtest/gtest.h>
+
+#include "GAEventAggregator.h"
+
+namespace
+{
+
+using gameanalytics::events::GAEventAggregator;
+using Dimensions = std::array<std::string, GAEventAggregator::NUM_DIMENSIONS>;
+
+std::vector<GAEventAggregator::Summary> flushAll(GAEventAggregator& aggregator)
+{
+    std::vector<GAEventAggregator::Summary> summaries;
+    aggregator.flush([&summaries](GAEventAggregator::Summary const& summary)
+    {
+        summaries.push_back(summary);
+    });
+
+    return summaries;
+}
+
+TEST(GAEventAggregator, DisabledByDefault)
+{
+    GAEventAggregator aggregator;
+    EXPECT_FALSE(aggregator.isEnabled());
+    EXPECT_TRUE(aggregator.empty());
+}
+
+TEST(GAEventAggregator, CollapsesSameKeyIntoOneSummary)
+{
+    GAEventAggregator aggregator;
+    aggregator.configure(true, std::chrono::seconds(60));
+
+    aggregator.add("Combat:Hit:Sword", {}, 10.0);
+    aggregator.add("Combat:Hit:Sword", {}, 2.5);
+    aggregator.add("Combat:Hit:Sword", {}, 30.0);
+
+    ASSERT_EQ(aggregator.size(), 1u);
+
+    auto summaries = flushAll(aggregator);
+    ASSERT_EQ(summaries.size(), 1u);
+
+    GAEventAggregator::Summary const& summary = summaries.front();
+    EXPECT_EQ(summary.eventId, "Combat:Hit:Sword");
+    EXPECT_EQ(summary.count, 3);
+    EXPECT_DOUBLE_EQ(summary.sum, 42.5);
+    EXPECT_DOUBLE_EQ(summary.min, 2.5);
+    EXPECT_DOUBLE_EQ(summary.max, 30.0);
+    EXPECT_TRUE(summary.histogram.empty());
+
+    EXPECT_TRUE(aggregator.empty());
+}
+
+TEST(GAEventAggregator, DimensionsArePartOfTheKey)
+{
+    GAEventAggregator aggregator;
+    aggregator.configure(true, std::chrono::seconds(60));
+
+    aggregator.add("Combat:Hit", Dimensions{"ninja", "", ""}, 1.0);
+    aggregator.add("Combat:Hit", Dimensions{"samurai", "", ""}, 1.0);
+    aggregator.add("Combat:Hit", Dimensions{"ninja", "", ""}, 1.0);
+    aggregator.add("Combat:Miss", Dimensions{"ninja", "", ""}, 1.0);
+
+    auto summaries = flushAll(aggregator);
+    ASSERT_EQ(summaries.size(), 3u);
+
+    // summaries are emitted in first seen order
+    EXPECT_EQ(summaries[0].eventId, "Combat:Hit");
+    EXPECT_EQ(summaries[0].dimensions[0], "ninja");
+    EXPECT_EQ(summaries[0].count, 2);
+
+    EXPECT_EQ(summaries[1].dimensions[0], "samurai");
+    EXPECT_EQ(summaries[1].count, 1);
+
+    EXPECT_EQ(summaries[2].eventId, "Combat:Miss");
+}
+
+TEST(GAEventAggregator, HistogramUsesSortedBounds)
+{
+    GAEventAggregator aggregator;
+    aggregator.configure(true, std::chrono::seconds(60), {100.0, 10.0, 10.0});
+
+    ASSERT_EQ(aggregator.getHistogramBounds(), (std::vector<double>{10.0, 100.0}));
+
+    aggregator.add("Combat:Hit", {}, 5.0);
+    aggregator.add("Combat:Hit", {}, 10.0);
+    aggregator.add("Combat:Hit", {}, 50.0);
+    aggregator.add("Combat:Hit", {}, 500.0);
+    aggregator.add("Combat:Hit", {}, 1000.0);
+
+    auto summaries = flushAll(aggregator);
+    ASSERT_EQ(summaries.size(), 1u);
+    EXPECT_EQ(summaries[0].histogram, (std::vector<uint32_t>{1, 2, 2}));
+}
+
+TEST(GAEventAggregator, WindowElapsed)
+{
+    GAEventAggregator aggregator;
+    aggregator.configure(true, std::chrono::seconds(10));
+
+    const auto start = std::chrono::steady_clock::now();
+    aggregator.flush(nullptr, start);
+
+    EXPECT_FALSE(aggregator.isWindowElapsed(start + std::chrono::seconds(9)));
+    EXPECT_TRUE(aggregator.isWindowElapsed(start + std::chrono::seconds(10)));
+
+    // flushing starts a new window even when nothing was collected
+    aggregator.flush(nullptr, start + std::chrono::seconds(10));
+    EXPECT_FALSE(aggregator.isWindowElapsed(start + std::chrono::seconds(15)));
+}
+
+TEST(GAEventAggregator, EnablingStartsANewWindow)
+{
+    GAEventAggregator aggregator;
+
+    // turned on long after the aggregator was created
+    const auto enabledAt = std::chrono::steady_clock::now() + std::chrono::minutes(5);
+    aggregator.configure(true, std::chrono::seconds(60), {}, enabledAt);
+
+    EXPECT_FALSE(aggregator.isWindowElapsed(enabledAt + std::chrono::seconds(1)));
+    EXPECT_TRUE(aggregator.isWindowElapsed(enabledAt + std::chrono::seconds(60)));
+
+    // configuring again while enabled keeps the running window
+    aggregator.configure(true, std::chrono::seconds(60), {}, enabledAt + std::chrono::seconds(30));
+    EXPECT_TRUE(aggregator.isWindowElapsed(enabledAt + std::chrono::seconds(60)));
+}
+
+TEST(GAEventAggregator, NormalizedBoundsMatchConfiguredOnes)
+{
+    GAEventAggregator aggregator;
+    aggregator.configure(true, std::chrono::seconds(60), {50.0, 10.0, 50.0});
+
+    EXPECT_EQ(GAEventAggregator::normalizeHistogramBounds({10.0, 50.0, 10.0}), aggregator.getHistogramBounds());
+    EXPECT_NE(GAEventAggregator::normalizeHistogramBounds({10.0}), aggregator.getHistogramBounds());
+
+    std::vector<double> many(GAEventAggregator::MAX_HISTOGRAM_BOUNDS + 4);
+    for(std::size_t i = 0; i < many.size(); ++i)
+    {
+        many[i] = static_cast<double>(many.size() - i);
+    }
+    EXPECT_EQ(GAEventAggregator::normalizeHistogramBounds(many).size(), GAEventAggregator::MAX_HISTOGRAM_BOUNDS);
+}
+
+TEST(GAEventAggregator, HandlerMayAddToNextWindow)
+{
+    GAEventAggregator aggregator;
+    aggregator.configure(true, std::chrono::seconds(60));
+
+    aggregator.add("Combat:Hit", {}, 1.0);
+
+    int calls = 0;
+    aggregator.flush([&](GAEventAggregator::Summary const&)
+    {
+        ++calls;
+        aggregator.add("Combat:Hit", {}, 2.0);
+    });
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(aggregator.size(), 1u);
+}
+
+} // namespace
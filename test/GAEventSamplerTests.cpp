@@ -0,0 +1,124 @@
+//
+// GA-SDK-CPP
+// Tests for per category / prefix sampling and rate limiting
+//
+
+#include <gtest/gtest.h>
+
+#include "GAEventSampler.h"
+
+namespace
+{
+
+using gameanalytics::json;
+using gameanalytics::events::GAEventSampler;
+
+TEST(GAEventSampler, AcceptsEverythingWithoutRules)
+{
+    GAEventSampler sampler(1);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        GAEventSampler::Decision decision = sampler.admit("error", "");
+        EXPECT_TRUE(decision.accepted);
+        EXPECT_DOUBLE_EQ(decision.sampleRate, 1.0);
+    }
+}
+
+TEST(GAEventSampler, RateLimitRefillsOverTime)
+{
+    GAEventSampler sampler(1);
+    ASSERT_TRUE(sampler.setRules(json::parse(R"({"categories": {"error": {"rate_per_second": 2, "burst": 3}}})"), GAEventSampler::ERuleSource::Local));
+
+    const auto start = GAEventSampler::Clock::now();
+
+    int accepted = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        accepted += sampler.admit("error", "", start).accepted ? 1 : 0;
+    }
+
+    EXPECT_EQ(accepted, 3);
+    EXPECT_EQ(sampler.getRejectedByRateLimit(), 7);
+
+    // one second refills two tokens
+    EXPECT_TRUE(sampler.admit("error", "", start + std::chrono::seconds(1)).accepted);
+    EXPECT_TRUE(sampler.admit("error", "", start + std::chrono::seconds(1)).accepted);
+    EXPECT_FALSE(sampler.admit("error", "", start + std::chrono::seconds(1)).accepted);
+
+    // other categories are untouched
+    EXPECT_TRUE(sampler.admit("design", "Combat:Hit", start).accepted);
+}
+
+TEST(GAEventSampler, SampleRateIsReported)
+{
+    GAEventSampler sampler(42);
+    ASSERT_TRUE(sampler.setRules(json::parse(R"({"categories": {"design": {"sample_rate": 0.25}}})"), GAEventSampler::ERuleSource::Local));
+
+    int accepted = 0;
+    constexpr int total = 10000;
+    for (int i = 0; i < total; ++i)
+    {
+        GAEventSampler::Decision decision = sampler.admit("design", "Combat:Hit");
+        if (decision.accepted)
+        {
+            EXPECT_DOUBLE_EQ(decision.sampleRate, 0.25);
+            ++accepted;
+        }
+    }
+
+    EXPECT_NEAR(accepted / static_cast<double>(total), 0.25, 0.03);
+    EXPECT_EQ(sampler.getRejectedBySampling(), total - accepted);
+
+    auto counts = sampler.takeRejectedCounts();
+    EXPECT_EQ(counts["design"], total - accepted);
+    EXPECT_TRUE(sampler.takeRejectedCounts().empty());
+}
+
+TEST(GAEventSampler, LongestPrefixWins)
+{
+    GAEventSampler sampler(1);
+    ASSERT_TRUE(sampler.setRules(json::parse(R"({
+        "categories": {"design": {"sample_rate": 0}},
+        "prefixes":   {"Combat:": {"sample_rate": 0}, "Combat:Boss:": {"sample_rate": 1}}
+    })"), GAEventSampler::ERuleSource::Local));
+
+    EXPECT_TRUE(sampler.admit("design", "Combat:Boss:Kill").accepted);
+    EXPECT_FALSE(sampler.admit("design", "Combat:Hit").accepted);
+    EXPECT_FALSE(sampler.admit("design", "Menu:Open").accepted);
+}
+
+TEST(GAEventSampler, RemoteRulesOverrideLocal)
+{
+    GAEventSampler sampler(1);
+    ASSERT_TRUE(sampler.setRules(json::parse(R"({"categories": {"error": {"sample_rate": 0}}})"), GAEventSampler::ERuleSource::Local));
+    EXPECT_FALSE(sampler.admit("error", "").accepted);
+
+    ASSERT_TRUE(sampler.setRules(json::parse(R"({"categories": {"error": {"sample_rate": 1}}})"), GAEventSampler::ERuleSource::Remote));
+    EXPECT_TRUE(sampler.admit("error", "").accepted);
+
+    sampler.clearRules(GAEventSampler::ERuleSource::Remote);
+    EXPECT_FALSE(sampler.admit("error", "").accepted);
+}
+
+TEST(GAEventSampler, SessionAndBusinessEventsAreExempt)
+{
+    GAEventSampler sampler(1);
+    ASSERT_TRUE(sampler.setRules(json::parse(R"({"categories": {"user": {"sample_rate": 0}, "session_end": {"sample_rate": 0}, "business": {"sample_rate": 0}}})"), GAEventSampler::ERuleSource::Local));
+
+    EXPECT_TRUE(sampler.admit("user", "").accepted);
+    EXPECT_TRUE(sampler.admit("session_end", "").accepted);
+    EXPECT_TRUE(sampler.admit("business", "gems:pack").accepted);
+}
+
+TEST(GAEventSampler, InvalidRulesAreIgnored)
+{
+    GAEventSampler sampler(1);
+    EXPECT_FALSE(sampler.setRules(json::array(), GAEventSampler::ERuleSource::Local));
+
+    ASSERT_TRUE(sampler.setRules(json::parse(R"({"categories": {"error": {"sample_rate": 5}, "design": "nope"}})"), GAEventSampler::ERuleSource::Local));
+    EXPECT_TRUE(sampler.admit("error", "").accepted);
+    EXPECT_TRUE(sampler.admit("design", "Combat:Hit").accepted);
+}
+
+} // namespace
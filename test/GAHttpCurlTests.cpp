@@ -0,0 +1,289 @@
+//
+// GA-SDK-CPP
+// Tests for the timeouts and cancellation of the cURL http client
+//
+
+#include <gtest/gtest.h>
+
+#if defined(GA_HTTP_CURL) && !defined(_WIN32)
+
+#include "Http/GAHttpCurl.h"
+#include "helpers/GALocalCollector.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+using gameanalytics::GAHttpClient;
+using gameanalytics::GAHttpClientCurl;
+using Clock = std::chrono::steady_clock;
+
+// a server that completes the TCP handshake (the kernel does that) but never answers
+class StalledServer
+{
+    public:
+
+        StalledServer()
+        {
+            _socket = ::socket(AF_INET, SOCK_STREAM, 0);
+
+            sockaddr_in addr = {};
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port        = 0;
+
+            ::bind(_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            ::listen(_socket, 8);
+
+            socklen_t len = sizeof(addr);
+            ::getsockname(_socket, reinterpret_cast<sockaddr*>(&addr), &len);
+            _url = "http://127.0.0.1:" + std::to_string(ntohs(addr.sin_port)) + "/v2/test/events";
+        }
+
+        ~StalledServer()
+        {
+            ::close(_socket);
+        }
+
+        std::string const& url() const
+        {
+            return _url;
+        }
+
+    private:
+
+        int         _socket = -1;
+        std::string _url;
+};
+
+class GAHttpCurlTest : public ::testing::Test
+{
+    protected:
+
+        void SetUp() override
+        {
+            client.initialize();
+
+            request.url     = server.url();
+            request.headers = {headers, 2};
+            request.payload = payload;
+        }
+
+        void TearDown() override
+        {
+            client.cleanup();
+        }
+
+        std::chrono::milliseconds sendTimed(GAHttpClient::Response& response)
+        {
+            const auto start = Clock::now();
+            client.send(request, response);
+            return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+        }
+
+        StalledServer        server;
+        GAHttpClientCurl     client;
+
+        const GAHttpClient::Header headers[2] = { {"Authorization", "test"}, {"Content-Type", "application/json"} };
+        const std::vector<uint8_t> payload = {'[', ']'};
+        GAHttpClient::Request      request;
+};
+
+TEST_F(GAHttpCurlTest, TotalTimeoutAbortsStalledRequest)
+{
+    request.timeouts.total = std::chrono::milliseconds(200);
+
+    GAHttpClient::Response response;
+    const std::chrono::milliseconds elapsed = sendTimed(response);
+
+    EXPECT_EQ(response.code, -1);
+    EXPECT_LT(elapsed.count(), 3000);
+}
+
+TEST_F(GAHttpCurlTest, DeadlineAbortsRunningRequest)
+{
+    GAHttpClient::CancellationToken token;
+    token.cancelAt(Clock::now() + std::chrono::milliseconds(200));
+    request.cancellation = &token;
+
+    GAHttpClient::Response response;
+    const std::chrono::milliseconds elapsed = sendTimed(response);
+
+    // the progress callback runs about once per second while nothing is received
+    EXPECT_EQ(response.code, -1);
+    EXPECT_LT(elapsed.count(), 5000);
+}
+
+TEST_F(GAHttpCurlTest, CancelledTokenSkipsRequest)
+{
+    GAHttpClient::CancellationToken token;
+    token.cancel();
+    request.cancellation = &token;
+
+    GAHttpClient::Response response;
+    const std::chrono::milliseconds elapsed = sendTimed(response);
+
+    EXPECT_EQ(response.code, -1);
+    EXPECT_LT(elapsed.count(), 100);
+}
+
+TEST(GAHttpCurlWarmUp, FirstRequestReusesWarmConnection)
+{
+    GALocalCollector::Options options;
+    options.gameKey   = "warmup";
+    options.secretKey = "secret";
+    options.tls       = true;
+
+    GALocalCollector collector(options);
+
+    GAHttpClientCurl client;
+    client.initialize();
+    client.warmUp(collector.protocol() + "://" + collector.host() + "/", std::chrono::seconds(60));
+
+    // the warm-up runs on the multi thread
+    const auto deadline = Clock::now() + std::chrono::seconds(5);
+    while(collector.requests().empty() && Clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(collector.requests().size(), 1u);
+    EXPECT_EQ(collector.requests()[0].method, "HEAD");
+
+    const GAHttpClient::Header headers[] = { {"Content-Type", "application/json"} };
+    const std::vector<uint8_t> payload = {'[', ']'};
+    const std::string url = collector.eventsUrl();
+
+    GAHttpClient::Request request;
+    request.url     = url;
+    request.headers = {headers, 1};
+    request.payload = payload;
+
+    GAHttpClient::Response response;
+    client.send(request, response);
+
+    // unsigned, but it went over the connection (and TLS session) of the warm-up
+    EXPECT_EQ(response.code, 401);
+    EXPECT_EQ(collector.requests().size(), 2u);
+    EXPECT_EQ(collector.connectionCount(), 1u);
+
+    client.cleanup();
+}
+
+// collects the responses of async requests, which arrive on the multi thread
+class AsyncResponses
+{
+    public:
+
+        GAHttpClient::Callback callback()
+        {
+            return [this](GAHttpClient::Response response)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _codes.push_back(response.code);
+                _changed.notify_all();
+            };
+        }
+
+        std::vector<long> waitFor(std::size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(5))
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _changed.wait_for(lock, timeout, [&]() { return _codes.size() >= count; });
+            return _codes;
+        }
+
+    private:
+
+        std::mutex              _mutex;
+        std::condition_variable _changed;
+        std::vector<long>       _codes;
+};
+
+TEST(GAHttpCurlMulti, AsyncRequestsCompleteAndReturnHandlesToPool)
+{
+    GALocalCollector::Options options;
+    options.gameKey   = "multi";
+    options.secretKey = "secret";
+
+    GALocalCollector collector(options);
+
+    GAHttpClientCurl client;
+    client.initialize();
+
+    // more at once than the pool keeps
+    constexpr std::size_t COUNT = GAHttpClientCurl::MAX_POOLED_HANDLES + 2;
+
+    AsyncResponses responses;
+    for(std::size_t i = 0; i < COUNT; ++i)
+    {
+        client.sendRequestAsync(collector.eventsUrl(), "", {'[', ']'}, false, nullptr, responses.callback());
+    }
+
+    const std::vector<long> codes = responses.waitFor(COUNT);
+    ASSERT_EQ(codes.size(), COUNT);
+
+    // unsigned, so the collector answers 401, but every request got there
+    for(long code : codes)
+    {
+        EXPECT_EQ(code, 401);
+    }
+    EXPECT_EQ(collector.requests().size(), COUNT);
+
+    // handles go back to the pool before the callback runs, the extra ones are freed
+    EXPECT_EQ(client.idleHandleCount(), GAHttpClientCurl::MAX_POOLED_HANDLES);
+
+    client.cleanup();
+}
+
+TEST(GAHttpCurlMulti, ShutdownFailsTransfersInFlight)
+{
+    StalledServer server;
+
+    GAHttpClientCurl client;
+    client.initialize();
+
+    AsyncResponses responses;
+    std::atomic<int> resubmits{0};
+
+    // callbacks of aborted transfers submit again, twice in a row, which must fail right away
+    // instead of deadlocking or waiting on a multi thread that is gone
+    GAHttpClient::Callback resubmit = [&](GAHttpClient::Response response)
+    {
+        responses.callback()(std::move(response));
+
+        if(resubmits.fetch_add(1) < 2)
+        {
+            client.sendRequestAsync(server.url(), "", {'[', ']'}, false, nullptr, resubmit);
+        }
+    };
+
+    client.sendRequestAsync(server.url(), "", {'[', ']'}, false, nullptr, resubmit);
+    client.sendRequestAsync(server.url(), "", {'[', ']'}, false, nullptr, resubmit);
+
+    // let the multi thread pick them up and connect
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    const auto start = Clock::now();
+    client.cleanup();
+    const auto elapsed = Clock::now() - start;
+
+    const std::vector<long> codes = responses.waitFor(4, std::chrono::milliseconds(0));
+    ASSERT_EQ(codes.size(), 4u);
+    for(long code : codes)
+    {
+        EXPECT_EQ(code, -1);
+    }
+    EXPECT_LT(elapsed, std::chrono::seconds(3));
+}
+
+} // namespace
+
+#endif
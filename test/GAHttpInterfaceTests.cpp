@@ -32,7 +32,7 @@ public:
         std::string const& auth,
         std::vector<uint8_t> const& payloadData,
         bool useGzip,
-        void* userData) override
+        void*) override
     {
         lastUrl = url;
         lastAuth = auth;
@@ -155,6 +155,174 @@ TEST(GAHttpInterface, MockCanReturnNoContentResponse)
     EXPECT_TRUE(response.packet.empty());
 }
 
+// -------- Async adapter tests --------
+
+TEST(GAHttpInterface, AsyncAdapterCallsSendRequest)
+{
+    MockHttpClient mock;
+    mock.configuredResponse.code = 200;
+
+    std::vector<uint8_t> payload = {'[', ']'};
+
+    bool called = false;
+    long code = -1;
+    mock.sendRequestAsync("http://test.com/events", "auth", payload, true, nullptr,
+        [&](gameanalytics::GAHttpClient::Response response)
+        {
+            called = true;
+            code   = response.code;
+        });
+
+    // the default adapter completes before returning
+    EXPECT_TRUE(called);
+    EXPECT_EQ(code, 200);
+    EXPECT_EQ(mock.requestCount, 1);
+    EXPECT_EQ(mock.lastUrl, "http://test.com/events");
+    EXPECT_EQ(mock.lastPayload, payload);
+    EXPECT_TRUE(mock.lastUseGzip);
+}
+
+TEST(GAHttpInterface, AsyncAdapterAcceptsEmptyCallback)
+{
+    MockHttpClient mock;
+    mock.sendRequestAsync("http://test.com", "auth", {}, false, nullptr, nullptr);
+
+    EXPECT_EQ(mock.requestCount, 1);
+}
+
+TEST(GAHttpInterface, FutureReturnsResponse)
+{
+    MockHttpClient mock;
+    mock.configuredResponse.code = 401;
+
+    auto future = mock.sendRequestFuture("http://test.com", "auth", {}, false, nullptr);
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(future.get().code, 401);
+}
+
+// -------- Structured request tests --------
+
+TEST(GAHttpInterface, RequestHeaderLookup)
+{
+    const gameanalytics::GAHttpClient::Header headers[] =
+    {
+        {"Authorization", "abc123"},
+        {"Content-Encoding", "gzip"}
+    };
+
+    gameanalytics::GAHttpClient::Request request;
+    request.headers = {headers, 2};
+
+    EXPECT_EQ(request.header("Authorization"), "abc123");
+    EXPECT_TRUE(request.header("Content-Type").empty());
+    EXPECT_TRUE(request.isGzip());
+
+    request.headers = {headers, 1};
+    EXPECT_FALSE(request.isGzip());
+}
+
+TEST(GAHttpInterface, SendAdapterPassesLegacyArguments)
+{
+    MockHttpClient mock;
+    mock.configuredResponse.code = 200;
+
+    const std::string url = "https://api.gameanalytics.com/v2/test/events";
+    const std::vector<uint8_t> payload = {'[', '{', '}', ']'};
+    const gameanalytics::GAHttpClient::Header headers[] =
+    {
+        {"Authorization", "abc123"},
+        {"Content-Type", "application/json"},
+        {"Content-Encoding", "gzip"}
+    };
+
+    int userData = 0;
+
+    gameanalytics::GAHttpClient::Request request;
+    request.url      = url;
+    request.headers  = {headers, 3};
+    request.payload  = payload;
+    request.userData = &userData;
+
+    gameanalytics::GAHttpClient::Response response;
+    mock.send(request, response);
+
+    EXPECT_EQ(mock.requestCount, 1);
+    EXPECT_EQ(mock.lastUrl, url);
+    EXPECT_EQ(mock.lastAuth, "Authorization: abc123");
+    EXPECT_EQ(mock.lastPayload, payload);
+    EXPECT_TRUE(mock.lastUseGzip);
+    EXPECT_EQ(response.code, 200);
+}
+
+TEST(GAHttpInterface, SendReusesResponseBuffer)
+{
+    MockHttpClient mock;
+    mock.configuredResponse.code = 200;
+    const std::string longBody(4096, 'x');
+    mock.configuredResponse.packet.assign(longBody.begin(), longBody.end());
+
+    gameanalytics::GAHttpClient::Request request;
+    request.url = "http://test.com";
+
+    gameanalytics::GAHttpClient::Response response;
+    mock.send(request, response);
+    EXPECT_EQ(response.toString(), longBody);
+
+    const uint8_t* buffer = response.packet.data();
+    const std::size_t capacity = response.packet.capacity();
+
+    // a smaller body replaces the content in place
+    const std::string body = R"({"ok":true})";
+    mock.configuredResponse.packet.assign(body.begin(), body.end());
+    mock.send(request, response);
+
+    EXPECT_EQ(response.toString(), body);
+    EXPECT_EQ(response.packet.data(), buffer);
+    EXPECT_EQ(response.packet.capacity(), capacity);
+}
+
+// -------- Cancellation tests --------
+
+TEST(GAHttpInterface, CancellationTokenDeadline)
+{
+    using Clock = gameanalytics::GAHttpClient::CancellationToken::Clock;
+
+    gameanalytics::GAHttpClient::CancellationToken token;
+    EXPECT_FALSE(token.isCancelled());
+
+    token.cancelAt(Clock::now() + std::chrono::hours(1));
+    EXPECT_FALSE(token.isCancelled());
+
+    token.cancelAt(Clock::now() - std::chrono::milliseconds(1));
+    EXPECT_TRUE(token.isCancelled());
+
+    token.reset();
+    EXPECT_FALSE(token.isCancelled());
+
+    token.cancel();
+    EXPECT_TRUE(token.isCancelled());
+}
+
+TEST(GAHttpInterface, SendAdapterSkipsCancelledRequest)
+{
+    MockHttpClient mock;
+    mock.configuredResponse.code = 200;
+
+    gameanalytics::GAHttpClient::CancellationToken token;
+    token.cancel();
+
+    gameanalytics::GAHttpClient::Request request;
+    request.url          = "http://test.com";
+    request.cancellation = &token;
+
+    gameanalytics::GAHttpClient::Response response;
+    mock.send(request, response);
+
+    EXPECT_EQ(mock.requestCount, 0);
+    EXPECT_EQ(response.code, -1);
+}
+
 // -------- Registration tests --------
 
 TEST(GAHttpInterface, SetCustomHttpImplAcceptsUniquePtr)
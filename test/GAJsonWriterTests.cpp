@@ -0,0 +1,227 @@
+//
+// GA-SDK-CPP
+// Tests for the streaming json writer and typed event records
+//
+
+#include <gtest/gtest.h>
+
+#include "GAJsonWriter.h"
+#include "GAEventRecords.h"
+
+namespace
+{
+
+using gameanalytics::json;
+using gameanalytics::utilities::GAJsonWriter;
+namespace events = gameanalytics::events;
+
+TEST(GAJsonWriter, WritesNestedObjectsAndArrays)
+{
+    GAJsonWriter writer;
+    writer.beginObject();
+    writer.field("a", 1);
+    writer.key("b");
+    writer.beginArray();
+    writer.value(true);
+    writer.null();
+    writer.beginObject();
+    writer.endObject();
+    writer.endArray();
+    writer.field("c", "x");
+    writer.endObject();
+
+    EXPECT_EQ(writer.str(), R"({"a":1,"b":[true,null,{}],"c":"x"})");
+}
+
+TEST(GAJsonWriter, EscapesStrings)
+{
+    GAJsonWriter writer;
+    const std::string input = std::string("quote\" slash\\ nl\n tab\t ctrl") + '\x01' + " utf8 \xc3\xa6";
+    writer.value(input);
+
+    EXPECT_EQ(json::parse(writer.str()).get<std::string>(), input);
+    EXPECT_EQ(writer.str(), json(input).dump());
+}
+
+TEST(GAJsonWriter, NumbersMatchJsonDump)
+{
+    for (double d : {0.0, 1.0, -2.5, 0.1, 1e21, 123456.789, -1e-7})
+    {
+        GAJsonWriter writer;
+        writer.value(d);
+        EXPECT_EQ(writer.str(), json(d).dump());
+    }
+
+    GAJsonWriter writer;
+    writer.beginArray();
+    writer.value(std::numeric_limits<int64_t>::min());
+    writer.value(std::nan(""));
+    writer.endArray();
+    EXPECT_EQ(writer.str(), json({std::numeric_limits<int64_t>::min(), nullptr}).dump());
+}
+
+TEST(GAJsonWriter, ResetKeepsCapacity)
+{
+    GAJsonWriter writer;
+    writer.value(std::string(1000, 'x'));
+    const std::size_t capacity = writer.str().capacity();
+
+    writer.reset();
+    EXPECT_EQ(writer.size(), 0u);
+    EXPECT_EQ(writer.str().capacity(), capacity);
+
+    writer.beginObject();
+    writer.endObject();
+    EXPECT_EQ(writer.str(), "{}");
+}
+
+TEST(GAEventRecords, DesignRecordMatchesLegacyJson)
+{
+    events::EventAnnotations annotations;
+    annotations.eventUuid  = "uuid";
+    annotations.userId     = "user";
+    annotations.sessionId  = "session";
+    annotations.clientTs   = 1700000000;
+    annotations.sessionNum = 3;
+    annotations.build      = "1.0";
+
+    events::DesignEventRecord record;
+    record.id            = "Combat:Hit";
+    record.hasValue      = true;
+    record.value         = 12.5;
+    record.dimensions[0] = "ninja";
+    record.customFields  = {{"weapon", "sword"}};
+
+    GAJsonWriter writer;
+    writer.beginObject();
+    annotations.write(writer);
+    record.write(writer);
+    writer.endObject();
+
+    // what GAEvents used to build with the json DOM
+    json expected;
+    annotations.toJson(expected);
+    expected["category"]      = "design";
+    expected["event_id"]      = "Combat:Hit";
+    expected["value"]         = 12.5;
+    expected["custom_01"]     = "ninja";
+    expected["custom_fields"] = {{"weapon", "sword"}};
+
+    EXPECT_EQ(json::parse(writer.str()), expected);
+}
+
+TEST(GAEventRecords, SampleRateIsAddedToCustomFields)
+{
+    events::ErrorEventRecord record;
+    record.severity     = "error";
+    record.message      = "boom";
+    record.functionName = "main";
+    record.lineNumber   = 10;
+
+    GAJsonWriter writer;
+    writer.beginObject();
+    record.write(writer, 0.5);
+    writer.endObject();
+
+    json parsed = json::parse(writer.str());
+    EXPECT_EQ(parsed["category"], "error");
+    EXPECT_EQ(parsed["line_number"], 10);
+    EXPECT_EQ(parsed["custom_fields"]["sample_rate"], 0.5);
+    EXPECT_FALSE(parsed.contains("custom_01"));
+}
+
+TEST(GAEventRecords, GlobalCustomFieldsAreSplicedIn)
+{
+    events::DesignEventRecord record;
+    record.id                 = "Combat:Hit";
+    record.globalCustomFields = std::make_shared<const std::string>(R"("level":3,"mode":"pvp")");
+
+    GAJsonWriter writer;
+    writer.beginObject();
+    record.write(writer, 0.5);
+    writer.endObject();
+
+    EXPECT_EQ(writer.str(), R"({"category":"design","event_id":"Combat:Hit","custom_fields":{"level":3,"mode":"pvp","sample_rate":0.5}})");
+
+    // fields of the event already include the global ones
+    record.customFields = {{"weapon", "sword"}};
+
+    writer.reset();
+    writer.beginObject();
+    record.write(writer);
+    writer.endObject();
+
+    EXPECT_EQ(json::parse(writer.str())["custom_fields"], json({{"weapon", "sword"}}));
+}
+
+TEST(GAEventRecords, SampleRateReplacesFieldAndStaysUnderTheLimit)
+{
+    using gameanalytics::MAX_CUSTOM_FIELDS_COUNT;
+
+    events::DesignEventRecord record;
+    record.id = "Combat:Hit";
+
+    // the event already has a sample_rate of its own
+    record.customFields = {{"sample_rate", 1}, {"weapon", "sword"}};
+
+    GAJsonWriter writer;
+    writer.beginObject();
+    record.write(writer, 0.25);
+    writer.endObject();
+
+    EXPECT_EQ(writer.str(), R"({"category":"design","event_id":"Combat:Hit","custom_fields":{"sample_rate":0.25,"weapon":"sword"}})");
+
+    // as many fields as allowed
+    record.customFields = events::EventJson::object();
+    for(int i = 0; i < MAX_CUSTOM_FIELDS_COUNT; ++i)
+    {
+        record.customFields["field_" + std::to_string(100 + i)] = i;
+    }
+
+    writer.reset();
+    writer.beginObject();
+    record.write(writer, 0.25);
+    writer.endObject();
+
+    json fields = json::parse(writer.str())["custom_fields"];
+    EXPECT_EQ(fields.size(), static_cast<std::size_t>(MAX_CUSTOM_FIELDS_COUNT));
+    EXPECT_EQ(fields["sample_rate"], 0.25);
+
+    // the same for the global fields
+    record.customFields       = events::EventJson();
+    record.globalCustomFields = std::make_shared<const std::string>(R"("sample_rate":"all","level":3)");
+
+    writer.reset();
+    writer.beginObject();
+    record.write(writer, 0.25);
+    writer.endObject();
+
+    EXPECT_EQ(json::parse(writer.str())["custom_fields"], json({{"level", 3}, {"sample_rate", 0.25}}));
+
+    // and the json event path
+    json eventFields = {{"sample_rate", "all"}};
+    events::addSampleRate(eventFields, 0.5);
+    EXPECT_EQ(eventFields, json({{"sample_rate", 0.5}}));
+}
+
+TEST(GAEventRecords, EventIds)
+{
+    events::BusinessEventRecord business;
+    business.itemType = "boost";
+    business.itemId   = "super";
+    EXPECT_EQ(business.eventId(), "boost:super");
+
+    events::ResourceEventRecord resource;
+    resource.flowType = "Sink";
+    resource.currency = "gems";
+    resource.itemType = "lives";
+    resource.itemId   = "extra";
+    EXPECT_EQ(resource.eventId(), "Sink:gems:lives:extra");
+
+    events::ProgressionEventRecord progression;
+    progression.status      = "Complete";
+    progression.progression = "world1:level1";
+    EXPECT_EQ(progression.eventId(), "Complete:world1:level1");
+}
+
+} // namespace
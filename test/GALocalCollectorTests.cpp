@@ -0,0 +1,269 @@
+//
+// GA-SDK-CPP
+// Integration tests of the http path against the local collector stand-in
+//
+
+#include <gtest/gtest.h>
+
+#include "helpers/GALocalCollector.h"
+
+#if defined(GA_LOCAL_COLLECTOR) && defined(GA_HTTP_CURL)
+
+#include "GAHTTPApi.h"
+#include "GAPayloadEncoder.h"
+#include "GAState.h"
+#include "GAThreading.h"
+#include "Http/GAHttpCurl.h"
+
+#include <future>
+
+namespace
+{
+
+using namespace gameanalytics;
+using namespace std::chrono_literals;
+
+constexpr const char* GAME_KEY    = "bd624ee6f8e6efb32a054f8d7ba11618";
+constexpr const char* GAME_SECRET = "7f5c3f682cbd217841efba92e92ffb1b3b6612bc";
+
+// events of this test, the sdk may flush its own queue to the collector meanwhile
+constexpr const char* EVENT_PREFIX = "LocalCollector:";
+
+GALocalCollector::Options collectorOptions(bool tls = false)
+{
+    GALocalCollector::Options options;
+    options.gameKey   = GAME_KEY;
+    options.secretKey = GAME_SECRET;
+    options.tls       = tls;
+    options.initResponse["configs_hash"] = "local";
+    options.initResponse["configs"]      = json::array({ {{"key", "speed"}, {"value", "fast"}, {"id", "1"}, {"vsn", 1}} });
+    return options;
+}
+
+json makeEvents(int count)
+{
+    json events = json::array();
+    for(int i = 0; i < count; ++i)
+    {
+        events.push_back({{"category", "design"}, {"event_id", EVENT_PREFIX + std::to_string(i)}, {"value", i}});
+    }
+    return events;
+}
+
+std::size_t countOwnEvents(json const& events)
+{
+    std::size_t count = 0;
+    for(json const& ev : events)
+    {
+        if(ev.value("event_id", "").rfind(EVENT_PREFIX, 0) == 0)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+class GALocalCollectorTest : public ::testing::Test
+{
+    protected:
+
+        void SetUp() override
+        {
+            state::GAState::setKeys(GAME_KEY, GAME_SECRET);
+
+            http::GAHTTPApi::setCustomHttpImpl(std::make_unique<GAHttpClientCurl>());
+            onGAThread([]()
+            {
+                http::GAHTTPApi& api = http::GAHTTPApi::getInstance();
+                api.initializeClient();
+                api.resetCancellation();
+                return 0;
+            });
+        }
+
+        void TearDown() override
+        {
+            onGAThread([]()
+            {
+                http::GAHTTPApi::getInstance().setCollectorHost(http::GAHTTPApi::PROTOCOL, http::GAHTTPApi::HOST_NAME);
+                return 0;
+            });
+            http::GAHTTPApi::setCustomHttpImpl(nullptr);
+        }
+
+        void useCollector(GALocalCollector const& collector)
+        {
+            const std::string protocol = collector.protocol();
+            const std::string host     = collector.host();
+            onGAThread([&]()
+            {
+                http::GAHTTPApi::getInstance().setCollectorHost(protocol, host);
+                return 0;
+            });
+        }
+
+        // requests are sent from the GA thread, which owns the shared response buffer
+        template<typename Task>
+        static auto onGAThread(Task task) -> decltype(task())
+        {
+            auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(task);
+            auto result   = packaged->get_future();
+            threading::GAThreading::performTaskOnGAThread([packaged]() { (*packaged)(); });
+            return result.get();
+        }
+
+        static http::EGAHTTPApiResponse sendEvents(json const& events)
+        {
+            return onGAThread([&]()
+            {
+                json out;
+                return http::GAHTTPApi::getInstance().sendEventsInArray(out, events, events.dump().size());
+            });
+        }
+};
+
+TEST_F(GALocalCollectorTest, RecordsSignedEvents)
+{
+    GALocalCollector collector(collectorOptions());
+    useCollector(collector);
+
+    EXPECT_EQ(sendEvents(makeEvents(5)), http::Ok);
+
+    EXPECT_EQ(countOwnEvents(collector.events()), 5u);
+    EXPECT_EQ(collector.rejectedSignatures(), 0u);
+}
+
+TEST_F(GALocalCollectorTest, InflatesGzipBodies)
+{
+    GALocalCollector collector(collectorOptions());
+
+    const std::string body = makeEvents(20).dump();
+    utilities::GAPayloadEncoder encoder(true, GAME_SECRET);
+    encoder.write(body);
+    ASSERT_TRUE(encoder.finish());
+
+    const GAHttpClient::Header headers[] = { {"Authorization", encoder.signature()}, {"Content-Type", "application/json"}, {"Content-Encoding", "gzip"} };
+    const std::string url = collector.eventsUrl();
+
+    GAHttpClient::Request request;
+    request.url     = url;
+    request.headers = {headers, 3};
+    request.payload = encoder.payload();
+
+    GAHttpClientCurl client;
+    client.initialize();
+
+    GAHttpClient::Response response;
+    client.send(request, response);
+    client.cleanup();
+
+    EXPECT_EQ(response.code, 200);
+    ASSERT_EQ(collector.requests().size(), 1u);
+    EXPECT_TRUE(collector.requests()[0].gzip);
+    EXPECT_EQ(collector.events(), json::parse(body));
+}
+
+TEST_F(GALocalCollectorTest, RejectsWrongSignature)
+{
+    GALocalCollector::Options options = collectorOptions();
+    options.secretKey = "0000000000000000000000000000000000000000";
+
+    GALocalCollector collector(options);
+    useCollector(collector);
+
+    EXPECT_EQ(sendEvents(makeEvents(1)), http::Unauthorized);
+    EXPECT_GE(collector.rejectedSignatures(), 1u);
+    EXPECT_EQ(countOwnEvents(collector.events()), 0u);
+}
+
+TEST_F(GALocalCollectorTest, InjectsErrorResponses)
+{
+    GALocalCollector collector(collectorOptions());
+    useCollector(collector);
+
+    collector.setForcedStatus(400);
+    EXPECT_EQ(sendEvents(makeEvents(1)), http::BadRequest);
+
+    collector.setForcedStatus(401);
+    EXPECT_EQ(sendEvents(makeEvents(1)), http::Unauthorized);
+
+    collector.setForcedStatus(500);
+    EXPECT_EQ(sendEvents(makeEvents(1)), http::InternalServerError);
+
+    collector.setForcedStatus(0);
+    collector.setErrorRate(1.0, 500);
+    EXPECT_EQ(sendEvents(makeEvents(1)), http::InternalServerError);
+
+    collector.setErrorRate(0.0, 500);
+    EXPECT_EQ(sendEvents(makeEvents(1)), http::Ok);
+    EXPECT_EQ(countOwnEvents(collector.events()), 1u);
+}
+
+TEST_F(GALocalCollectorTest, AddsLatency)
+{
+    GALocalCollector collector(collectorOptions());
+    useCollector(collector);
+    collector.setLatency(200ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(sendEvents(makeEvents(1)), http::Ok);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 200ms);
+}
+
+TEST_F(GALocalCollectorTest, AnswersInit)
+{
+    GALocalCollector collector(collectorOptions());
+    useCollector(collector);
+
+    json init;
+    const http::EGAHTTPApiResponse result = onGAThread([&]()
+    {
+        return http::GAHTTPApi::getInstance().requestInitReturningDict(init, "");
+    });
+
+    EXPECT_EQ(result, http::Created);
+    EXPECT_EQ(init.value("configs_hash", ""), "local");
+    EXPECT_GT(init.value("server_ts", 0ll), 0);
+    ASSERT_TRUE(init.contains("configs"));
+    EXPECT_EQ(init["configs"].size(), 1u);
+}
+
+TEST_F(GALocalCollectorTest, ServesTls)
+{
+    GALocalCollector collector(collectorOptions(true));
+    ASSERT_EQ(collector.protocol(), "https");
+    useCollector(collector);
+
+    EXPECT_EQ(sendEvents(makeEvents(3)), http::Ok);
+    EXPECT_EQ(countOwnEvents(collector.events()), 3u);
+}
+
+TEST_F(GALocalCollectorTest, WarmsUpConnectionOnInitialize)
+{
+    GALocalCollector collector(collectorOptions());
+    useCollector(collector);
+
+    http::GAHTTPApi::getInstance().setConnectionWarmUp(true);
+    onGAThread([]()
+    {
+        http::GAHTTPApi::getInstance().initializeClient();
+        return 0;
+    });
+    http::GAHTTPApi::getInstance().setConnectionWarmUp(false);
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while(collector.requests().empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    ASSERT_FALSE(collector.requests().empty());
+    EXPECT_EQ(collector.requests()[0].method, "HEAD");
+
+    EXPECT_EQ(sendEvents(makeEvents(1)), http::Ok);
+    EXPECT_EQ(collector.connectionCount(), 1u);
+}
+
+} // namespace
+
+#endif // GA_LOCAL_COLLECTOR && GA_HTTP_CURL
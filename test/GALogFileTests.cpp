@@ -0,0 +1,208 @@
+//
+// GA-SDK-CPP
+// Tests for the buffered, rotating log file
+//
+
+#include <gtest/gtest.h>
+
+#include "GALogFile.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+
+namespace fs = std::filesystem;
+using gameanalytics::logging::GALogFile;
+
+class GALogFileTest : public ::testing::Test
+{
+    protected:
+
+        void SetUp() override
+        {
+            _directory = fs::temp_directory_path() / ("ga_log_file_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+            fs::create_directories(_directory);
+        }
+
+        void TearDown() override
+        {
+            std::error_code error;
+            fs::remove_all(_directory, error);
+        }
+
+        std::string directory() const
+        {
+            return _directory.string();
+        }
+
+        static std::string read(std::string const& path)
+        {
+            std::ifstream in(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+
+        std::uintmax_t totalSize() const
+        {
+            std::uintmax_t size = 0;
+            for(auto const& entry : fs::directory_iterator(_directory))
+            {
+                size += entry.file_size();
+            }
+            return size;
+        }
+
+        static std::string line(int i)
+        {
+            // 100 bytes with the newline
+            std::string text = "line " + std::to_string(i) + " ";
+            text.resize(99, 'x');
+            return text;
+        }
+
+        fs::path _directory;
+};
+
+TEST_F(GALogFileTest, BuffersUntilFlush)
+{
+    GALogFile file;
+    ASSERT_TRUE(file.open(directory(), "ga_log"));
+
+    file.write("first");
+    EXPECT_EQ(read(file.path()), "");
+
+    file.flush();
+    EXPECT_EQ(read(file.path()), "first\n");
+
+    // errors go out right away
+    file.write("error", true);
+    EXPECT_EQ(read(file.path()), "first\nerror\n");
+}
+
+TEST_F(GALogFileTest, FlushesWhenBufferIsFull)
+{
+    GALogFile::Options options;
+    options.bufferSize = 250;
+
+    GALogFile file;
+    file.setOptions(options);
+    ASSERT_TRUE(file.open(directory(), "ga_log"));
+
+    file.write(line(0));
+    file.write(line(1));
+    EXPECT_EQ(read(file.path()), "");
+
+    file.write(line(2));
+    EXPECT_EQ(read(file.path()).size(), 200u);
+}
+
+TEST_F(GALogFileTest, FlushesAfterInterval)
+{
+    GALogFile::Options options;
+    options.flushInterval = std::chrono::milliseconds(0);
+
+    GALogFile file;
+    file.setOptions(options);
+    ASSERT_TRUE(file.open(directory(), "ga_log"));
+
+    file.write("periodic");
+    file.flushIfDue();
+    EXPECT_EQ(read(file.path()), "periodic\n");
+}
+
+TEST_F(GALogFileTest, RotatesAtMaxFileSize)
+{
+    GALogFile::Options options;
+    options.maxFileSize = 1000;
+    options.maxFiles    = 3;
+    options.diskBudget  = 1000000;
+    options.bufferSize  = 100;
+
+    GALogFile file;
+    file.setOptions(options);
+    ASSERT_TRUE(file.open(directory(), "ga_log"));
+
+    for(int i = 0; i < 45; ++i)
+    {
+        file.write(line(i));
+    }
+    file.flush();
+
+    // 10 lines per file, the oldest 15 were rotated out
+    EXPECT_EQ(read(file.path()).size(), 500u);
+    EXPECT_EQ(read(file.path()).substr(0, 8), "line 40 ");
+    EXPECT_EQ(read(file.rotatedPath(1, false)).substr(0, 8), "line 30 ");
+    EXPECT_EQ(read(file.rotatedPath(2, false)).substr(0, 8), "line 20 ");
+    EXPECT_FALSE(fs::exists(file.rotatedPath(3, false)));
+}
+
+TEST_F(GALogFileTest, StaysWithinDiskBudget)
+{
+    GALogFile::Options options;
+    options.maxFileSize = 1000;
+    options.maxFiles    = 10;
+    options.diskBudget  = 3500;
+    options.bufferSize  = 100;
+
+    GALogFile file;
+    file.setOptions(options);
+    ASSERT_TRUE(file.open(directory(), "ga_log"));
+
+    for(int i = 0; i < 200; ++i)
+    {
+        file.write(line(i));
+        file.flush();
+        EXPECT_LE(totalSize(), options.diskBudget);
+    }
+
+    // the current file plus the two newest rotated ones fit
+    EXPECT_TRUE(fs::exists(file.rotatedPath(2, false)));
+    EXPECT_FALSE(fs::exists(file.rotatedPath(3, false)));
+}
+
+TEST_F(GALogFileTest, CompressesRotatedFiles)
+{
+    GALogFile::Options options;
+    options.maxFileSize     = 10000;
+    options.maxFiles        = 2;
+    options.compressRotated = true;
+
+    GALogFile file;
+    file.setOptions(options);
+    ASSERT_TRUE(file.open(directory(), "ga_log"));
+
+    for(int i = 0; i < 101; ++i)
+    {
+        file.write(line(i));
+    }
+    file.flush();
+
+    EXPECT_FALSE(fs::exists(file.rotatedPath(1, false)));
+    ASSERT_TRUE(fs::exists(file.rotatedPath(1, true)));
+
+    const std::string compressed = read(file.rotatedPath(1, true));
+    ASSERT_GE(compressed.size(), 2u);
+    EXPECT_EQ(static_cast<unsigned char>(compressed[0]), 0x1f);
+    EXPECT_EQ(static_cast<unsigned char>(compressed[1]), 0x8b);
+    EXPECT_LT(compressed.size(), 10000u / 4);
+}
+
+TEST_F(GALogFileTest, KeepsLogOfLastRun)
+{
+    {
+        GALogFile file;
+        ASSERT_TRUE(file.open(directory(), "ga_log"));
+        file.write("last run");
+    }
+
+    GALogFile file;
+    ASSERT_TRUE(file.open(directory(), "ga_log"));
+
+    EXPECT_EQ(read(file.path()), "");
+    EXPECT_EQ(read(file.rotatedPath(1, false)), "last run\n");
+}
+
+} // namespace
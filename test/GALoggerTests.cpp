@@ -0,0 +1,260 @@
+//
+// GA-SDK-CPP
+// Tests for the asynchronous logger queue
+//
+
+#include <gtest/gtest.h>
+
+#include "GALogger.h"
+
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using gameanalytics::logging::GALogger;
+using gameanalytics::EGALoggerMessageType;
+
+// messages of these tests, the sdk may log from its own threads meanwhile
+constexpr const char* MESSAGE_PREFIX = "GameAnalytics : LoggerTest:";
+constexpr const char* DROPPED_SUFFIX = " log messages were dropped, the log queue was full";
+
+struct Received
+{
+    std::mutex               mutex;
+    std::vector<std::string> messages;
+    std::vector<std::size_t> dropped;
+    std::thread::id          thread;
+
+    void add(std::string const& message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const std::size_t prefix = message.find(MESSAGE_PREFIX);
+        if(prefix != std::string::npos)
+        {
+            messages.push_back(message.substr(prefix + std::strlen(MESSAGE_PREFIX)));
+            thread = std::this_thread::get_id();
+        }
+        else if(message.find(DROPPED_SUFFIX) != std::string::npos)
+        {
+            dropped.push_back(std::stoul(message.substr(std::strlen("Warning/GameAnalytics : "))));
+        }
+    }
+};
+
+class GALoggerTest : public ::testing::Test
+{
+    protected:
+
+        void TearDown() override
+        {
+            GALogger::flush();
+            GALogger::setCustomLogHandler({});
+        }
+};
+
+TEST_F(GALoggerTest, DeliversMessagesInOrderOnDrainThread)
+{
+    Received received;
+    GALogger::setCustomLogHandler([&received](std::string const& message, EGALoggerMessageType)
+    {
+        received.add(message);
+    });
+
+    for(int i = 0; i < 100; ++i)
+    {
+        GALogger::w("LoggerTest:%d", i);
+    }
+
+    ASSERT_TRUE(GALogger::flush());
+
+    std::lock_guard<std::mutex> lock(received.mutex);
+    ASSERT_EQ(received.messages.size(), 100u);
+    for(int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(received.messages[i], std::to_string(i));
+    }
+    EXPECT_NE(received.thread, std::this_thread::get_id());
+}
+
+TEST_F(GALoggerTest, AcceptsConcurrentProducers)
+{
+    constexpr int THREADS  = 4;
+    constexpr int MESSAGES = 25;
+
+    Received received;
+    GALogger::setCustomLogHandler([&received](std::string const& message, EGALoggerMessageType)
+    {
+        received.add(message);
+    });
+
+    std::vector<std::thread> producers;
+    for(int t = 0; t < THREADS; ++t)
+    {
+        producers.emplace_back([t]()
+        {
+            for(int i = 0; i < MESSAGES; ++i)
+            {
+                GALogger::w("LoggerTest:%d:%d", t, i);
+            }
+        });
+    }
+
+    for(std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_TRUE(GALogger::flush());
+
+    std::lock_guard<std::mutex> lock(received.mutex);
+    ASSERT_EQ(received.messages.size(), static_cast<std::size_t>(THREADS * MESSAGES));
+
+    // every producer's messages keep their order
+    std::vector<int> next(THREADS, 0);
+    for(std::string const& message : received.messages)
+    {
+        const std::size_t colon = message.find(':');
+        const int t = std::stoi(message.substr(0, colon));
+        const int i = std::stoi(message.substr(colon + 1));
+
+        ASSERT_LT(t, THREADS);
+        EXPECT_EQ(i, next[t]++);
+    }
+}
+
+TEST_F(GALoggerTest, DropsWhenFullAndReportsCount)
+{
+    constexpr std::size_t OVERFLOW_COUNT = 10;
+
+    Received received;
+    std::promise<void> entered;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    GALogger::setCustomLogHandler([&, released](std::string const& message, EGALoggerMessageType)
+    {
+        if(message.find("LoggerTest:block") != std::string::npos)
+        {
+            entered.set_value();
+            released.wait();
+            return;
+        }
+        received.add(message);
+    });
+
+    // holds the drain thread so the queue fills up
+    GALogger::w("LoggerTest:block");
+    entered.get_future().wait();
+
+    for(std::size_t i = 0; i < GALogger::QUEUE_CAPACITY + OVERFLOW_COUNT; ++i)
+    {
+        GALogger::w("LoggerTest:%zu", i);
+    }
+
+    release.set_value();
+    ASSERT_TRUE(GALogger::flush());
+
+    std::lock_guard<std::mutex> lock(received.mutex);
+
+    std::size_t dropped = 0;
+    for(std::size_t count : received.dropped)
+    {
+        dropped += count;
+    }
+
+    EXPECT_LE(received.messages.size(), GALogger::QUEUE_CAPACITY);
+    EXPECT_GE(dropped, OVERFLOW_COUNT);
+
+    // the oldest messages are kept
+    ASSERT_FALSE(received.messages.empty());
+    EXPECT_EQ(received.messages.front(), "0");
+}
+
+TEST_F(GALoggerTest, FormatsOnDrainThreadLikeSnprintf)
+{
+    Received received;
+    GALogger::setCustomLogHandler([&received](std::string const& message, EGALoggerMessageType)
+    {
+        received.add(message);
+    });
+
+    const std::string text = "copied";
+    const char* format = "LoggerTest:%d %u %ld %lld %zu %.2f %s|%8s|%-4d|%x %c %% %5.1e %s";
+
+    GALogger::w(format, -7, 7u, -70000L, -7000000000LL, static_cast<std::size_t>(42), 3.14159, text.c_str(), "right", 3, 255u, 'z', 12345.678, static_cast<const char*>(nullptr));
+    GALogger::w("LoggerTest:%*d", 6, 12);
+
+    char expected[256];
+    std::snprintf(expected, sizeof(expected), format, -7, 7u, -70000L, -7000000000LL, static_cast<std::size_t>(42), 3.14159, text.c_str(), "right", 3, 255u, 'z', 12345.678, "(null)");
+
+    ASSERT_TRUE(GALogger::flush());
+
+    std::lock_guard<std::mutex> lock(received.mutex);
+    ASSERT_EQ(received.messages.size(), 2u);
+    EXPECT_EQ("LoggerTest:" + received.messages[0], expected);
+    EXPECT_EQ(received.messages[1], "    12");
+}
+
+TEST_F(GALoggerTest, LazyMacrosSkipArgumentsOfDisabledLevels)
+{
+    Received received;
+    GALogger::setCustomLogHandler([&received](std::string const& message, EGALoggerMessageType)
+    {
+        received.add(message);
+    });
+
+    int evaluated = 0;
+    auto expensive = [&evaluated]()
+    {
+        ++evaluated;
+        return std::string("dump");
+    };
+
+    GALogger::setVerboseInfoLog(false);
+    GA_LOG_VERBOSE("LoggerTest:%s", expensive().c_str());
+    EXPECT_EQ(evaluated, 0);
+
+    // levels above GA_LOG_LEVEL expand to this
+    GA_LOG_REMOVED(w, "LoggerTest:%s", expensive().c_str());
+    EXPECT_EQ(evaluated, 0);
+
+    GALogger::setVerboseInfoLog(true);
+    GA_LOG_VERBOSE("LoggerTest:%s", expensive().c_str());
+    GALogger::setVerboseInfoLog(false);
+    EXPECT_EQ(evaluated, 1);
+
+    GA_LOG_WARNING("LoggerTest:%s", expensive().c_str());
+    EXPECT_EQ(evaluated, 2);
+
+    ASSERT_TRUE(GALogger::flush());
+
+    std::lock_guard<std::mutex> lock(received.mutex);
+    EXPECT_EQ(received.messages, std::vector<std::string>({"dump", "dump"}));
+}
+
+TEST_F(GALoggerTest, TruncatesLongMessages)
+{
+    Received received;
+    GALogger::setCustomLogHandler([&received](std::string const& message, EGALoggerMessageType)
+    {
+        received.add(message);
+    });
+
+    const std::string text(GALogger::MAX_MESSAGE_SIZE * 2, 'x');
+    GALogger::w("LoggerTest:%s", text.c_str());
+
+    ASSERT_TRUE(GALogger::flush());
+
+    std::lock_guard<std::mutex> lock(received.mutex);
+    ASSERT_EQ(received.messages.size(), 1u);
+    EXPECT_EQ(received.messages[0].size(), GALogger::MAX_MESSAGE_SIZE - 1 - std::strlen("LoggerTest:"));
+}
+
+} // namespace
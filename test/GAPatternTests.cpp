@@ -0,0 +1,86 @@
+//
+// GA-SDK-CPP
+// Tests for the regex-free matchers and the validators built on them
+//
+
+#include <gtest/gtest.h>
+
+#include "GAPattern.h"
+#include "GAValidator.h"
+
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using namespace gameanalytics;
+using utilities::CharacterClass;
+
+constexpr CharacterClass WORD("a-zA-Z0-9_");
+constexpr CharacterClass EVENT_PART("-A-Za-z0-9_.()!?\\s");
+
+static_assert(WORD.contains('_') && !WORD.contains('-'), "ranges and literals");
+static_assert(EVENT_PART.contains('-') && EVENT_PART.contains('\t') && !EVENT_PART.contains(','), "leading '-' and \\s");
+static_assert(CharacterClass(":").negated().contains('\xff') && !CharacterClass(":").negated().contains(':'), "negation");
+static_assert(utilities::matchRun("abc_1", WORD, 1, 5) && !utilities::matchRun("abc_12", WORD, 1, 5), "run length");
+static_assert(utilities::matchSeparatedRuns("a:b:c", WORD, ':', 64, 3) && !utilities::matchSeparatedRuns("a:b:c", WORD, ':', 64, 2), "run count");
+
+// inputs around the edges of every pattern, checked against the regexes the validators used to run
+const std::vector<std::string> INPUTS =
+{
+    "", " ", ":", "::", "a:", ":a", "a::b", "a:b:c:d:e", "a:b:c:d:e:f",
+    "USD", "usd", "US", "USDX", "U$D", "gems", "gold1", "Gold",
+    "name with spaces", "tab\there", "new\nline", "d_fk7-58.9)3!47", "d_fk,7", "[^_`]", "øææ",
+    std::string(64, 'x'), std::string(65, 'x'), std::string(64, 'x') + ":" + std::string(64, 'y'), std::string(64, 'x') + ":" + std::string(65, 'y'),
+    std::string(32, 'A'), std::string(32, '^'), std::string(31, 'A') + "{", std::string(40, 'z'), std::string(40, '0'),
+    "unity 1.2.3", "unity 1.2.3a", "unity 1.2.3-beta", "unity 1.2.3-gamma", "unity ", "unity .", "unity 1..", "unity 1.2.3.4",
+    "unity 123456", "unity 12345.12345.12345", "unity 1b", "unity -alpha", "air 1.0", "unity1.2", "Unity 1.2", "unity  1.2",
+    "apple", "google_play", "apple ", "wifi", "lan", "offline", "wwan", "wifi2",
+};
+
+TEST(GAPattern, MatchersAgreeWithTheRegexes)
+{
+    using validators::GAValidator;
+
+    struct Case
+    {
+        const char* pattern;
+        bool (*validate)(std::string const&);
+    };
+
+    const Case cases[] =
+    {
+        {"^[A-Z]{3}$",                                                   [](std::string const& s) { return GAValidator::validateCurrency(s); }},
+        {"^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}$",                    [](std::string const& s) { return GAValidator::validateEventPartCharacters(s); }},
+        {"^[^:]{1,64}(?::[^:]{1,64}){0,4}$",                             [](std::string const& s) { return GAValidator::validateEventIdLength(s); }},
+        {"^[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}(:[A-Za-z0-9\\s\\-_\\.\\(\\)\\!\\?]{1,64}){0,4}$",
+                                                                         [](std::string const& s) { return GAValidator::validateEventIdCharacters(s); }},
+        {"^(unity|unreal|corona|cocos2d|lumberyard|air|gamemaker|defold|godot) [0-9]{0,5}(\\.[0-9]{0,5}){0,2}(-alpha|-beta|a|b){0,1}$",
+                                                                         [](std::string const& s) { return GAValidator::validateSdkWrapperVersion(s); }},
+        {"^(unity|unreal|corona|cocos2d|lumberyard|gamemaker|defold|godot) [0-9]{0,5}(\\.[0-9]{0,5}){0,2}$",
+                                                                         [](std::string const& s) { return GAValidator::validateEngineVersion(s); }},
+        {"^(apple|google_play)$",                                        [](std::string const& s) { return GAValidator::validateStore(s); }},
+        {"^(wwan|wifi|lan|offline)$",                                    [](std::string const& s) { return GAValidator::validateConnectionType(s); }},
+        {"^[A-z0-9]{32}$",                                               [](std::string const& s) { return GAValidator::validateKeys(s, std::string(40, 'a')); }},
+    };
+
+    for(Case const& c : cases)
+    {
+        const std::regex expression(c.pattern);
+        for(std::string const& input : INPUTS)
+        {
+            EXPECT_EQ(c.validate(input), std::regex_match(input, expression)) << c.pattern << " on '" << input << "'";
+        }
+    }
+}
+
+TEST(GAPattern, ResourceCurrenciesAreLettersOnly)
+{
+    EXPECT_TRUE(validators::GAValidator::validateResourceCurrencies({"gems", "Gold"}));
+    EXPECT_FALSE(validators::GAValidator::validateResourceCurrencies({"gems", "gold1"}));
+    EXPECT_FALSE(validators::GAValidator::validateResourceCurrencies({"gems", "go ld"}));
+}
+
+} // namespace
@@ -0,0 +1,137 @@
+//
+// GA-SDK-CPP
+// Tests for the single pass json -> gzip -> hmac request encoder
+//
+
+#include <gtest/gtest.h>
+
+#include "GAPayloadEncoder.h"
+#include "GAUtilities.h"
+
+#define MINIZ_HEADER_FILE_ONLY
+#include "GA_Zip.cpp"
+
+#include <cstdlib>
+
+namespace
+{
+
+using gameanalytics::json;
+using gameanalytics::utilities::GAPayloadEncoder;
+using gameanalytics::utilities::GAJsonWriter;
+using gameanalytics::utilities::GAUtilities;
+
+uint32_t readLittleEndian(const uint8_t* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// checks the gzip framing and returns the inflated content
+std::string gunzip(std::vector<uint8_t> const& data)
+{
+    EXPECT_GE(data.size(), 18u);
+    EXPECT_EQ(data[0], 0x1f);
+    EXPECT_EQ(data[1], 0x8b);
+
+    size_t outSize = 0;
+    void* out = gameanalytics::utilities::zip::tinfl_decompress_mem_to_heap(data.data() + 10, data.size() - 18, &outSize, 0);
+    if(!out)
+    {
+        ADD_FAILURE() << "inflate failed";
+        return {};
+    }
+
+    std::string result(static_cast<const char*>(out), outSize);
+    std::free(out);
+
+    const uint8_t* trailer = data.data() + data.size() - 8;
+    EXPECT_EQ(readLittleEndian(trailer), static_cast<uint32_t>(gameanalytics::utilities::zip::mz_crc32(0, reinterpret_cast<const unsigned char*>(result.data()), result.size())));
+    EXPECT_EQ(readLittleEndian(trailer + 4), static_cast<uint32_t>(result.size()));
+
+    return result;
+}
+
+std::string expectedAuth(std::string const& key, std::vector<uint8_t> const& payload)
+{
+    std::vector<uint8_t> mac;
+    GAUtilities::hmacWithKey(key.c_str(), payload, mac);
+    return "Authorization: " + std::string(reinterpret_cast<const char*>(mac.data()));
+}
+
+TEST(GAPayloadEncoder, PlainPayloadIsSignedAsIs)
+{
+    GAPayloadEncoder encoder(false, "test1");
+    encoder.write("test2");
+    ASSERT_TRUE(encoder.finish());
+
+    EXPECT_EQ(std::string(encoder.payload().begin(), encoder.payload().end()), "test2");
+    EXPECT_EQ(encoder.authorization(), "Authorization: E+sBF4BA9mLvVlfwHx53G2poUPwEUZ1f37oVrgHhOFQ=");
+    EXPECT_EQ(encoder.signature(), "E+sBF4BA9mLvVlfwHx53G2poUPwEUZ1f37oVrgHhOFQ=");
+}
+
+TEST(GAPayloadEncoder, GzipRoundTrip)
+{
+    const std::string input = R"([{"category":"design","event_id":"Combat:Hit:Sword","value":42.5}])";
+
+    GAPayloadEncoder encoder(true, "secret");
+    encoder.write(input);
+    ASSERT_TRUE(encoder.finish());
+
+    EXPECT_EQ(gunzip(encoder.payload()), input);
+    EXPECT_EQ(encoder.inputSize(), input.size());
+
+    // signature covers the compressed bytes
+    EXPECT_EQ(encoder.authorization(), expectedAuth("secret", encoder.payload()));
+}
+
+TEST(GAPayloadEncoder, StreamedChunksMatchContent)
+{
+    std::string input;
+    GAPayloadEncoder encoder(true, "secret");
+
+    // larger than the output buffer so it has to grow several times
+    for(int i = 0; i < 20000; ++i)
+    {
+        const std::string chunk = R"({"event_id":"Item:)" + std::to_string(i * 7919) + R"(","value":)" + std::to_string(i) + "},";
+        input += chunk;
+        encoder.write(chunk);
+    }
+
+    ASSERT_TRUE(encoder.finish());
+
+    EXPECT_EQ(gunzip(encoder.payload()), input);
+    EXPECT_EQ(encoder.authorization(), expectedAuth("secret", encoder.payload()));
+}
+
+TEST(GAPayloadEncoder, DrainsJsonWriter)
+{
+    json events = json::array();
+    events.push_back({{"category", "design"}, {"event_id", "a:b"}});
+    events.push_back({{"category", "error"}, {"message", "line\nbreak"}});
+
+    GAPayloadEncoder encoder(true);
+    GAJsonWriter writer;
+
+    writer.beginArray();
+    for(json const& event : events)
+    {
+        writer.value(event);
+        encoder.write(writer);
+        EXPECT_EQ(writer.size(), 0u);
+    }
+    writer.endArray();
+    encoder.write(writer);
+
+    ASSERT_TRUE(encoder.finish());
+
+    EXPECT_EQ(gunzip(encoder.payload()), events.dump());
+    EXPECT_TRUE(encoder.authorization().empty());
+}
+
+TEST(GAPayloadEncoder, GzipCompressUsesEncoder)
+{
+    const std::string input = "hello hello hello hello";
+    EXPECT_EQ(gunzip(GAUtilities::gzipCompress(input)), input);
+}
+
+} // namespace
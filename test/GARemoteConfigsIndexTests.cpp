@@ -0,0 +1,119 @@
+//
+// GA-SDK-CPP
+// Tests for the remote configs index and its publisher
+//
+
+#include <gtest/gtest.h>
+
+#include "GARemoteConfigsIndex.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using gameanalytics::json;
+using gameanalytics::state::GARemoteConfigsIndex;
+using gameanalytics::state::GARemoteConfigsPublisher;
+
+std::shared_ptr<const GARemoteConfigsIndex> makeIndex(int version)
+{
+    return std::make_shared<const GARemoteConfigsIndex>(json::array({
+        {{"key", "version"}, {"value", version}},
+        {{"key", "check"},   {"value", version}},
+        {{"key", "name"},    {"value", "configs " + std::to_string(version)}}
+    }));
+}
+
+TEST(GARemoteConfigsIndex, FindsValuesByKey)
+{
+    GARemoteConfigsIndex index(json::array({
+        {{"key", "difficulty"}, {"value", "hard"}},
+        {{"key", "lives"},      {"value", 3}},
+        {{"key", "difficulty"}, {"value", "easy"}},
+        {{"key", 5},            {"value", "no string key"}},
+        {{"value", "no key"}}
+    }));
+
+    ASSERT_NE(index.find("difficulty"), nullptr);
+    EXPECT_EQ(*index.find("difficulty"), "hard");
+    EXPECT_EQ(*index.find("lives"), 3);
+    EXPECT_EQ(index.find("speed"), nullptr);
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_EQ(index.configs().size(), 5u);
+}
+
+TEST(GARemoteConfigsIndex, ChangedKeys)
+{
+    GARemoteConfigsIndex before(json::array({
+        {{"key", "same"},    {"value", "1"}},
+        {{"key", "changed"}, {"value", "1"}},
+        {{"key", "removed"}, {"value", "1"}}
+    }));
+    GARemoteConfigsIndex after(json::array({
+        {{"key", "added"},   {"value", "1"}},
+        {{"key", "same"},    {"value", "1"}},
+        {{"key", "changed"}, {"value", 1}}
+    }));
+
+    EXPECT_EQ(GARemoteConfigsIndex::changedKeys(before, after), gameanalytics::StringVector({"added", "changed", "removed"}));
+    EXPECT_TRUE(GARemoteConfigsIndex::changedKeys(after, after).empty());
+    EXPECT_EQ(GARemoteConfigsIndex::changedKeys(GARemoteConfigsIndex(), before), gameanalytics::StringVector({"changed", "removed", "same"}));
+}
+
+TEST(GARemoteConfigsIndex, ReadersSeeWholeIndexes)
+{
+    GARemoteConfigsPublisher publisher;
+    EXPECT_EQ(publisher.current().find("version"), nullptr);
+
+    publisher.publish(makeIndex(0));
+    EXPECT_EQ(*publisher.current().find("version"), 0);
+
+    constexpr int UPDATES = 200;
+
+    std::atomic<bool> done{false};
+    std::atomic<int>  torn{0};
+
+    std::vector<std::thread> readers;
+    for(int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]()
+        {
+            while(!done)
+            {
+                GARemoteConfigsIndex const& index = publisher.current();
+
+                const int version = index.find("version")->get<int>();
+                if(version != index.find("check")->get<int>())
+                {
+                    ++torn;
+                }
+            }
+
+            // the latest index is visible once it is published
+            if(publisher.current().find("version")->get<int>() != UPDATES)
+            {
+                ++torn;
+            }
+        });
+    }
+
+    for(int version = 1; version <= UPDATES; ++version)
+    {
+        publisher.publish(makeIndex(version));
+        std::this_thread::yield();
+    }
+    done = true;
+
+    for(std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(*publisher.load()->find("name"), "configs 200");
+}
+
+} // namespace
@@ -0,0 +1,165 @@
+//
+// GA-SDK-CPP
+// Tests for typed remote config handles and key listeners
+//
+
+#include <gtest/gtest.h>
+
+#include "GARemoteConfigsRegistry.h"
+
+namespace
+{
+
+using gameanalytics::json;
+using gameanalytics::RemoteConfig;
+using gameanalytics::StringVector;
+using gameanalytics::state::GARemoteConfigsIndex;
+using gameanalytics::state::GARemoteConfigsPublisher;
+using gameanalytics::state::GARemoteConfigsRegistry;
+
+struct KeyListener : gameanalytics::IRemoteConfigsKeyListener
+{
+    void onRemoteConfigsChanged(StringVector const& changedKeys) override
+    {
+        calls.push_back(changedKeys);
+    }
+
+    std::vector<StringVector> calls;
+};
+
+// publishes configs and updates the registry like GAState does
+void publish(GARemoteConfigsPublisher& publisher, GARemoteConfigsRegistry& registry, json configs)
+{
+    auto index = std::make_shared<const GARemoteConfigsIndex>(std::move(configs));
+    const StringVector changedKeys = GARemoteConfigsIndex::changedKeys(*publisher.load(), *index);
+
+    publisher.publish(index);
+    registry.update(*index, changedKeys);
+}
+
+TEST(GARemoteConfigsRegistry, HandlesHoldParsedValues)
+{
+    GARemoteConfigsPublisher publisher;
+    GARemoteConfigsRegistry registry;
+
+    publish(publisher, registry, json::array({
+        {{"key", "lives"},      {"value", "3"}},
+        {{"key", "speed"},      {"value", "1.5"}},
+        {{"key", "hardcore"},   {"value", "true"}},
+        {{"key", "difficulty"}, {"value", "hard"}},
+        {{"key", "count"},      {"value", 12}},
+        {{"key", "bad_int"},    {"value", "3 lives"}},
+        {{"key", "too_big"},    {"value", "9999999999"}}
+    }));
+
+    EXPECT_EQ(registry.bind<int>("lives", 1, publisher).get(), 3);
+    EXPECT_EQ(registry.bind<int64_t>("too_big", 0, publisher).get(), 9999999999);
+    EXPECT_FLOAT_EQ(registry.bind<float>("speed", 1.0f, publisher).get(), 1.5f);
+    EXPECT_DOUBLE_EQ(registry.bind<double>("count", 0.0, publisher).get(), 12.0);
+    EXPECT_TRUE(registry.bind<bool>("hardcore", false, publisher).get());
+    EXPECT_EQ(registry.bind<std::string>("difficulty", "easy", publisher).get(), "hard");
+
+    // missing or unreadable values give the default
+    EXPECT_EQ(registry.bind<int>("bad_int", 7, publisher).get(), 7);
+    EXPECT_EQ(registry.bind<int>("too_big", 7, publisher).get(), 7);
+    EXPECT_EQ(registry.bind<bool>("difficulty", true, publisher).get(), true);
+    EXPECT_EQ(registry.bind<std::string>("count", "none", publisher).get(), "none");
+    EXPECT_EQ(registry.bind<int>("missing", 5, publisher).get(), 5);
+
+    RemoteConfig<int> unbound;
+    EXPECT_FALSE(unbound);
+    EXPECT_EQ(unbound.get(), 0);
+}
+
+TEST(GARemoteConfigsRegistry, HandlesFollowUpdates)
+{
+    GARemoteConfigsPublisher publisher;
+    GARemoteConfigsRegistry registry;
+
+    RemoteConfig<int>         lives      = registry.bind<int>("lives", 1, publisher);
+    RemoteConfig<std::string> difficulty = registry.bind<std::string>("difficulty", "easy", publisher);
+
+    EXPECT_EQ(lives.key(), "lives");
+    EXPECT_EQ(lives.get(), 1);
+    EXPECT_EQ(lives.version(), 0u);
+
+    publish(publisher, registry, json::array({
+        {{"key", "lives"},      {"value", "3"}},
+        {{"key", "difficulty"}, {"value", "hard"}}
+    }));
+
+    EXPECT_EQ(lives.get(), 3);
+    EXPECT_EQ(lives.version(), 1u);
+    EXPECT_EQ(difficulty.get(), "hard");
+    EXPECT_EQ(difficulty.version(), 1u);
+
+    // only the changed key moves
+    publish(publisher, registry, json::array({
+        {{"key", "lives"},      {"value", "3"}},
+        {{"key", "difficulty"}, {"value", "nightmare"}}
+    }));
+
+    EXPECT_EQ(lives.version(), 1u);
+    EXPECT_EQ(difficulty.get(), "nightmare");
+    EXPECT_EQ(difficulty.version(), 2u);
+
+    // a removed key goes back to the default
+    publish(publisher, registry, json::array({
+        {{"key", "difficulty"}, {"value", "nightmare"}}
+    }));
+
+    EXPECT_EQ(lives.get(), 1);
+    EXPECT_EQ(lives.version(), 2u);
+}
+
+TEST(GARemoteConfigsRegistry, DroppedHandlesAreForgotten)
+{
+    GARemoteConfigsPublisher publisher;
+    GARemoteConfigsRegistry registry;
+
+    RemoteConfig<int> kept = registry.bind<int>("lives", 1, publisher);
+    {
+        RemoteConfig<int> dropped = registry.bind<int>("lives", 2, publisher);
+        EXPECT_EQ(registry.boundCount(), 2u);
+    }
+    EXPECT_EQ(registry.boundCount(), 1u);
+
+    publish(publisher, registry, json::array({{{"key", "lives"}, {"value", "4"}}}));
+    EXPECT_EQ(kept.get(), 4);
+}
+
+TEST(GARemoteConfigsRegistry, ListenersHearAboutTheirKeys)
+{
+    GARemoteConfigsPublisher publisher;
+    GARemoteConfigsRegistry registry;
+
+    auto livesListener = std::make_shared<KeyListener>();
+    auto allListener   = std::make_shared<KeyListener>();
+
+    registry.addListener({"lives"}, livesListener);
+    registry.addListener({}, allListener);
+
+    publish(publisher, registry, json::array({
+        {{"key", "lives"}, {"value", "3"}},
+        {{"key", "speed"}, {"value", "2"}}
+    }));
+    publish(publisher, registry, json::array({
+        {{"key", "lives"}, {"value", "3"}},
+        {{"key", "speed"}, {"value", "4"}}
+    }));
+
+    ASSERT_EQ(livesListener->calls.size(), 1u);
+    EXPECT_EQ(livesListener->calls[0], StringVector({"lives"}));
+
+    ASSERT_EQ(allListener->calls.size(), 2u);
+    EXPECT_EQ(allListener->calls[0], StringVector({"lives", "speed"}));
+    EXPECT_EQ(allListener->calls[1], StringVector({"speed"}));
+
+    registry.removeListener(allListener);
+    publish(publisher, registry, json::array());
+
+    EXPECT_EQ(livesListener->calls.size(), 2u);
+    EXPECT_EQ(allListener->calls.size(), 2u);
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+//
+// GA-SDK-CPP
+// Tests for the aggregation and hourly cap of sdk error events
+//
+
+#include <gtest/gtest.h>
+
+#include "GAHTTPApi.h"
+
+namespace
+{
+
+using namespace gameanalytics::http;
+
+constexpr int64_t NOW = 1700000000;
+
+TEST(GASdkErrorQueue, CountsIdenticalErrors)
+{
+    GASdkErrorQueue queue;
+
+    for(int i = 0; i < 50; ++i)
+    {
+        queue.add(EventValidation, DesignEvent, InvalidEventIdLength, EventId, i == 0 ? "first" : "later");
+    }
+    queue.add(EventValidation, DesignEvent, InvalidEventIdCharacters, EventId, "");
+
+    std::vector<GASdkErrorQueue::Entry> entries = queue.take(NOW);
+    ASSERT_EQ(entries.size(), 2u);
+
+    EXPECT_EQ(entries[0].action, InvalidEventIdLength);
+    EXPECT_EQ(entries[0].count, 50);
+    EXPECT_EQ(entries[0].reason, "first");
+
+    EXPECT_EQ(entries[1].action, InvalidEventIdCharacters);
+    EXPECT_EQ(entries[1].count, 1);
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.take(NOW).empty());
+}
+
+TEST(GASdkErrorQueue, DifferentParametersAreSeparate)
+{
+    GASdkErrorQueue queue;
+    queue.add(EventValidation, BusinessEvent, StringEmptyOrNull, ItemType, "");
+    queue.add(EventValidation, BusinessEvent, StringEmptyOrNull, ItemId, "");
+
+    EXPECT_EQ(queue.take(NOW).size(), 2u);
+}
+
+TEST(GASdkErrorQueue, HourlyCapPerCategoryAndArea)
+{
+    GASdkErrorQueue queue;
+
+    // one distinct error per flush, the cap counts sent entries per category and area
+    for(int i = 0; i < GASdkErrorQueue::MaxPerHour; ++i)
+    {
+        queue.add(EventValidation, ResourceEvent, InvalidAmount, Amount, "");
+        EXPECT_EQ(queue.take(NOW + i).size(), 1u);
+    }
+
+    queue.add(EventValidation, ResourceEvent, InvalidAmount, Amount, "");
+    queue.add(EventValidation, ResourceEvent, InvalidAmount, Amount, "");
+    queue.add(Database, AddEventsToStore, DatabaseTooLarge, Currency, "");
+
+    std::vector<GASdkErrorQueue::Entry> entries = queue.take(NOW + 60);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].category, Database);
+    EXPECT_EQ(queue.getDropped(), 2);
+
+    // a new window starts an hour after the first send
+    queue.add(EventValidation, ResourceEvent, InvalidAmount, Amount, "");
+    EXPECT_EQ(queue.take(NOW + GASdkErrorQueue::CapWindow).size(), 1u);
+}
+
+} // namespace
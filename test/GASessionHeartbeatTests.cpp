@@ -0,0 +1,255 @@
+//
+// GA-SDK-CPP
+// Tests for the ga_session heartbeat used to recover a missing session_end
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <tuple>
+
+#include "helpers/GATestSession.h"
+
+#include "GAEvents.h"
+#include "GAHTTPApi.h"
+#include "GAState.h"
+#include "GAStore.h"
+
+namespace
+{
+
+using namespace gameanalytics;
+using namespace std::chrono_literals;
+using events::GAEvents;
+using state::GAState;
+
+// answers every init call with new ab ids, everything else fails like without a connection
+class AbTestingClient : public GAHttpClient
+{
+    public:
+
+        void initialize() override {}
+        void cleanup() override {}
+
+        Response sendRequest(std::string const& url, std::string const&, std::vector<uint8_t> const&, bool, void*) override
+        {
+            Response response;
+            if(url.find("/init") == std::string::npos)
+            {
+                return response;
+            }
+
+            const std::string n = std::to_string(++_inits);
+
+            json body;
+            body["server_ts"]     = static_cast<int64_t>(std::time(nullptr));
+            body["configs_hash"]  = "heartbeat_" + n;
+            body["ab_id"]         = "ab_" + n;
+            body["ab_variant_id"] = "variant_" + n;
+
+            response.code = 201;
+
+            const std::string text = body.dump();
+            response.packet.assign(text.begin(), text.end());
+            return response;
+        }
+
+    private:
+
+        std::atomic<int> _inits{0};
+};
+
+class GASessionHeartbeat : public ::testing::Test
+{
+    protected:
+
+        void SetUp() override
+        {
+            _interval = GATestSession::onGAThread([]() { return GAEvents::getSessionHeartbeatInterval(); });
+        }
+
+        void TearDown() override
+        {
+            GATestSession::onGAThread([this]()
+            {
+                GAEvents::setSessionHeartbeatInterval(_interval);
+                return 0;
+            });
+        }
+
+        static std::string currentSessionId()
+        {
+            return GATestSession::onGAThread([]() { return GAState::getSessionId(); });
+        }
+
+        GATestSession        session;
+        std::chrono::seconds _interval{};
+};
+
+TEST_F(GASessionHeartbeat, IsDueOnceTheIntervalPassed)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto [before, after] = GATestSession::onGAThread([]()
+    {
+        GAEvents::setSessionHeartbeatInterval(5s);
+
+        const Clock::time_point before = Clock::now();
+        GAEvents::writeSessionHeartbeat();
+        return std::make_pair(before, Clock::now());
+    });
+
+    GATestSession::onGAThread([before = before, after = after]()
+    {
+        EXPECT_FALSE(GAEvents::isSessionHeartbeatDue(before + 4s));
+        EXPECT_TRUE(GAEvents::isSessionHeartbeatDue(after + 5s));
+
+        // shorter than a second is raised to one
+        GAEvents::setSessionHeartbeatInterval(0s);
+        EXPECT_EQ(GAEvents::getSessionHeartbeatInterval(), 1s);
+        EXPECT_FALSE(GAEvents::isSessionHeartbeatDue(before + 500ms));
+        EXPECT_TRUE(GAEvents::isSessionHeartbeatDue(after + 1s));
+        return 0;
+    });
+}
+
+TEST_F(GASessionHeartbeat, RowFollowsDimensionsFieldsAndSession)
+{
+    const std::string sessionId = currentSessionId();
+    ASSERT_FALSE(sessionId.empty());
+
+    const auto [previousDimension, previousFields] = GATestSession::onGAThread([]()
+    {
+        const std::string dimension = GAState::getCurrentCustomDimension01();
+        const std::string fields    = GAState::getValidatedCustomFields().dump();
+
+        // the snapshot was built by the session start, setting these must rebuild it
+        GAState::setCustomDimension01("heartbeat_dimension");
+        GAState::setGlobalCustomEventFields(R"({"heartbeat_field":7})");
+        GAEvents::writeSessionHeartbeat();
+
+        return std::make_pair(dimension, fields);
+    });
+
+    json row = GATestSession::sessionRow(sessionId);
+    ASSERT_TRUE(row.is_object());
+    EXPECT_EQ(row["event"].value("custom_01", ""), "heartbeat_dimension");
+    ASSERT_TRUE(row["event"].contains("custom_fields"));
+    EXPECT_EQ(row["event"]["custom_fields"].value("heartbeat_field", 0), 7);
+
+    // a new session writes its own row, not the snapshot of the previous one
+    const std::string nextSessionId = GATestSession::onGAThread([]()
+    {
+        GAState::endSessionAndStopQueue(false);
+        GAState::resumeSessionAndStartQueue();
+        return GAState::getSessionId();
+    });
+    session.track(nextSessionId);
+
+    ASSERT_NE(nextSessionId, sessionId);
+    EXPECT_TRUE(GATestSession::sessionRow(sessionId).is_null());
+
+    row = GATestSession::sessionRow(nextSessionId);
+    ASSERT_TRUE(row.is_object());
+    EXPECT_EQ(row["event"].value("session_id", ""), nextSessionId);
+
+    GATestSession::onGAThread([previousDimension = previousDimension, previousFields = previousFields]()
+    {
+        GAState::setCustomDimension01(previousDimension);
+        GAState::setGlobalCustomEventFields(previousFields == "null" ? "{}" : previousFields);
+        return 0;
+    });
+}
+
+TEST_F(GASessionHeartbeat, RecoversLengthOfSessionThatDidNotEnd)
+{
+    const std::string sessionId = currentSessionId();
+
+    GATestSession::onGAThread([]()
+    {
+        GAEvents::setSessionHeartbeatInterval(5s);
+        GAEvents::writeSessionHeartbeat();
+        return 0;
+    });
+
+    const json row = GATestSession::sessionRow(sessionId);
+    ASSERT_TRUE(row.is_object());
+
+    // the heartbeat is at most one interval old
+    const int64_t heartbeatTs = row["event"]["client_ts"].get<int64_t>();
+    EXPECT_LE(GAState::getClientTsAdjusted() - heartbeatTs, 5);
+
+    // the same row left behind by a session that started 30 seconds before its last heartbeat
+    // and was killed without a session_end
+    const std::string crashedSessionId = "heartbeat-test-crashed-session";
+    session.track(crashedSessionId);
+
+    json crashedEvent = row["event"];
+    crashedEvent["session_id"] = crashedSessionId;
+
+    GATestSession::onGAThread([&]()
+    {
+        store::GAStore::executeQuerySync("INSERT OR REPLACE INTO ga_session(session_id, timestamp, event) VALUES(?, ?, ?);",
+            {crashedSessionId, std::to_string(heartbeatTs - 30), crashedEvent.dump()});
+
+        GAEvents::getInstance().fixMissingSessionEndEvents();
+        return 0;
+    });
+
+    const json sessionEnds = GATestSession::storedEvents(crashedSessionId, "session_end");
+    ASSERT_EQ(sessionEnds.size(), 1u);
+    EXPECT_EQ(sessionEnds[0].value("length", -1), 30);
+    EXPECT_TRUE(GATestSession::sessionRow(crashedSessionId).is_null());
+}
+
+TEST_F(GASessionHeartbeat, RowFollowsConfigRefreshedAfterSessionStart)
+{
+    // the first session start caches a config, the second starts from it and refreshes it in the background
+    const auto [cachingSessionId, sessionId, cachedAbId] = GATestSession::onGAThread([]()
+    {
+        http::GAHTTPApi::setCustomHttpImpl(std::make_unique<AbTestingClient>());
+
+        GAState::endSessionAndStopQueue(false);
+        GAState::resumeSessionAndStartQueue();
+        const std::string cachingSessionId = GAState::getSessionId();
+        GAState::endSessionAndStopQueue(false);
+        GAState::resumeSessionAndStartQueue();
+
+        // builds the snapshot before the refreshed config arrives
+        GAEvents::writeSessionHeartbeat();
+        return std::make_tuple(cachingSessionId, GAState::getSessionId(), GAState::getAbId());
+    });
+    session.track(cachingSessionId);
+    session.track(sessionId);
+
+    ASSERT_FALSE(cachedAbId.empty());
+    EXPECT_EQ(GATestSession::sessionRow(sessionId)["event"].value("ab_id", ""), cachedAbId);
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while(GAState::getAbId() == cachedAbId && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(20ms);
+    }
+
+    const std::string refreshedAbId = GATestSession::onGAThread([]()
+    {
+        GAEvents::writeSessionHeartbeat();
+        return GAState::getAbId();
+    });
+    ASSERT_NE(refreshedAbId, cachedAbId);
+
+    // same session, new ab ids
+    const json row = GATestSession::sessionRow(sessionId);
+    ASSERT_TRUE(row.is_object());
+    EXPECT_EQ(row["event"].value("session_id", ""), sessionId);
+    EXPECT_EQ(row["event"].value("ab_id", ""), refreshedAbId);
+
+    GATestSession::onGAThread([]()
+    {
+        store::GAStore::setState("sdk_config_cached", "");
+        return 0;
+    });
+}
+
+} // namespace
@@ -0,0 +1,149 @@
+//
+// GA-SDK-CPP
+// Tests for starting sessions from the cached init config
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "GAHTTPApi.h"
+#include "GAState.h"
+#include "GAStore.h"
+#include "GAThreading.h"
+
+namespace
+{
+
+using namespace std::chrono_literals;
+using gameanalytics::GAHttpClient;
+using gameanalytics::json;
+
+constexpr const char* GAME_KEY    = "bd624ee6f8e6efb32a054f8d7ba11618";
+constexpr const char* GAME_SECRET = "7f5c3f682cbd217841efba92e92ffb1b3b6612bc";
+
+constexpr std::chrono::milliseconds INIT_DELAY = 1500ms;
+
+// answers the init call after INIT_DELAY like a slow network, everything else fails right away
+class DelayedInitClient : public GAHttpClient
+{
+    public:
+
+        void initialize() override {}
+        void cleanup() override {}
+
+        Response sendRequest(std::string const&, std::string const&, std::vector<uint8_t> const&, bool, void*) override
+        {
+            return {};
+        }
+
+        void sendRequestAsync(std::string const&, std::string const&, std::vector<uint8_t>, bool, void*, Callback callback) override
+        {
+            json body;
+            body["server_ts"]     = static_cast<int64_t>(std::time(nullptr));
+            body["configs_hash"]  = "refreshed";
+            body["ab_id"]         = "ab_refreshed";
+            body["ab_variant_id"] = "variant_refreshed";
+            body["configs"]       = json::array({ {{"key", "difficulty"}, {"value", "hard"}, {"id", "1"}, {"vsn", 2}} });
+
+            Response response;
+            response.code = 201;
+
+            const std::string text = body.dump();
+            response.packet.assign(text.begin(), text.end());
+
+            std::thread([callback, response]()
+            {
+                std::this_thread::sleep_for(INIT_DELAY);
+                callback(response);
+            }).detach();
+        }
+};
+
+class GASessionStart : public ::testing::Test
+{
+    protected:
+
+        void SetUp() override
+        {
+            using namespace gameanalytics;
+
+            state::GAState::setKeys(GAME_KEY, GAME_SECRET);
+            if(!store::GAStore::getTableReady())
+            {
+                ASSERT_TRUE(store::GAStore::ensureDatabase(false, GAME_KEY));
+            }
+
+            _previousClient = onGAThread([]()
+            {
+                return http::GAHTTPApi::setCustomHttpImpl(std::make_unique<DelayedInitClient>());
+            });
+        }
+
+        // later tests get the sdk as it was: no session, the previous client and no cached config
+        void TearDown() override
+        {
+            using namespace gameanalytics;
+
+            onGAThread([this]()
+            {
+                state::GAState::endSessionAndStopQueue(false);
+                http::GAHTTPApi::setCustomHttpImpl(std::move(_previousClient));
+                store::GAStore::setState("sdk_config_cached", "");
+                return 0;
+            });
+        }
+
+        // the http client and the session are used by the GA thread
+        template<typename Task>
+        static auto onGAThread(Task task) -> decltype(task())
+        {
+            auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(task);
+            auto result   = packaged->get_future();
+            gameanalytics::threading::GAThreading::performTaskOnGAThread([packaged]() { (*packaged)(); });
+            return result.get();
+        }
+
+        std::unique_ptr<GAHttpClient> _previousClient;
+};
+
+TEST_F(GASessionStart, StartsFromCachedConfigWithoutWaitingForInit)
+{
+    using namespace gameanalytics;
+
+    // config of an earlier session
+    json cached;
+    cached["enabled"]       = true;
+    cached["time_offset"]   = 0;
+    cached["configs_hash"]  = "cached";
+    cached["ab_id"]         = "ab_cached";
+    cached["ab_variant_id"] = "variant_cached";
+    cached["configs"]       = json::array({ {{"key", "difficulty"}, {"value", "easy"}, {"id", "1"}, {"vsn", 1}} });
+    store::GAStore::setState("sdk_config_cached", cached.dump());
+
+    const auto startupLatency = onGAThread([]()
+    {
+        const auto start = std::chrono::steady_clock::now();
+        state::GAState::internalInitialize();
+        return std::chrono::steady_clock::now() - start;
+    });
+
+    EXPECT_TRUE(state::GAState::sessionIsStarted());
+    EXPECT_TRUE(state::GAState::isEnabled());
+    EXPECT_LT(startupLatency, INIT_DELAY / 2);
+
+    // the refreshed config replaces the cached one once the init call returns
+    const auto deadline = std::chrono::steady_clock::now() + INIT_DELAY + 5s;
+    while(state::GAState::getAbId() != "ab_refreshed" && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(20ms);
+    }
+
+    EXPECT_EQ(state::GAState::getAbId(), "ab_refreshed");
+    EXPECT_EQ(state::GAState::getAbVariantId(), "variant_refreshed");
+    EXPECT_EQ(state::GAState::getRemoteConfigsValue<std::string>("difficulty", ""), "hard");
+}
+
+} // namespace
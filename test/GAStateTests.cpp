@@ -114,3 +114,78 @@
 //    gameanalytics::state::GAState::validateAndCleanCustomFields(map, v);
 //    ASSERT_TRUE(v.MemberCount() == 0);
 //}
+
+TEST(GAStateTest, GlobalCustomFieldsAreValidatedWhenSet)
+{
+    using gameanalytics::json;
+    using gameanalytics::state::GAState;
+
+    GAState::setGlobalCustomEventFields(R"({"level":3,"mode":"pvp","bad key":1,"empty":""})");
+
+    EXPECT_EQ(GAState::getValidatedCustomFields(), json({{"level", 3}, {"mode", "pvp"}}));
+    EXPECT_EQ(*GAState::getGlobalCustomEventFieldsMembers(), R"("level":3,"mode":"pvp")");
+
+    // event fields override the global ones, an invalid one removes it
+    EXPECT_EQ(GAState::getValidatedCustomFields(json({{"level", 4}, {"mode", ""}, {"weapon", "sword"}})),
+              json({{"level", 4}, {"weapon", "sword"}}));
+
+    GAState::setGlobalCustomEventFields("{}");
+
+    EXPECT_TRUE(GAState::getValidatedCustomFields().is_null());
+    EXPECT_TRUE(GAState::getGlobalCustomEventFieldsMembers()->empty());
+}
+
+TEST(GAStateTest, PlayerScopeReplacesPerUserState)
+{
+    using gameanalytics::json;
+    using gameanalytics::state::GAState;
+    using gameanalytics::state::PlayerState;
+
+    const std::string defaultUserId     = GAState::getUserId();
+    const std::string defaultSessionId  = GAState::getSessionId();
+    const int64_t defaultTransactionNum = GAState::getTransactionNum();
+
+    PlayerState player;
+    player.userId         = "player-1";
+    player.sessionId      = "session-1";
+    player.sessionStart   = 1000;
+    player.sessionNum     = 4;
+    player.transactionNum = 7;
+    player.dimensions     = {"ninja", "", "gold"};
+
+    EXPECT_EQ(GAState::getActivePlayer(), nullptr);
+
+    {
+        GAState::PlayerScope scope(player);
+
+        EXPECT_EQ(GAState::getActivePlayer(), &player);
+        EXPECT_EQ(GAState::getUserId(), "player-1");
+        EXPECT_EQ(GAState::getSessionId(), "session-1");
+        EXPECT_EQ(GAState::getSessionNum(), 4);
+        EXPECT_EQ(GAState::getCurrentCustomDimension01(), "ninja");
+        EXPECT_EQ(GAState::getCurrentCustomDimension03(), "gold");
+
+        GAState::incrementTransactionNum();
+        GAState::incrementProgressionTries("world_01");
+        GAState::incrementProgressionTries("world_01");
+
+        EXPECT_EQ(GAState::getTransactionNum(), 8);
+        EXPECT_EQ(GAState::getProgressionTries("world_01"), 2);
+
+        json annotations;
+        GAState::getEventAnnotations(annotations);
+
+        EXPECT_EQ(annotations["user_id"], "player-1");
+        EXPECT_EQ(annotations["session_id"], "session-1");
+        EXPECT_EQ(annotations["session_num"], 4);
+    }
+
+    EXPECT_EQ(GAState::getActivePlayer(), nullptr);
+    EXPECT_EQ(GAState::getUserId(), defaultUserId);
+    EXPECT_EQ(GAState::getSessionId(), defaultSessionId);
+    EXPECT_EQ(GAState::getTransactionNum(), defaultTransactionNum);
+    EXPECT_EQ(GAState::getProgressionTries("world_01"), 0);
+
+    EXPECT_EQ(player.transactionNum, 8);
+    EXPECT_EQ(player.progressionTries.getTries("world_01"), 2);
+}
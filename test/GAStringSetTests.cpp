@@ -0,0 +1,60 @@
+//
+// GA-SDK-CPP
+// Tests for the hashed sets of configured strings
+//
+
+#include <gtest/gtest.h>
+
+#include "GAStringSet.h"
+#include "GAState.h"
+
+namespace
+{
+
+using gameanalytics::StringVector;
+using gameanalytics::utilities::GAStringSet;
+
+TEST(GAStringSet, FindsConfiguredValues)
+{
+    // short strings live inside the vector elements, the views must stay valid
+    GAStringSet set({"gems", "gold", "a_resource_name_long_enough_for_the_heap"});
+
+    EXPECT_TRUE(set.contains("gems"));
+    EXPECT_TRUE(set.contains(std::string("gold")));
+    EXPECT_TRUE(set.contains("a_resource_name_long_enough_for_the_heap"));
+    EXPECT_FALSE(set.contains("Gems"));
+    EXPECT_FALSE(set.contains("gem"));
+    EXPECT_FALSE(set.contains(""));
+
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_EQ(set.values(), StringVector({"gems", "gold", "a_resource_name_long_enough_for_the_heap"}));
+}
+
+TEST(GAStringSet, AssignReplacesValues)
+{
+    GAStringSet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains("gems"));
+
+    set.assign({"gems", "gold"});
+    set.assign({"wood"});
+
+    EXPECT_FALSE(set.contains("gems"));
+    EXPECT_TRUE(set.contains("wood"));
+    EXPECT_EQ(set.size(), 1u);
+}
+
+TEST(GAStringSet, StateChecksAvailableItemTypes)
+{
+    using gameanalytics::state::GAState;
+
+    GAState::setAvailableResourceItemTypes({"weapons", "boosters"});
+    EXPECT_TRUE(GAState::hasAvailableResourceItemType("boosters"));
+    EXPECT_FALSE(GAState::hasAvailableResourceItemType("armor"));
+
+    // invalid lists are ignored and keep the previous values
+    GAState::setAvailableResourceItemTypes({"weapons", ""});
+    EXPECT_TRUE(GAState::hasAvailableResourceItemType("boosters"));
+}
+
+} // namespace
@@ -0,0 +1,93 @@
+//
+// GA-SDK-CPP
+// Tests for the cache of validated event ids
+//
+
+#include <gtest/gtest.h>
+
+#include "GAValidatedIdCache.h"
+#include "GAValidator.h"
+
+namespace
+{
+
+using gameanalytics::validators::GAValidatedIdCache;
+using gameanalytics::validators::GAValidator;
+using gameanalytics::validators::ValidationResult;
+using EKind = GAValidatedIdCache::EKind;
+
+TEST(GAValidatedIdCache, CountsHitsAndMisses)
+{
+    GAValidatedIdCache cache;
+
+    EXPECT_FALSE(cache.contains(EKind::Design, {"Combat:Hit:Sword"}));
+    cache.insert(EKind::Design, {"Combat:Hit:Sword"});
+    EXPECT_TRUE(cache.contains(EKind::Design, {"Combat:Hit:Sword"}));
+    EXPECT_TRUE(cache.contains(EKind::Design, {"Combat:Hit:Sword"}));
+
+    // same text, other event type
+    EXPECT_FALSE(cache.contains(EKind::Business, {"Combat:Hit:Sword"}));
+
+    const GAValidatedIdCache::Stats stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.size, 1u);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+}
+
+TEST(GAValidatedIdCache, EvictsLeastRecentlyUsed)
+{
+    GAValidatedIdCache cache(2);
+
+    cache.insert(EKind::Design, {"a"});
+    cache.insert(EKind::Design, {"b"});
+    EXPECT_TRUE(cache.contains(EKind::Design, {"a"}));
+
+    cache.insert(EKind::Design, {"c"});
+    EXPECT_TRUE(cache.contains(EKind::Design, {"a"}));
+    EXPECT_FALSE(cache.contains(EKind::Design, {"b"}));
+    EXPECT_TRUE(cache.contains(EKind::Design, {"c"}));
+
+    cache.setCapacity(1);
+    EXPECT_EQ(cache.getStats().size, 1u);
+    EXPECT_TRUE(cache.contains(EKind::Design, {"c"}));
+
+    cache.setCapacity(0);
+    cache.insert(EKind::Design, {"d"});
+    EXPECT_FALSE(cache.contains(EKind::Design, {"d"}));
+    EXPECT_EQ(cache.getStats().size, 0u);
+}
+
+TEST(GAValidatedIdCache, KeepsPartsApart)
+{
+    GAValidatedIdCache cache;
+
+    cache.insert(EKind::Progression, {"World1", "Level1", ""});
+    EXPECT_TRUE(cache.contains(EKind::Progression, {"World1", "Level1", ""}));
+    EXPECT_FALSE(cache.contains(EKind::Progression, {"World1Level1", "", ""}));
+    EXPECT_FALSE(cache.contains(EKind::Progression, {"World1", "", "Level1"}));
+}
+
+TEST(GAValidatedIdCache, ValidatorsCacheOnlySuccesses)
+{
+    GAValidator::setValidatedIdCacheCapacity(GAValidatedIdCache::DEFAULT_CAPACITY);
+    const GAValidatedIdCache::Stats before = GAValidator::getValidatedIdCacheStats();
+
+    for(int i = 0; i < 3; ++i)
+    {
+        ValidationResult valid;
+        GAValidator::validateDesignEvent("IdCacheTest:Hit:Sword", valid);
+        EXPECT_TRUE(valid.result);
+
+        ValidationResult invalid;
+        GAValidator::validateDesignEvent("IdCacheTest:Hit,Sword", invalid);
+        EXPECT_FALSE(invalid.result);
+        EXPECT_EQ(invalid.action, gameanalytics::http::EGASdkErrorAction::InvalidEventIdCharacters);
+    }
+
+    const GAValidatedIdCache::Stats after = GAValidator::getValidatedIdCacheStats();
+    EXPECT_EQ(after.hits - before.hits, 2u);
+    EXPECT_EQ(after.misses - before.misses, 4u);
+}
+
+} // namespace
@@ -0,0 +1,605 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GALocalCollector.h"
+
+#if defined(GA_LOCAL_COLLECTOR)
+
+#include "GAUtilities.h"
+
+#if defined(GA_HTTP_CURL)
+    #include <openssl/ssl.h>
+    #include <openssl/evp.h>
+    #include <openssl/x509.h>
+    #include <openssl/x509v3.h>
+#endif
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#define MINIZ_HEADER_FILE_ONLY
+#include "GA_Zip.cpp"
+
+using gameanalytics::json;
+
+namespace
+{
+    constexpr const char* EVENTS_PREFIX = "/v2/";
+    constexpr const char* EVENTS_SUFFIX = "/events";
+    constexpr const char* INIT_PATH     = "/remote_configs/v1/init";
+
+    bool startsWith(std::string const& s, const char* prefix)
+    {
+        return s.compare(0, std::strlen(prefix), prefix) == 0;
+    }
+
+    // value of a header in the raw header block, names compare case insensitive
+    std::string headerValue(std::string const& headers, const char* name)
+    {
+        const std::size_t nameLength = std::strlen(name);
+
+        std::size_t lineStart = 0;
+        while(lineStart < headers.size())
+        {
+            std::size_t lineEnd = headers.find("\r\n", lineStart);
+            if(lineEnd == std::string::npos)
+            {
+                lineEnd = headers.size();
+            }
+
+            const std::size_t colon = headers.find(':', lineStart);
+            if(colon < lineEnd && colon - lineStart == nameLength &&
+                std::equal(name, name + nameLength, headers.begin() + lineStart,
+                    [](char a, char b) { return std::tolower(a) == std::tolower(b); }))
+            {
+                std::size_t valueStart = colon + 1;
+                while(valueStart < lineEnd && headers[valueStart] == ' ')
+                {
+                    ++valueStart;
+                }
+                return headers.substr(valueStart, lineEnd - valueStart);
+            }
+
+            lineStart = lineEnd + 2;
+        }
+
+        return {};
+    }
+
+    // inflates a gzip member as GAPayloadEncoder writes it, checking crc and size
+    bool gunzip(std::vector<uint8_t> const& in, std::string& out)
+    {
+        using namespace gameanalytics::utilities::zip;
+
+        enum { FHCRC = 2, FEXTRA = 4, FNAME = 8, FCOMMENT = 16 };
+
+        if(in.size() < 18 || in[0] != 0x1f || in[1] != 0x8b || in[2] != 8)
+        {
+            return false;
+        }
+
+        const uint8_t flags = in[3];
+        std::size_t offset = 10;
+
+        if(flags & FEXTRA)
+        {
+            offset += 2 + (in[offset] | (in[offset + 1] << 8));
+        }
+        for(int field : { FNAME, FCOMMENT })
+        {
+            if(flags & field)
+            {
+                while(offset < in.size() && in[offset] != 0)
+                {
+                    ++offset;
+                }
+                ++offset;
+            }
+        }
+        if(flags & FHCRC)
+        {
+            offset += 2;
+        }
+
+        if(offset + 8 > in.size())
+        {
+            return false;
+        }
+
+        std::size_t inflatedSize = 0;
+        void* inflated = tinfl_decompress_mem_to_heap(in.data() + offset, in.size() - offset - 8, &inflatedSize, 0);
+        if(!inflated)
+        {
+            return false;
+        }
+
+        out.assign(static_cast<const char*>(inflated), inflatedSize);
+        mz_free(inflated);
+
+        const uint8_t* trailer = in.data() + in.size() - 8;
+        const uint32_t crc  = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (static_cast<uint32_t>(trailer[3]) << 24);
+        const uint32_t size = trailer[4] | (trailer[5] << 8) | (trailer[6] << 16) | (static_cast<uint32_t>(trailer[7]) << 24);
+
+        return crc == static_cast<uint32_t>(mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(out.data()), out.size())) &&
+            size == static_cast<uint32_t>(out.size());
+    }
+
+    const char* reasonPhrase(int status)
+    {
+        switch(status)
+        {
+            case 200: return "OK";
+            case 201: return "Created";
+            case 204: return "No Content";
+            case 400: return "Bad Request";
+            case 401: return "Unauthorized";
+            case 404: return "Not Found";
+            case 500: return "Internal Server Error";
+            case 502: return "Bad Gateway";
+            case 503: return "Service Unavailable";
+            default:  return "Unknown";
+        }
+    }
+}
+
+GALocalCollector::GALocalCollector(Options options):
+    _options(std::move(options))
+{
+    // answers may be written to connections the client already gave up on
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if(_options.tls)
+    {
+        createTlsContext();
+    }
+
+    _socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    const int enable = 1;
+    ::setsockopt(_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in addr = {};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = 0;
+
+    ::bind(_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::listen(_socket, 64);
+
+    socklen_t len = sizeof(addr);
+    ::getsockname(_socket, reinterpret_cast<sockaddr*>(&addr), &len);
+    _port = ntohs(addr.sin_port);
+
+    _acceptThread = std::thread([this]() { acceptLoop(); });
+}
+
+GALocalCollector::~GALocalCollector()
+{
+    _running = false;
+    ::shutdown(_socket, SHUT_RDWR);
+    ::close(_socket);
+    _acceptThread.join();
+
+    std::vector<std::thread> connections;
+    {
+        std::lock_guard<std::mutex> lock(_connectionMutex);
+        for(int socket : _connectionSockets)
+        {
+            ::shutdown(socket, SHUT_RDWR);
+        }
+        connections.swap(_connections);
+    }
+
+    for(std::thread& t : connections)
+    {
+        t.join();
+    }
+
+#if defined(GA_HTTP_CURL)
+    SSL_CTX_free(static_cast<SSL_CTX*>(_tls));
+#endif
+}
+
+std::string GALocalCollector::protocol() const
+{
+    return _tls ? "https" : "http";
+}
+
+std::string GALocalCollector::host() const
+{
+    return "127.0.0.1:" + std::to_string(_port);
+}
+
+std::string GALocalCollector::eventsUrl() const
+{
+    return protocol() + "://" + host() + EVENTS_PREFIX + _options.gameKey + EVENTS_SUFFIX;
+}
+
+void GALocalCollector::setLatency(std::chrono::milliseconds latency)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _options.latency = latency;
+}
+
+void GALocalCollector::setErrorRate(double rate, int status)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _options.errorRate   = rate;
+    _options.errorStatus = status;
+}
+
+void GALocalCollector::setForcedStatus(int status)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _options.forcedStatus = status;
+}
+
+json GALocalCollector::events() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _events;
+}
+
+std::vector<GALocalCollector::Request> GALocalCollector::requests() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _requests;
+}
+
+std::size_t GALocalCollector::eventCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _events.size();
+}
+
+std::size_t GALocalCollector::connectionCount() const
+{
+    return _connectionCount;
+}
+
+std::size_t GALocalCollector::rejectedSignatures() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _rejectedSignatures;
+}
+
+bool GALocalCollector::waitForEvents(std::size_t count, std::chrono::milliseconds timeout) const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _eventsAdded.wait_for(lock, timeout, [&]() { return _events.size() >= count; });
+}
+
+void GALocalCollector::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _events = json::array();
+    _requests.clear();
+    _rejectedSignatures = 0;
+}
+
+void GALocalCollector::createTlsContext()
+{
+#if defined(GA_HTTP_CURL)
+    SSL_CTX* ctx = SSL_CTX_new(TLS_server_method());
+
+    EVP_PKEY* key = nullptr;
+    EVP_PKEY_CTX* keyCtx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    EVP_PKEY_keygen_init(keyCtx);
+    EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyCtx, NID_X9_62_prime256v1);
+    EVP_PKEY_keygen(keyCtx, &key);
+    EVP_PKEY_CTX_free(keyCtx);
+
+    X509* cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("127.0.0.1"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+
+    // curl matches IP hosts against the subject alt names only
+    X509V3_CTX extCtx;
+    X509V3_set_ctx_nodb(&extCtx);
+    X509V3_set_ctx(&extCtx, cert, cert, nullptr, nullptr, 0);
+    X509_EXTENSION* san = X509V3_EXT_conf_nid(nullptr, &extCtx, NID_subject_alt_name, "IP:127.0.0.1");
+    X509_add_ext(cert, san, -1);
+    X509_EXTENSION_free(san);
+
+    X509_sign(cert, key, EVP_sha256());
+
+    SSL_CTX_use_certificate(ctx, cert);
+    SSL_CTX_use_PrivateKey(ctx, key);
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+
+    _tls = ctx;
+#endif
+}
+
+void GALocalCollector::acceptLoop()
+{
+    while(_running)
+    {
+        const int client = ::accept(_socket, nullptr, nullptr);
+        if(client < 0)
+        {
+            continue;
+        }
+
+        const int enable = 1;
+        ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        std::lock_guard<std::mutex> lock(_connectionMutex);
+        if(!_running)
+        {
+            ::close(client);
+            break;
+        }
+
+        ++_connectionCount;
+        _connectionSockets.push_back(client);
+        _connections.emplace_back([this, client]() { serve(client); });
+    }
+}
+
+void GALocalCollector::serve(int socket)
+{
+#if defined(GA_HTTP_CURL)
+    SSL* ssl = nullptr;
+    if(_tls)
+    {
+        ssl = SSL_new(static_cast<SSL_CTX*>(_tls));
+        SSL_set_fd(ssl, socket);
+    }
+    bool open = !ssl || SSL_accept(ssl) == 1;
+
+    auto readSome = [&](char* data, std::size_t size) -> long
+    {
+        return ssl ? SSL_read(ssl, data, static_cast<int>(size)) : ::recv(socket, data, size, 0);
+    };
+    auto writeAll = [&](std::string const& data)
+    {
+        return ssl ? SSL_write(ssl, data.data(), static_cast<int>(data.size())) > 0 : ::send(socket, data.data(), data.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(data.size());
+    };
+#else
+    bool open = true;
+
+    auto readSome = [&](char* data, std::size_t size) -> long
+    {
+        return ::recv(socket, data, size, 0);
+    };
+    auto writeAll = [&](std::string const& data)
+    {
+        return ::send(socket, data.data(), data.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(data.size());
+    };
+#endif
+
+    std::string buffer;
+    char chunk[16 * 1024];
+
+    auto readMore = [&]()
+    {
+        const long n = readSome(chunk, sizeof(chunk));
+        if(n <= 0)
+        {
+            return false;
+        }
+
+        buffer.append(chunk, static_cast<std::size_t>(n));
+        return true;
+    };
+
+    while(open && _running)
+    {
+        std::size_t headerEnd;
+        while(open && (headerEnd = buffer.find("\r\n\r\n")) == std::string::npos)
+        {
+            open = readMore();
+        }
+
+        if(!open)
+        {
+            break;
+        }
+
+        // "POST /path HTTP/1.1"
+        const std::size_t requestLineEnd = buffer.find("\r\n");
+        const std::string method         = buffer.substr(0, buffer.find(' '));
+        const std::size_t pathStart      = buffer.find(' ') + 1;
+        const std::size_t pathEnd        = buffer.find(' ', pathStart);
+        const std::string path           = buffer.substr(pathStart, pathEnd - pathStart);
+        const std::string headers        = buffer.substr(requestLineEnd + 2, headerEnd - requestLineEnd - 2);
+
+        const std::size_t contentLength = std::strtoull(headerValue(headers, "Content-Length").c_str(), nullptr, 10);
+
+        if(headerValue(headers, "Expect") == "100-continue")
+        {
+            open = writeAll("HTTP/1.1 100 Continue\r\n\r\n");
+        }
+
+        const std::size_t requestSize = headerEnd + 4 + contentLength;
+        while(open && buffer.size() < requestSize)
+        {
+            open = readMore();
+        }
+
+        if(!open)
+        {
+            break;
+        }
+
+        const std::vector<uint8_t> body(buffer.begin() + headerEnd + 4, buffer.begin() + requestSize);
+        buffer.erase(0, requestSize);
+
+        std::string content;
+        const int status = handle(method, path, headers, body, content);
+
+        std::string response = "HTTP/1.1 " + std::to_string(status) + " " + reasonPhrase(status) + "\r\n";
+        response += "Content-Type: application/json\r\n";
+        response += "Content-Length: " + std::to_string(content.size()) + "\r\n";
+        response += "Connection: keep-alive\r\n\r\n";
+        if(method != "HEAD")
+        {
+            response += content;
+        }
+
+        open = writeAll(response);
+    }
+
+#if defined(GA_HTTP_CURL)
+    if(ssl)
+    {
+        SSL_shutdown(ssl);
+        SSL_free(ssl);
+    }
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(_connectionMutex);
+        _connectionSockets.erase(std::remove(_connectionSockets.begin(), _connectionSockets.end(), socket), _connectionSockets.end());
+    }
+    ::close(socket);
+}
+
+int GALocalCollector::handle(std::string const& method, std::string const& path, std::string const& headers, std::vector<uint8_t> const& body, std::string& response)
+{
+    Request request;
+    request.method         = method;
+    request.path           = path;
+    request.bodySize       = body.size();
+    request.gzip           = headerValue(headers, "Content-Encoding") == "gzip";
+    request.signatureValid = verifySignature(headerValue(headers, "Authorization"), body);
+
+    std::chrono::milliseconds latency;
+    int  injectedStatus = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        latency = _options.latency;
+        if(_options.forcedStatus != 0)
+        {
+            injectedStatus = _options.forcedStatus;
+        }
+        else if(_options.errorRate > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(_random) < _options.errorRate)
+        {
+            injectedStatus = _options.errorStatus;
+        }
+    }
+
+    if(latency.count() > 0)
+    {
+        std::this_thread::sleep_for(latency);
+    }
+
+    int  status = 0;
+    json answer = json::object();
+    json received;
+
+    const std::string eventsPath = EVENTS_PREFIX + _options.gameKey + EVENTS_SUFFIX;
+    const bool isEvents = path == eventsPath;
+    const bool isInit   = startsWith(path, INIT_PATH);
+
+    std::string text;
+    bool decoded = true;
+    if(request.gzip)
+    {
+        decoded = gunzip(body, text);
+    }
+    else
+    {
+        text.assign(body.begin(), body.end());
+    }
+
+    if(injectedStatus != 0)
+    {
+        status = injectedStatus;
+    }
+    else if(method == "HEAD")
+    {
+        status = 200;
+    }
+    else if(!isEvents && !isInit)
+    {
+        status = 404;
+    }
+    else if(!request.signatureValid)
+    {
+        status = 401;
+    }
+    else if(!decoded)
+    {
+        status = 400;
+        answer["errors"] = "could not inflate the gzip body";
+    }
+    else
+    {
+        received = json::parse(text, nullptr, false);
+
+        if(isEvents && received.is_array())
+        {
+            status = 200;
+            request.eventCount = received.size();
+        }
+        else if(isInit && received.is_object())
+        {
+            status = 201;
+            answer = _options.initResponse;
+            answer["server_ts"] = static_cast<int64_t>(std::time(nullptr));
+        }
+        else
+        {
+            status = 400;
+            answer["errors"] = isEvents ? "events must be a json array" : "init annotations must be a json object";
+        }
+    }
+
+    response = answer.dump();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        request.status = status;
+        _requests.push_back(std::move(request));
+
+        if(status == 401 && injectedStatus == 0)
+        {
+            ++_rejectedSignatures;
+        }
+
+        if(status == 200)
+        {
+            for(json& ev : received)
+            {
+                _events.push_back(std::move(ev));
+            }
+            _eventsAdded.notify_all();
+        }
+    }
+
+    return status;
+}
+
+bool GALocalCollector::verifySignature(std::string const& signature, std::vector<uint8_t> const& body) const
+{
+    std::vector<uint8_t> mac;
+    gameanalytics::utilities::GAUtilities::hmacWithKey(_options.secretKey.c_str(), body, mac);
+
+    const char* expected = reinterpret_cast<const char*>(mac.data());
+    return !signature.empty() && signature == std::string(expected, strnlen(expected, mac.size()));
+}
+
+#endif // GA_LOCAL_COLLECTOR
@@ -0,0 +1,137 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Stand-in for the GameAnalytics collector on 127.0.0.1, for integration tests and benchmarks.
+// Serves POST /v2/<game key>/events and POST /remote_configs/v1/init over plain http or, with
+// the curl client available, https with a throwaway self-signed certificate. Requests are checked
+// like the collector does: the Authorization header must be the HMAC of the body with the secret
+// key, gzip bodies are inflated and events must be a json array. Accepted events are recorded.
+// Latency, a random error rate and fixed 400/401/5xx answers can be configured, also while running.
+// HEAD requests, as sent by connection warm-ups, are recorded and answered 200 without a body.
+// Only available on POSIX platforms, see GA_LOCAL_COLLECTOR.
+#if !defined(_WIN32)
+    #define GA_LOCAL_COLLECTOR 1
+#endif
+
+#if defined(GA_LOCAL_COLLECTOR)
+
+class GALocalCollector
+{
+    public:
+
+        struct Options
+        {
+            std::string gameKey;
+            std::string secretKey;
+
+            // https needs the curl client (GA_HTTP_CURL), which brings OpenSSL
+            bool tls = false;
+
+            // added before every answer
+            std::chrono::milliseconds latency{0};
+
+            // share of requests answered with errorStatus instead, 0 - 1
+            double errorRate   = 0.0;
+            int    errorStatus = 500;
+
+            // when not 0 every request is answered with this status
+            int forcedStatus = 0;
+
+            // body of the init answer, server_ts is filled in
+            gameanalytics::json initResponse = gameanalytics::json::object();
+        };
+
+        // one received request
+        struct Request
+        {
+            std::string method;
+            std::string path;
+            int         status         = 0;
+            bool        gzip           = false;
+            bool        signatureValid = false;
+            std::size_t bodySize       = 0;      // as sent
+            std::size_t eventCount     = 0;
+        };
+
+        explicit GALocalCollector(Options options);
+        ~GALocalCollector();
+
+        GALocalCollector(GALocalCollector const&) = delete;
+        GALocalCollector& operator=(GALocalCollector const&) = delete;
+
+        // "http" or "https"
+        std::string protocol() const;
+
+        // "127.0.0.1:<port>"
+        std::string host() const;
+
+        // full url of the events endpoint
+        std::string eventsUrl() const;
+
+        void setLatency(std::chrono::milliseconds latency);
+        void setErrorRate(double rate, int status);
+        void setForcedStatus(int status);
+
+        // copies of what was received so far
+        gameanalytics::json  events() const;
+        std::vector<Request> requests() const;
+
+        std::size_t eventCount() const;
+        std::size_t rejectedSignatures() const;
+
+        // TCP connections accepted so far
+        std::size_t connectionCount() const;
+
+        // blocks until at least count events were accepted, false on timeout
+        bool waitForEvents(std::size_t count, std::chrono::milliseconds timeout) const;
+
+        void clear();
+
+    private:
+
+        void createTlsContext();
+        void acceptLoop();
+        void serve(int socket);
+
+        // status and body of the answer to one request
+        int handle(std::string const& method, std::string const& path, std::string const& headers, std::vector<uint8_t> const& body, std::string& response);
+
+        bool verifySignature(std::string const& signature, std::vector<uint8_t> const& body) const;
+
+        Options _options;
+
+        int                _socket = -1;
+        uint16_t           _port   = 0;
+        void*              _tls    = nullptr;    // SSL_CTX
+        std::atomic<bool>  _running{true};
+        std::thread        _acceptThread;
+
+        std::mutex               _connectionMutex;
+        std::vector<int>         _connectionSockets;
+        std::vector<std::thread> _connections;
+
+        mutable std::mutex              _mutex;
+        mutable std::condition_variable _eventsAdded;
+        std::mt19937                    _random{7};
+        gameanalytics::json             _events = gameanalytics::json::array();
+        std::vector<Request>            _requests;
+        std::size_t                     _rejectedSignatures = 0;
+        std::atomic<std::size_t>        _connectionCount{0};
+};
+
+#endif // GA_LOCAL_COLLECTOR
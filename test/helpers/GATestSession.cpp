@@ -0,0 +1,137 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#include "GATestSession.h"
+
+#include "GAHTTPApi.h"
+#include "GAState.h"
+#include "GAStore.h"
+
+namespace
+{
+    using namespace gameanalytics;
+
+    constexpr const char* GAME_KEY    = "bd624ee6f8e6efb32a054f8d7ba11618";
+    constexpr const char* GAME_SECRET = "7f5c3f682cbd217841efba92e92ffb1b3b6612bc";
+
+    // every request fails like without a connection, so events stay in the store
+    class OfflineClient : public GAHttpClient
+    {
+        public:
+
+            void initialize() override {}
+            void cleanup() override {}
+
+            Response sendRequest(std::string const&, std::string const&, std::vector<uint8_t> const&, bool, void*) override
+            {
+                return {};
+            }
+    };
+}
+
+GATestSession::GATestSession()
+{
+    state::GAState::setKeys(GAME_KEY, GAME_SECRET);
+    if(!store::GAStore::getTableReady())
+    {
+        store::GAStore::ensureDatabase(false, GAME_KEY);
+    }
+
+    // offline, the session starts with the cached or the default init values
+    const std::string sessionId = onGAThread([this]()
+    {
+        _previousClient = http::GAHTTPApi::setCustomHttpImpl(std::make_unique<OfflineClient>());
+        state::GAState::internalInitialize();
+        return state::GAState::getSessionId();
+    });
+
+    track(sessionId);
+}
+
+GATestSession::~GATestSession()
+{
+    onGAThread([this]()
+    {
+        state::GAState::endSessionAndStopQueue(false);
+        http::GAHTTPApi::setCustomHttpImpl(std::move(_previousClient));
+
+        for(std::string const& sessionId : _sessionIds)
+        {
+            store::GAStore::executeQuerySync("DELETE FROM ga_events WHERE session_id = ?;", {sessionId});
+            store::GAStore::executeQuerySync("DELETE FROM ga_session WHERE session_id = ?;", {sessionId});
+        }
+        return 0;
+    });
+}
+
+void GATestSession::track(std::string const& sessionId)
+{
+    if(!sessionId.empty())
+    {
+        _sessionIds.push_back(sessionId);
+    }
+}
+
+json GATestSession::storedEvents(std::string const& sessionId, std::string const& category)
+{
+    return onGAThread([&]()
+    {
+        json rows;
+        if(category.empty())
+        {
+            store::GAStore::executeQuerySync("SELECT event FROM ga_events WHERE session_id = ? ORDER BY rowid;", {sessionId}, rows);
+        }
+        else
+        {
+            store::GAStore::executeQuerySync("SELECT event FROM ga_events WHERE session_id = ? AND category = ? ORDER BY rowid;", {sessionId, category}, rows);
+        }
+
+        json events = json::array();
+        for(json const& row : rows)
+        {
+            events.push_back(json::parse(row["event"].get<std::string>()));
+        }
+        return events;
+    });
+}
+
+json GATestSession::storedEventsOfUser(std::string const& userId)
+{
+    return onGAThread([&]()
+    {
+        json rows;
+        store::GAStore::executeQuerySync("SELECT event FROM ga_events ORDER BY rowid;", rows);
+
+        json events = json::array();
+        for(json const& row : rows)
+        {
+            json event = json::parse(row["event"].get<std::string>());
+            if(event.value("user_id", "") == userId)
+            {
+                events.push_back(std::move(event));
+            }
+        }
+        return events;
+    });
+}
+
+json GATestSession::sessionRow(std::string const& sessionId)
+{
+    return onGAThread([&]()
+    {
+        json rows;
+        store::GAStore::executeQuerySync("SELECT timestamp, event FROM ga_session WHERE session_id = ?;", {sessionId}, rows);
+
+        if(!rows.is_array() || rows.empty())
+        {
+            return json();
+        }
+
+        json row;
+        row["timestamp"] = std::stoll(rows[0]["timestamp"].get<std::string>());
+        row["event"]     = json::parse(rows[0]["event"].get<std::string>());
+        return row;
+    });
+}
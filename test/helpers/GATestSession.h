@@ -0,0 +1,56 @@
+//
+// GA-SDK-CPP
+// Copyright 2018 GameAnalytics C++ SDK. All rights reserved.
+//
+
+#pragma once
+
+#include "GACommon.h"
+#include "GAThreading.h"
+#include "GameAnalytics/GAHttpClient.h"
+
+#include <future>
+#include <memory>
+#include <string>
+
+// Initializes the sdk with an http client that is always offline and starts a session, so tests
+// can add events and read them back from the store. Going out of scope ends the session, puts the
+// previous http client back and deletes the stored events and session rows of the sessions the
+// test used.
+class GATestSession
+{
+    public:
+
+        GATestSession();
+        ~GATestSession();
+
+        GATestSession(GATestSession const&) = delete;
+        GATestSession& operator=(GATestSession const&) = delete;
+
+        // the sdk state is owned by the GA thread, runs task there and waits for its result
+        template<typename Task>
+        static auto onGAThread(Task task) -> decltype(task())
+        {
+            auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(task);
+            auto result   = packaged->get_future();
+            gameanalytics::threading::GAThreading::performTaskOnGAThread([packaged]() { (*packaged)(); });
+            return result.get();
+        }
+
+        // rows of sessionId are deleted when the test session ends
+        void track(std::string const& sessionId);
+
+        // stored events of sessionId, oldest first
+        static gameanalytics::json storedEvents(std::string const& sessionId, std::string const& category = "");
+
+        // stored events with this user_id, of any session, oldest first
+        static gameanalytics::json storedEventsOfUser(std::string const& userId);
+
+        // the ga_session row of sessionId, null if there is none
+        static gameanalytics::json sessionRow(std::string const& sessionId);
+
+    private:
+
+        std::unique_ptr<gameanalytics::GAHttpClient> _previousClient;
+        gameanalytics::StringVector                  _sessionIds;
+};